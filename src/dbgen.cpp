@@ -6,19 +6,38 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "gate/model/printer/net_printer.h"
 #include "gate/model/subnet.h"
 #include "gate/optimizer/npn.h"
 #include "gate/optimizer/npndb.h"
+#include "gate/optimizer/npndb_checkpoint.h"
 #include "util/env.h"
 
 #include <percy/percy.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include <sys/wait.h>
+#include <unistd.h>
+
 using Link = eda::gate::model::Subnet::Link;
+using NpnDbCheckpoint = eda::gate::optimizer::NpnDbCheckpoint;
 using SubnetObject = eda::gate::model::SubnetObject;
 
 //===----------------------------------------------------------------------===//
@@ -198,18 +217,29 @@ inline void printBases() {
 }
 
 inline void printUsage() {
-  std::cout << "Usage: dbgen [BASIS] [FILE]" << std::endl;
+  std::cout << "Usage: dbgen [OPTIONS] [BASIS] [FILE]" << std::endl;
   printBases();
   std::cout << "With no FILE write to 'UTOPIA_HOME/output/db'" << std::endl;
-  std::cout << std::endl << "Example: ./dbgen xag" << std::endl;
+  std::cout << std::endl << "Options:" << std::endl;
+  std::cout << "  -k N    Number of inputs: 4 or 5 (default: 4)" << std::endl;
+  std::cout << "  -j N    Number of parallel jobs (default: all cores)"
+            << std::endl;
+  std::cout << "  -t SEC  Per-class timeout in seconds (default: no limit)"
+            << std::endl;
+  std::cout << "  -c DIR  Checkpoint directory (default: FILE.BASIS-kN.ckpt)"
+            << std::endl;
+  std::cout << std::endl << "Example: ./dbgen -k 5 -j 16 -t 3600 xag"
+            << std::endl;
 }
 
 inline std::string toHexString(uint8_t k, uint64_t value) {
   assert(k <= 6);
   assert(value <= (1ull << (1 << k)) - 1);
 
+  const int width = (k < 2) ? 1 : (1 << k) / 4;
+
   std::stringstream ss;
-  ss << std::setfill('0') << std::setw(k) << std::hex << value;
+  ss << std::setfill('0') << std::setw(width) << std::hex << value;
   return ss.str();
 }
 
@@ -245,38 +275,274 @@ inline SubnetObject synthesize(uint8_t k,
   return synthesize(k, toHexString(k, value), basis);
 }
 
-int generateNpn4(const std::string &basis, std::string &filename) {
-  eda::gate::optimizer::NpnDatabase db;
-  constexpr uint8_t k = 4;
+//===----------------------------------------------------------------------===//
+// Parallel generation
+//===----------------------------------------------------------------------===//
 
-  for (size_t i = 0; i < eda::gate::optimizer::npn4Num; ++i) {
-    const uint64_t mincode = eda::gate::optimizer::npn4[i];
+/// Generation settings.
+struct Config final {
+  std::string basis;
+  std::string filename;
+  std::filesystem::path checkpointDir;
+  uint8_t k{4};
+  unsigned nJobs{1};
+  /// Per-class timeout in seconds (0 means no limit).
+  unsigned timeout{0};
+};
+
+inline std::vector<uint64_t> getClasses(uint8_t k) {
+  std::vector<uint64_t> classes;
+  if (k == 4) {
+    classes.assign(eda::gate::optimizer::npn4,
+                   eda::gate::optimizer::npn4 + eda::gate::optimizer::npn4Num);
+  } else if (k == 5) {
+    classes.assign(eda::gate::optimizer::npn5,
+                   eda::gate::optimizer::npn5 + eda::gate::optimizer::npn5Num);
+  }
+  return classes;
+}
 
-    auto subnetObject = synthesize(k, mincode, basis);
-    if (subnetObject.isNull()) {
-      return 1;
+/// Synthesizes the class and writes the checkpoint (runs in a child process).
+[[noreturn]] inline void runJob(const Config &config,
+                                const NpnDbCheckpoint &checkpoints,
+                                size_t i,
+                                uint64_t mincode) {
+  const auto subnetObject = synthesize(config.k, mincode, config.basis);
+  if (subnetObject.isNull()) {
+    _exit(1);
+  }
+
+  const auto checkpoint = checkpoints.getPath(i, mincode);
+  auto tmpname = checkpoint;
+  tmpname += ".tmp";
+
+  std::ofstream out(tmpname);
+  if (!out.is_open()) {
+    _exit(1);
+  }
+
+  const auto &subnet = eda::gate::model::Subnet::get(subnetObject.make());
+  eda::gate::model::print(out, eda::gate::model::LOGDB, subnet);
+  out << '\n';
+  out.close();
+
+  // The checkpoint appears atomically: a killed job leaves no partial file.
+  std::error_code error;
+  std::filesystem::rename(tmpname, checkpoint, error);
+  _exit((out.fail() || error) ? 1 : 0);
+}
+
+/// Runs the jobs for the given classes; returns the indices of failed classes.
+/// Synthesis is done in forked processes: the subnet storage is not
+/// thread-safe, and a process can be killed when the timeout expires.
+inline std::vector<size_t> runJobs(const Config &config,
+                                   const NpnDbCheckpoint &checkpoints,
+                                   const std::vector<uint64_t> &classes,
+                                   std::deque<size_t> queue) {
+  using Clock = std::chrono::steady_clock;
+
+  struct Job final {
+    size_t i;
+    Clock::time_point start;
+  };
+
+  std::map<pid_t, Job> running;
+  std::vector<size_t> failed;
+
+  const size_t nTotal = queue.size();
+  size_t nDone = 0;
+
+  const auto finish = [&](pid_t pid, bool isSuccess, const char *status) {
+    const auto &job = running.at(pid);
+    const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(
+        Clock::now() - job.start).count();
+
+    std::cout << "[" << ++nDone << "/" << nTotal << "] class "
+              << toHexString(config.k, classes[job.i]) << ": " << status
+              << " (" << seconds << "s)" << std::endl;
+
+    if (!isSuccess) {
+      failed.push_back(job.i);
+    }
+    running.erase(pid);
+  };
+
+  while (!queue.empty() || !running.empty()) {
+    while (running.size() < config.nJobs && !queue.empty()) {
+      const size_t i = queue.front();
+      queue.pop_front();
+
+      std::cout.flush();
+      const pid_t pid = fork();
+      if (pid < 0) {
+        throw std::runtime_error("Failed to fork a generation job");
+      }
+      if (pid == 0) {
+        runJob(config, checkpoints, i, classes[i]);
+      }
+      running.emplace(pid, Job{i, Clock::now()});
+    }
+
+    int status = 0;
+    const pid_t pid = waitpid(-1, &status, WNOHANG);
+    if (pid > 0) {
+      const bool isSuccess = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+      finish(pid, isSuccess, isSuccess ? "done" : "failed");
+      continue;
+    }
+
+    if (config.timeout) {
+      const auto now = Clock::now();
+      const auto limit = std::chrono::seconds(config.timeout);
+
+      std::vector<pid_t> expired;
+      for (const auto &[pid, job] : running) {
+        if (now - job.start >= limit) {
+          expired.push_back(pid);
+        }
+      }
+      for (const auto pid : expired) {
+        kill(pid, SIGKILL);
+        waitpid(pid, &status, 0);
+        finish(pid, false, "timeout");
+      }
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  std::sort(failed.begin(), failed.end());
+  return failed;
+}
+
+/// Merges the checkpoints in the order of the class list, so the result
+/// does not depend on the job completion order.
+inline void mergeCheckpoints(const Config &config,
+                             const NpnDbCheckpoint &checkpoints,
+                             const std::vector<uint64_t> &classes) {
+  std::ofstream out(config.filename);
+  if (!out.is_open()) {
+    throw std::runtime_error("Error of opening file to export\n");
+  }
+
+  for (size_t i = 0; i < classes.size(); ++i) {
+    if (!checkpoints.has(i, classes[i])) {
+      continue;
     }
-    db.push(subnetObject.make());
+    std::ifstream in(checkpoints.getPath(i, classes[i]));
+    out << in.rdbuf();
+  }
+}
+
+int generateNpn(Config &config) {
+  if (config.basis != "aig" && config.basis != "xag" && config.basis != "mig") {
+    std::cout << "Error: unsupported basis for generation" << std::endl;
+    printBases();
+    return 1;
   }
 
-  if (filename.empty()) {
-    filename = eda::env::getHomePath() / "output" / "db";
+  const auto classes = getClasses(config.k);
+  if (classes.empty()) {
+    std::cout << "Error: unsupported number of inputs "
+              << static_cast<unsigned>(config.k) << std::endl;
+    return 1;
+  }
+
+  if (config.filename.empty()) {
+    config.filename = eda::env::getHomePath() / "output" / "db";
     std::filesystem::create_directory(eda::env::getHomePath() / "output");
   }
-  db.exportTo(filename);
+  // The checkpoints depend on the basis and the number of inputs.
+  const NpnDbCheckpoint::Settings settings{config.basis, config.k};
+  if (config.checkpointDir.empty()) {
+    config.checkpointDir =
+        NpnDbCheckpoint::getDefaultDir(config.filename, settings);
+  }
+
+  std::unique_ptr<NpnDbCheckpoint> checkpoints;
+  try {
+    checkpoints = std::make_unique<NpnDbCheckpoint>(
+        config.checkpointDir, settings);
+  } catch (const std::exception &e) {
+    std::cout << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+
+  // Resume: the classes having checkpoints are not synthesized again.
+  const auto pending = checkpoints->getPending(classes);
+  std::deque<size_t> queue(pending.begin(), pending.end());
+
+  std::cout << "Generating " << queue.size() << " of " << classes.size()
+            << " classes (" << config.nJobs << " jobs)" << std::endl;
+
+  const auto failed = runJobs(config, *checkpoints, classes, std::move(queue));
+  mergeCheckpoints(config, *checkpoints, classes);
+
+  if (!failed.empty()) {
+    std::cout << "Warning: " << failed.size() << " classes are missing "
+              << "(rerun to retry):";
+    for (const auto i : failed) {
+      std::cout << " " << toHexString(config.k, classes[i]);
+    }
+    std::cout << std::endl;
+    return 1;
+  }
   return 0;
 }
 
+inline bool parseUnsigned(const char *arg, unsigned &value) {
+  if (!arg) {
+    return false;
+  }
+  char *end = nullptr;
+  const auto result = std::strtoul(arg, &end, 10);
+  if (end == arg || *end != '\0') {
+    return false;
+  }
+  value = static_cast<unsigned>(result);
+  return true;
+}
+
 int main(int argc, char **argv) {
-  std::string filename;
-  if (argc > 2) {
-    std::copy_n(argv[2], strlen(argv[2]), std::back_inserter(filename));
+  Config config;
+  config.nJobs = std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<std::string> args;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg(argv[i]);
+    const char *value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+    unsigned number = 0;
+    if (arg == "-k" && parseUnsigned(value, number)) {
+      config.k = static_cast<uint8_t>(number);
+      ++i;
+    } else if (arg == "-j" && parseUnsigned(value, number) && number > 0) {
+      config.nJobs = number;
+      ++i;
+    } else if (arg == "-t" && parseUnsigned(value, number)) {
+      config.timeout = number;
+      ++i;
+    } else if (arg == "-c" && value) {
+      config.checkpointDir = value;
+      ++i;
+    } else if (!arg.empty() && arg[0] == '-') {
+      std::cout << "Invalid option: " << arg << std::endl << std::endl;
+      printUsage();
+      return 1;
+    } else {
+      args.push_back(arg);
+    }
   }
-  if (argc > 1) {
-    const std::string basis(argv[1], strlen(argv[1]));
-    return generateNpn4(basis, filename);
+
+  if (args.empty() || args.size() > 2) {
+    std::cout << "Print basis!" << std::endl << std::endl;
+    printUsage();
+    return 1;
+  }
+
+  config.basis = args[0];
+  if (args.size() > 1) {
+    config.filename = args[1];
   }
-  std::cout << "Print basis!" << std::endl << std::endl;
-  printUsage();
-  return 1;
+  return generateNpn(config);
 }
@@ -15,16 +15,18 @@
 
 #include <cassert>
 #include <iostream>
+#include <mutex>
 #include <sstream>
 
 #define UTOPIA_OUT std::cout
 #define UTOPIA_ERR std::cerr
 
-// Diagnostics.
+// Diagnostics (the logging and diagnostics are serialized by the mutex).
 #define UTOPIA_RAISE_DIAGNOSTICS(logger, lvl, msg)\
   do {\
     std::stringstream out;\
     out << msg;\
+    std::lock_guard<std::recursive_mutex> utopiaLock(eda::diag::getMutex());\
     eda::diag::log(logger, lvl, out.str());\
   } while(false)
 
@@ -47,13 +49,19 @@
 #define UTOPIA_BEGIN(msg) UTOPIA_RAISE_BEGIN(UTOPIA_LOGGER, msg)
 #define UTOPIA_END()      UTOPIA_RAISE_END(UTOPIA_LOGGER, msg)
 
-// Logging.
-#define UTOPIA_LOG_INFO(msg)  LOG(INFO)    << msg
-#define UTOPIA_LOG_DEBUG(msg) LOG(DEBUG)   << msg
-#define UTOPIA_LOG_NOTE(msg)  LOG(INFO)    << msg; UTOPIA_NOTE(msg)
-#define UTOPIA_LOG_WARN(msg)  LOG(WARNING) << msg; UTOPIA_WARN(msg)
-#define UTOPIA_LOG_ERROR(msg) LOG(ERROR)   << msg; UTOPIA_ERROR(msg)
-#define UTOPIA_LOG_BEGIN(msg) LOG(INFO)    << msg; UTOPIA_BEGIN(msg)
+// Logging (easylogging++ is not built w/ ELPP_THREAD_SAFE).
+#define UTOPIA_LOG(lvl, msg)\
+  do {\
+    std::lock_guard<std::recursive_mutex> utopiaLock(eda::diag::getMutex());\
+    LOG(lvl) << msg;\
+  } while(false)
+
+#define UTOPIA_LOG_INFO(msg)  UTOPIA_LOG(INFO,    msg)
+#define UTOPIA_LOG_DEBUG(msg) UTOPIA_LOG(DEBUG,   msg)
+#define UTOPIA_LOG_NOTE(msg)  UTOPIA_LOG(INFO,    msg); UTOPIA_NOTE(msg)
+#define UTOPIA_LOG_WARN(msg)  UTOPIA_LOG(WARNING, msg); UTOPIA_WARN(msg)
+#define UTOPIA_LOG_ERROR(msg) UTOPIA_LOG(ERROR,   msg); UTOPIA_ERROR(msg)
+#define UTOPIA_LOG_BEGIN(msg) UTOPIA_LOG(INFO,    msg); UTOPIA_BEGIN(msg)
 #define UTOPIA_LOG_END()      /* nothing to log */ UTOPIA_END()
 
 #define UTOPIA_INITIALIZE_LOGGER() do {\
@@ -64,6 +72,12 @@
 
 namespace eda::diag {
 
+/// Returns the mutex serializing the logging and diagnostics.
+inline std::recursive_mutex &getMutex() {
+  static std::recursive_mutex mutex;
+  return mutex;
+}
+
 class Logger {
 public:
   static Logger &getDefault() {
@@ -8,6 +8,7 @@
 
 #include "gate/criterion/cost_vector.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 
@@ -27,7 +28,7 @@ CostVector CostVector::truncate(const Cost min, const Cost max) const {
   assert(min <= max);
 
   CostVector result;
-  for (size_t i = 0; i < vector.size(); ++i) {
+  for (size_t i = 0; i < DefaultSize; ++i) {
     result[i] = std::min(std::max(min, vector[i]), max);
   }
 
@@ -8,61 +8,66 @@
 
 #pragma once
 
+#include <array>
 #include <cassert>
 #include <cmath>
 #include <cstddef>
-#include <valarray>
 
 namespace eda::gate::criterion {
 
 /// @brief Cost datatype (must meet the NumericType requirements).
 using Cost = float;
 
-/// @brief Stores the estimated (predicted) design characteristics.
+/**
+ * @brief Stores the estimated (predicted) design characteristics.
+ *
+ * The vector is of fixed size and does not allocate memory (it is created
+ * and combined millions of times by the mappers). The components are stored
+ * in a 4-lane array (the last lane is padding and is always zero), so that
+ * the element-wise operations are compiled into SIMD instructions.
+ */
 struct CostVector final {
   /// Area, delay, and power.
   static constexpr size_t DefaultSize = 3;
+  /// Number of the stored components (including the padding).
+  static constexpr size_t Lanes = 4;
 
   /// Zero cost vector.
   static const CostVector Zero;
   /// Unit cost vector.
   static const CostVector Unit;
 
-  explicit CostVector():
-      vector(DefaultSize) {}
+  constexpr explicit CostVector():
+      vector{0., 0., 0., 0.} {}
 
-  explicit CostVector(const std::valarray<Cost> &vector):
-      vector(vector) {}
+  constexpr CostVector(const Cost a, const Cost d, const Cost p):
+      vector{a, d, p, 0.} {}
 
-  explicit CostVector(const std::valarray<Cost> &&vector) noexcept:
-      vector(std::move(vector)) {}
-
-  CostVector(const Cost a, const Cost d, const Cost p):
-      CostVector(std::valarray<Cost>{a, d, p}) {}
-
-  CostVector(const Cost x):
+  constexpr CostVector(const Cost x):
       CostVector(x, x, x) {}
 
-  CostVector(const CostVector &vector):
-      CostVector(vector.vector) {}
-
-  CostVector(CostVector &&vector) noexcept:
-      CostVector(std::move(vector.vector)) {}
+  constexpr CostVector(const CostVector &other) = default;
 
-  size_t size() const {
-    return vector.size();
+  constexpr size_t size() const {
+    return DefaultSize;
   }
 
   const Cost &operator[](const size_t i) const {
+    assert(i < DefaultSize);
     return vector[i];
   }
 
   Cost &operator[](const size_t i) {
+    assert(i < DefaultSize);
     return vector[i];
   }
 
   Cost sum() const {
-    return vector.sum();
+    Cost result = 0.;
+    for (size_t i = 0; i < DefaultSize; ++i) {
+      result += vector[i];
+    }
+    return result;
   }
 
   Cost norm(const Cost p) const {
@@ -70,109 +75,146 @@ struct CostVector final {
   }
 
   CostVector operator+(const CostVector &other) const {
-    return CostVector(vector + other.vector);
+    CostVector result(*this);
+    return result += other;
   }
 
   CostVector operator-(const CostVector &other) const {
-    return CostVector(vector - other.vector);
+    CostVector result(*this);
+    return result -= other;
   }
 
   CostVector operator*(const CostVector &other) const {
-    return CostVector(vector * other.vector);
+    CostVector result(*this);
+    return result *= other;
   }
 
   CostVector operator/(const CostVector &other) const {
-    return CostVector(vector / other.vector);
+    CostVector result(*this);
+    return result /= other;
   }
 
   CostVector operator-(const Cost other) const {
-    return CostVector(vector - other);
+    CostVector result(*this);
+    return result -= other;
   }
 
   CostVector operator+(const Cost other) const {
-    return CostVector(vector + other);
+    CostVector result(*this);
+    return result += other;
   }
 
   CostVector operator*(const Cost other) const {
-    return CostVector(vector * other);
+    CostVector result(*this);
+    return result *= other;
   }
 
   CostVector operator/(const Cost other) const {
-    return CostVector(vector / other);
+    CostVector result(*this);
+    return result /= other;
   }
 
   CostVector abs() const {
-    return CostVector(std::abs(vector));
+    CostVector result;
+    for (size_t i = 0; i < Lanes; ++i) {
+      result.vector[i] = std::abs(vector[i]);
+    }
+    return result;
   }
 
   CostVector pow(const Cost power) const {
-    return CostVector(std::pow(vector, power));
+    CostVector result;
+    for (size_t i = 0; i < DefaultSize; ++i) {
+      result.vector[i] = std::pow(vector[i], power);
+    }
+    return result;
   }
 
   CostVector exp() const {
-    return CostVector(std::exp(vector));
+    CostVector result;
+    for (size_t i = 0; i < DefaultSize; ++i) {
+      result.vector[i] = std::exp(vector[i]);
+    }
+    return result;
   }
 
   CostVector softmax(const Cost tau) const {
-    const auto v = std::exp(vector / tau);
-    return CostVector(v / v.sum());
+    const auto v = (*this / tau).exp();
+    return v / v.sum();
   }
 
   CostVector smooth(const CostVector &pivot, const Cost alpha) const {
-    return CostVector(vector * alpha + pivot.vector * (1. - alpha));
+    return *this * alpha + pivot * (1. - alpha);
   }
 
   Cost dot(const CostVector &other) const {
-    assert(vector.size() == other.vector.size());
     Cost result = .0;
-    for (size_t i = 0; i < vector.size(); ++i) {
+    for (size_t i = 0; i < DefaultSize; ++i) {
       result += vector[i] * other.vector[i];
     }
     return result;
   }
 
-  CostVector &operator=(const CostVector &other) {
-    vector = other.vector;
-    return *this;
-  }
+  CostVector &operator=(const CostVector &other) = default;
 
   CostVector &operator+=(const CostVector &other) {
-    vector += other.vector;
+    for (size_t i = 0; i < Lanes; ++i) {
+      vector[i] += other.vector[i];
+    }
     return *this;
   }
 
   CostVector &operator-=(const CostVector &other) {
-    vector -= other.vector;
+    for (size_t i = 0; i < Lanes; ++i) {
+      vector[i] -= other.vector[i];
+    }
     return *this;
   }
 
   CostVector &operator*=(const CostVector &other) {
-    vector *= other.vector;
+    for (size_t i = 0; i < Lanes; ++i) {
+      vector[i] *= other.vector[i];
+    }
     return *this;
   }
 
   CostVector &operator/=(const CostVector &other) {
-    vector /= other.vector;
+    // The padding is not divided (0/0 is NaN).
+    for (size_t i = 0; i < DefaultSize; ++i) {
+      vector[i] /= other.vector[i];
+    }
     return *this;
   }
 
   CostVector &operator+=(const Cost other) {
-    vector += other;
+    for (size_t i = 0; i < DefaultSize; ++i) {
+      vector[i] += other;
+    }
     return *this;
   }
 
   CostVector &operator-=(const Cost other) {
-    vector -= other;
+    for (size_t i = 0; i < DefaultSize; ++i) {
+      vector[i] -= other;
+    }
     return *this;
   }
 
   CostVector &operator*=(const Cost other) {
-    vector *= other;
+    for (size_t i = 0; i < Lanes; ++i) {
+      vector[i] *= other;
+    }
+    // The padding is reset (0*inf is NaN).
+    for (size_t i = DefaultSize; i < Lanes; ++i) {
+      vector[i] = 0.;
+    }
     return *this;
   }
 
   CostVector &operator/=(const Cost other) {
-    vector /= other;
+    for (size_t i = 0; i < DefaultSize; ++i) {
+      vector[i] /= other;
+    }
     return *this;
   }
 
@@ -181,7 +223,7 @@ struct CostVector final {
   CostVector truncate(const Cost min, const Cost max) const;
 
 private:
-  std::valarray<Cost> vector;
+  alignas(sizeof(Cost) * Lanes) std::array<Cost, Lanes> vector;
 };
 
 } // namespace eda::gate::criterion
@@ -21,15 +21,16 @@ struct Criterion final {
             const PenaltyFunction penalty):
       objective(objective),
       constraints(constraints),
-      penalty(penalty) {}
+      penalty(penalty),
+      minVector(getMinVector(constraints)),
+      maxVector(getMaxVector(constraints)) {}
 
   Criterion(const Objective &objective,
             const Constraints &constraints):
       Criterion(objective, constraints, cubicPenalty) {}
 
   CostVector normalize(const CostVector &vector) const {
-    return vector.normalize(getMinVector(constraints),
-                            getMaxVector(constraints));
+    return vector.normalize(minVector, maxVector);
   }
 
   Cost getCost(const CostVector &vector) const {
@@ -47,10 +48,7 @@ struct Criterion final {
   }
 
   CostVector getTension(const CostVector &vector) const {
-    const auto min = getMinVector(constraints);
-    const auto max = getMaxVector(constraints);
-
-    return vector.normalize(min, max).truncate(0.001, 1000.0);
+    return vector.normalize(minVector, maxVector).truncate(0.001, 1000.0);
   }
 
   bool check(const CostVector &vector) const {
@@ -68,6 +66,9 @@ struct Criterion final {
   const Constraints constraints;
   /// Penalty function.
   const PenaltyFunction penalty;
+  /// Min/max vectors of the constraints (precomputed for the hot path).
+  const CostVector minVector;
+  const CostVector maxVector;
 };
 
 } // namespace eda::gate::criterion
@@ -9,6 +9,7 @@
 #include "gate/debugger/base_checker.h"
 #include "gate/debugger/bdd_checker.h"
 #include "gate/debugger/fraig_checker.h"
+#include "gate/debugger/portfolio_checker.h"
 #include "gate/debugger/rnd_checker.h"
 #include "gate/debugger/sat_checker.h"
 
@@ -25,10 +26,11 @@ using SubnetView = model::SubnetView;
 
 BaseChecker &BaseChecker::getChecker(const LecType lec) {
   switch (lec) {
-    case LecType::BDD:   return BddChecker::get();
-    case LecType::FRAIG: return FraigChecker::get();
-    case LecType::RND:   return RndChecker::get();
-    case LecType::SAT:   return SatChecker::get();
+    case LecType::BDD:       return BddChecker::get();
+    case LecType::FRAIG:     return FraigChecker::get();
+    case LecType::RND:       return RndChecker::get();
+    case LecType::SAT:       return SatChecker::get();
+    case LecType::PORTFOLIO: return PortfolioChecker::get();
     default: assert(false && "Unsupported LEC checker");
   }
   return SatChecker::get();
@@ -96,9 +98,9 @@ uint16_t mapInputs(const T &source1,
   return nOut;
 }
 
-static void makeDefaultMapping(const model::Subnet &subnet1,
-                               const model::Subnet &subnet2,
-                               BaseChecker::CellToCell &mapping) {
+void BaseChecker::makeDefaultMapping(const model::Subnet &subnet1,
+                                     const model::Subnet &subnet2,
+                                     CellToCell &mapping) {
   const auto nOut = mapInputs(subnet1, subnet2, mapping);
   const auto size1 = subnet1.size();
   const auto size2 = subnet2.size();
@@ -107,9 +109,9 @@ static void makeDefaultMapping(const model::Subnet &subnet1,
   }
 }
 
-static void makeDefaultMapping(const model::SubnetBuilder &builder1,
-                               const model::SubnetBuilder &builder2,
-                               BaseChecker::CellToCell &mapping) {
+void BaseChecker::makeDefaultMapping(const model::SubnetBuilder &builder1,
+                                     const model::SubnetBuilder &builder2,
+                                     CellToCell &mapping) {
   const auto nOut = mapInputs(builder1, builder2, mapping);
   const auto size1 = builder1.getCellNum();
   const auto size2 = builder2.getCellNum();
@@ -150,10 +152,10 @@ void makeMiterOutputs(model::SubnetBuilder &builder, const LinkList &xors) {
   }
 }
 
-void BaseChecker::makeMiter(model::SubnetBuilder &builder,
-                            const model::Subnet &subnet1,
-                            const model::Subnet &subnet2,
-                            const CellToCell &mapping) {
+static LinkList makeMiterXors(model::SubnetBuilder &builder,
+                              const model::Subnet &subnet1,
+                              const model::Subnet &subnet2,
+                              const BaseChecker::CellToCell &mapping) {
   IdxToLink map1, map2;
   const auto nOut = makeNoOutMiter(builder, subnet1, subnet2,
                                    mapping, map1, map2);
@@ -163,7 +165,14 @@ void BaseChecker::makeMiter(model::SubnetBuilder &builder,
     const auto idx2 = mapping.find(idx1)->second;
     xors[i] = builder.addCell(CellSymbol::XOR, map1[idx1], map2[idx2]);
   }
-  makeMiterOutputs(builder, xors);
+  return xors;
+}
+
+void BaseChecker::makeMiter(model::SubnetBuilder &builder,
+                            const model::Subnet &subnet1,
+                            const model::Subnet &subnet2,
+                            const CellToCell &mapping) {
+  makeMiterOutputs(builder, makeMiterXors(builder, subnet1, subnet2, mapping));
 }
 
 void BaseChecker::makeMiter(model::SubnetBuilder &builder,
@@ -174,6 +183,23 @@ void BaseChecker::makeMiter(model::SubnetBuilder &builder,
   makeMiter(builder, subnet1, subnet2, mapping);
 }
 
+void BaseChecker::makeOutputMiter(model::SubnetBuilder &builder,
+                                  const model::Subnet &subnet1,
+                                  const model::Subnet &subnet2,
+                                  const CellToCell &mapping) {
+  for (const auto &link : makeMiterXors(builder, subnet1, subnet2, mapping)) {
+    builder.addOutput(link);
+  }
+}
+
+void BaseChecker::makeOutputMiter(model::SubnetBuilder &builder,
+                                  const model::Subnet &subnet1,
+                                  const model::Subnet &subnet2) {
+  CellToCell mapping;
+  makeDefaultMapping(subnet1, subnet2, mapping);
+  makeOutputMiter(builder, subnet1, subnet2, mapping);
+}
+
 void BaseChecker::makeMiter(model::SubnetBuilder &builder,
                             const model::SubnetBuilder &builder1,
                             const model::SubnetBuilder &builder2,
@@ -12,6 +12,7 @@
 #include "gate/model/subnet.h"
 #include "gate/model/subnetview.h"
 
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -22,7 +23,8 @@ enum LecType {
   BDD,
   FRAIG,
   RND,
-  SAT
+  SAT,
+  PORTFOLIO
 };
 
 } // namespace eda::gate::debugger::options
@@ -100,9 +102,48 @@ public:
   using CellToCell = std::unordered_map<uint32_t, uint32_t>;
   using LecType = eda::gate::debugger::options::LecType;
 
+  using StopFlag = std::atomic<bool>;
+
   /// Returns the LEC checker.
   static BaseChecker &getChecker(const LecType lec);
 
+  /**
+   * @brief Sets the flag polled by the checkers run in the current thread:
+   * if the flag is raised, the checking is cancelled (UNKNOWN is returned).
+   * @param flag Stop flag (nullptr stands for no cancellation).
+   */
+  static void setStopFlag(const StopFlag *flag) { stopFlag = flag; }
+
+  /// Returns the stop flag of the current thread.
+  static const StopFlag *getStopFlag() { return stopFlag; }
+
+  /// Checks if the checking in the current thread is cancelled.
+  static bool isStopped() {
+    return stopFlag && stopFlag->load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Maps the i-th PI/PO of the first subnet to the i-th PI/PO of the
+   * second one (the subnets are required to have the same interface).
+   * @param subnet1 First subnet.
+   * @param subnet2 Second subnet.
+   * @param mapping Mapping to be filled.
+   */
+  static void makeDefaultMapping(const model::Subnet &subnet1,
+                                 const model::Subnet &subnet2,
+                                 CellToCell &mapping);
+
+  /**
+   * @brief Maps the i-th PI/PO of the first subnet to the i-th PI/PO of the
+   * second one (the subnets are required to have the same interface).
+   * @param builder1 Builder of the first subnet.
+   * @param builder2 Builder of the second subnet.
+   * @param mapping Mapping to be filled.
+   */
+  static void makeDefaultMapping(const model::SubnetBuilder &builder1,
+                                 const model::SubnetBuilder &builder2,
+                                 CellToCell &mapping);
+
   /**
    * @brief Constructs the miter for the specified subnets.
    * @param builder Builder for constructing the miter.
@@ -155,6 +196,29 @@ public:
     makeMiter(builder, subnet1, subnet2);
   }
 
+  /**
+   * @brief Constructs the multi-output miter for the specified subnets:
+   * the i-th output is the XOR of the i-th outputs of the subnets.
+   * @param builder Builder for constructing the miter.
+   * @param subnet1 First subnet.
+   * @param subnet2 Second subnet.
+   * @param mapping Mapping between the PI/PO of the specified subnets.
+   */
+  static void makeOutputMiter(model::SubnetBuilder &builder,
+                              const model::Subnet &subnet1,
+                              const model::Subnet &subnet2,
+                              const CellToCell &mapping);
+
+  /**
+   * @brief Constructs the multi-output miter for the specified subnets.
+   * @param builder Builder for constructing the miter.
+   * @param subnet1 First subnet.
+   * @param subnet2 Second subnet.
+   */
+  static void makeOutputMiter(model::SubnetBuilder &builder,
+                              const model::Subnet &subnet1,
+                              const model::Subnet &subnet2);
+
   /**
    * @brief Constructs the miter for the specified subnets.
    * @param builder Builder for constructing the miter.
@@ -280,6 +344,10 @@ public:
                               const CellToCell &mapping) const;
 
   virtual ~BaseChecker() {}
+
+private:
+  /// Stop flag of the current thread.
+  static inline thread_local const StopFlag *stopFlag{nullptr};
 };
 
 } // namespace eda::gate::debugger
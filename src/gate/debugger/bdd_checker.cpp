@@ -7,24 +7,279 @@
 //===----------------------------------------------------------------------===//
 
 #include "gate/debugger/bdd_checker.h"
-#include "gate/model/utils/subnetview_to_bdd.h"
 
 #include <cassert>
+#include <vector>
 
 namespace eda::gate::debugger {
 
-CheckerResult BddChecker::isSat(const model::Subnet &subnet) const {
+using EntryID = model::EntryID;
+using Link = model::Subnet::Link;
+
+/// Returns the BDD variable index for each input.
+static std::vector<int> getVarOrder(const model::Subnet &subnet,
+                                    const BddChecker::Ordering ordering) {
+  const auto nIn = subnet.getInNum();
+  std::vector<int> order(nIn, -1);
+
+  int index = 0;
+  if (ordering == BddChecker::DFS) {
+    // The inputs are numbered as they are reached from the outputs.
+    std::vector<bool> visited(subnet.size(), false);
+    std::vector<std::pair<EntryID, uint16_t>> stack;
+
+    for (size_t i = 0; i < subnet.getOutNum(); ++i) {
+      stack.emplace_back(subnet.getOut(i).idx, 0);
+
+      while (!stack.empty()) {
+        auto &[idx, j] = stack.back();
+        const auto &cell = subnet.getCell(idx);
+
+        if (cell.isIn()) {
+          if (order[idx] == -1) {
+            order[idx] = index++;
+          }
+          stack.pop_back();
+        } else if (j < cell.arity) {
+          const auto link = subnet.getLink(idx, j++);
+          if (!visited[link.idx]) {
+            visited[link.idx] = true;
+            stack.emplace_back(link.idx, 0);
+          }
+        } else {
+          stack.pop_back();
+        }
+      }
+    }
+  }
+
+  // The unreachable inputs (or all in the INPUT ordering) are appended.
+  for (size_t i = 0; i < nIn; ++i) {
+    if (order[i] == -1) {
+      order[i] = index++;
+    }
+  }
+
+  return order;
+}
+
+/// Splits the miter output into the disjuncts (the OR tree of the XORs).
+static void getDisjuncts(const model::Subnet &subnet,
+                         const Link &link,
+                         std::vector<Link> &disjuncts) {
+  const auto &cell = subnet.getCell(link.idx);
+  if (!link.inv && cell.isOr()) {
+    for (uint16_t j = 0; j < cell.arity; ++j) {
+      getDisjuncts(subnet, subnet.getLink(link.idx, j), disjuncts);
+    }
+  } else {
+    disjuncts.push_back(link);
+  }
+}
+
+/// Applies the binary operation to the arguments (the result is referenced).
+template <typename Op>
+static DdNode *applyOp(DdManager *manager,
+                       const std::vector<DdNode*> &args,
+                       Op op) {
+  DdNode *result = args[0];
+  Cudd_Ref(result);
+
+  for (size_t i = 1; i < args.size(); ++i) {
+    DdNode *temp = op(manager, result, args[i]);
+    if (!temp) {
+      Cudd_RecursiveDeref(manager, result);
+      return nullptr;
+    }
+    Cudd_Ref(temp);
+    Cudd_RecursiveDeref(manager, result);
+    result = temp;
+  }
+
+  return result;
+}
+
+/// Negates the referenced BDD (the complement shares the reference).
+static DdNode *negate(DdNode *node) {
+  return node ? Cudd_Not(node) : nullptr;
+}
+
+/// Constructs the cell BDD (the result is referenced or nullptr).
+static DdNode *applyCell(DdManager *manager,
+                         const model::Subnet::Cell &cell,
+                         const std::vector<DdNode*> &args) {
+  DdNode *result = nullptr;
+
+  if (cell.isZero()) {
+    result = Cudd_ReadLogicZero(manager);
+  } else if (cell.isOne()) {
+    result = Cudd_ReadOne(manager);
+  } else if (cell.isBuf()) {
+    result = args[0];
+  } else if (cell.isAnd()) {
+    return applyOp(manager, args, Cudd_bddAnd);
+  } else if (cell.isOr()) {
+    return applyOp(manager, args, Cudd_bddOr);
+  } else if (cell.isXor()) {
+    return applyOp(manager, args, Cudd_bddXor);
+  } else if (cell.isMaj() && args.size() == 3) {
+    // maj(x, y, z) = x ? (y | z) : (y & z).
+    DdNode *lhs = applyOp(manager, {args[1], args[2]}, Cudd_bddOr);
+    if (!lhs) {
+      return nullptr;
+    }
+    DdNode *rhs = applyOp(manager, {args[1], args[2]}, Cudd_bddAnd);
+    if (!rhs) {
+      Cudd_RecursiveDeref(manager, lhs);
+      return nullptr;
+    }
+    result = Cudd_bddIte(manager, args[0], lhs, rhs);
+    if (result) {
+      Cudd_Ref(result);
+    }
+    Cudd_RecursiveDeref(manager, lhs);
+    Cudd_RecursiveDeref(manager, rhs);
+    return result;
+  } else {
+    // The negative cells are the negations of the positive ones.
+    switch (cell.getSymbol()) {
+      case model::NOT:
+        result = Cudd_Not(args[0]);
+        break;
+      case model::NAND:
+        return negate(applyOp(manager, args, Cudd_bddAnd));
+      case model::NOR:
+        return negate(applyOp(manager, args, Cudd_bddOr));
+      case model::XNOR:
+        return negate(applyOp(manager, args, Cudd_bddXor));
+      default:
+        // Unsupported cell.
+        return nullptr;
+    }
+  }
+
+  Cudd_Ref(result);
+  return result;
+}
+
+/// Constructs the BDD of the link (the result is referenced or nullptr).
+/// The BDDs of the cells are stored in the nodes vector (referenced).
+static DdNode *buildBdd(DdManager *manager,
+                        const model::Subnet &subnet,
+                        const Link &root,
+                        std::vector<DdNode*> &nodes) {
+  std::vector<std::pair<EntryID, uint16_t>> stack;
+  stack.emplace_back(root.idx, 0);
+
+  std::vector<DdNode*> args;
+  while (!stack.empty() && !nodes[root.idx]) {
+    if (BaseChecker::isStopped()) {
+      return nullptr;
+    }
+
+    auto &[idx, j] = stack.back();
+    const auto &cell = subnet.getCell(idx);
+
+    if (nodes[idx]) {
+      stack.pop_back();
+      continue;
+    }
+
+    // Unsupported multi-output cells.
+    if (j < cell.arity) {
+      const auto link = subnet.getLink(idx, j++);
+      if (link.out != 0) {
+        return nullptr;
+      }
+      if (!nodes[link.idx]) {
+        stack.emplace_back(link.idx, 0);
+      }
+      continue;
+    }
+
+    args.resize(cell.arity);
+    for (uint16_t k = 0; k < cell.arity; ++k) {
+      const auto link = subnet.getLink(idx, k);
+      args[k] = Cudd_NotCond(nodes[link.idx], link.inv);
+    }
+
+    nodes[idx] = applyCell(manager, cell, args);
+    if (!nodes[idx]) {
+      return nullptr;
+    }
+    stack.pop_back();
+  }
+
+  DdNode *result = Cudd_NotCond(nodes[root.idx], root.inv);
+  Cudd_Ref(result);
+  return result;
+}
+
+CheckerResult BddChecker::isSat(const model::Subnet &subnet,
+                                 const unsigned nodeLimit) const {
   assert(subnet.getOutNum() == 1);
 
-  Cudd manager(0, 0);
+  Cudd cudd(0, 0);
+  DdManager *manager = cudd.getManager();
+
+  if (timeLimit != 0) {
+    Cudd_SetTimeLimit(manager, timeLimit);
+    Cudd_ResetStartTime(manager);
+  }
+  if (reordering) {
+    Cudd_AutodynEnable(manager, CUDD_REORDER_SIFT);
+  }
+
+  const auto order = getVarOrder(subnet, ordering);
+  std::vector<DdNode*> nodes(subnet.size(), nullptr);
+  for (size_t i = 0; i < subnet.getInNum(); ++i) {
+    nodes[i] = Cudd_bddIthVar(manager, order[i]);
+    Cudd_Ref(nodes[i]);
+  }
+
+  // The limit is set after the variables are created (not to fail on them).
+  if (nodeLimit != 0) {
+    const auto nNodes = static_cast<unsigned>(Cudd_ReadNodeCount(manager));
+    Cudd_SetMaxLive(manager, nNodes + nodeLimit);
+  }
+
+  std::vector<Link> disjuncts;
+  getDisjuncts(subnet, subnet.getOut(0), disjuncts);
+
+  // The disjuncts are checked one by one in the shared manager.
+  CheckerResult result = CheckerResult::EQUAL;
+  for (const auto &disjunct : disjuncts) {
+    DdNode *bdd = buildBdd(manager, subnet, disjunct, nodes);
+    if (!bdd) {
+      result = CheckerResult::UNKNOWN;
+      break;
+    }
+
+    if (bdd != Cudd_ReadLogicZero(manager)) {
+      std::vector<char> cube(Cudd_ReadSize(manager));
+      Cudd_bddPickOneCube(manager, bdd, cube.data());
+
+      // The don't-care values (2) are set to zero.
+      std::vector<bool> counterExample(subnet.getInNum());
+      for (size_t i = 0; i < subnet.getInNum(); ++i) {
+        counterExample[i] = (cube[order[i]] == 1);
+      }
+
+      result = CheckerResult(CheckerResult::NOTEQUAL, counterExample);
+      Cudd_RecursiveDeref(manager, bdd);
+      break;
+    }
+
+    Cudd_RecursiveDeref(manager, bdd);
+  }
 
-  auto builderPtr = std::make_shared<model::SubnetBuilder>(subnet);
-  model::SubnetView sv(builderPtr);
-  BDD netBdd = model::utils::convertBdd(sv, manager).at(0);
+  for (auto *node : nodes) {
+    if (node) {
+      Cudd_RecursiveDeref(manager, node);
+    }
+  }
 
-  return (netBdd == manager.bddZero())
-      ? CheckerResult::EQUAL
-      : CheckerResult::NOTEQUAL;
+  return result;
 }
 
 } // namespace eda::gate::debugger
@@ -15,17 +15,62 @@ namespace eda::gate::debugger {
 
 using CellBddMap = model::utils::BddMap;
 
-/// Checks the equivalence of the specified nets using BDD construction.
+/**
+ * \brief Checks the equivalence of the specified nets using BDDs.
+ *
+ * The miter output is split into the disjuncts (the OR tree of the output
+ * XORs), and the BDD is constructed for each disjunct separately in a shared
+ * manager (the BDDs of the common cells are reused). The variable order is
+ * defined by the static heuristic (the inputs are ordered as they are reached
+ * by DFS from the outputs, so the corresponding inputs of the compared sides
+ * are adjacent), and the dynamic reordering (sifting) is optional. If the
+ * node or time limit is exceeded, the result is UNKNOWN.
+ */
 class BddChecker final : public BaseChecker,
                          public util::Singleton<BddChecker> {
   friend class util::Singleton<BddChecker>;
 
 public:
+  /// Static variable ordering.
+  enum Ordering {
+    /// Input order.
+    INPUT,
+    /// DFS fanin order.
+    DFS
+  };
+
   /// @copydoc BaseChecker::isSat
-  CheckerResult isSat(const model::Subnet &subnet) const override;
+  CheckerResult isSat(const model::Subnet &subnet) const override {
+    return isSat(subnet, nodeLimit);
+  }
+
+  /**
+   * @brief Checks if the given single-output subnet is satisfiable.
+   * @param subnet Subnet to be checked.
+   * @param nodeLimit Maximum number of live BDD nodes (0 for no limit).
+   * @return Checking result.
+   */
+  CheckerResult isSat(const model::Subnet &subnet, unsigned nodeLimit) const;
+
+  /// Sets the static variable ordering.
+  void setOrdering(Ordering ordering) { this->ordering = ordering; }
+
+  /// Enables/disables the dynamic reordering (sifting).
+  void setReordering(bool reordering) { this->reordering = reordering; }
+
+  /// Sets the maximum number of live BDD nodes (0 stands for no limit).
+  void setNodeLimit(unsigned nodeLimit) { this->nodeLimit = nodeLimit; }
+
+  /// Sets the time limit in milliseconds (0 stands for no limit).
+  void setTimeLimit(unsigned long timeLimit) { this->timeLimit = timeLimit; }
 
 private:
   BddChecker() {}
+
+  Ordering ordering{DFS};
+  bool reordering{false};
+  unsigned nodeLimit{0};
+  unsigned long timeLimit{0};
 };
 
 } // namespace eda::gate::debugger
@@ -8,212 +8,669 @@
 
 #include "gate/debugger/fraig_checker.h"
 #include "gate/debugger/sat_checker.h"
+#include "gate/solver/solver.h"
 
-#include <limits>
-#include <map>
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <optional>
 #include <random>
-#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace eda::gate::debugger {
 
 using options::SAT;
-using UniformIntDistribution = std::uniform_int_distribution<uint64_t>;
-
-struct EqPointResult {
-  /**
-   * Equivalence checking point statuses.
-   * UNKNOWN if the result is undefined.
-   * NOTEQUAL if the points are not equivalent.
-   * EQUAL if the points are equivalent.
-   */
-  enum EqPointStatus {
-    UNKNOWN = -2,
-    NOTEQUAL = -1,
-    EQUAL = 0,
-  };
-
-  /// Equivalence checking status.
-  EqPointStatus status;
-
-  /**
-   * @brief Point equivalence checking result.
-   * @param status Status of the occurred check.
-   */
-  EqPointResult(EqPointStatus status): status(status) {}
-
-  /**
-   * @copydoc EqPointResult::EqPointResult(EqPointStatus)
-   * @param counterEx Input values on which the nets are unequal.
-   * @param inputs Inputs mapping for a max cone.
-   */
-  EqPointResult(EqPointStatus status,
-                        const std::vector<bool> &counterExample,
-                        const model::Subnet::LinkList &inputs) {
-    assert(status == EqPointStatus::NOTEQUAL);
-    this->status = status;
-    this->counterExample = counterExample;
-    this->inputs = inputs;
-    this->counterExampleFlag = true;
-  }
-
-  void fillStorage(SimValuesStorage &storage,
-                   uint16_t &storageCount,
-                   const uint16_t nIn) {
-  if (storageCount >= FraigChecker::simLimit ||
-      !counterExampleFlag) {
-    return;
+using EntryID = model::EntryID;
+using Link = model::Subnet::Link;
+using Literal = solver::Literal;
+using Variable = solver::Variable;
+
+namespace {
+
+/**
+ * @brief SAT sweeping engine.
+ *
+ * The engine holds the simulation signatures of the cells, the representatives
+ * of the proven equivalence classes, and the incremental solver w/ the
+ * encoding of the already checked cones.
+ */
+class SatSweeper final {
+public:
+  enum Status { UNKNOWN, NOTEQUAL, EQUAL };
+
+  SatSweeper(const model::Subnet &subnet,
+             size_t nWords,
+             size_t conflictLimit);
+
+  /// Checks whether the cells are supported by the engine.
+  bool isSupported() const;
+
+  /// Sweeps the miter and checks its outputs.
+  CheckerResult run();
+
+private:
+  static constexpr Variable NoVar = -1;
+
+  /// Mixes the simulation word into the signature.
+  static uint64_t mix(uint64_t sign, uint64_t word) {
+    sign ^= word + 0x9e3779b97f4a7c15ull + (sign << 6) + (sign >> 2);
+    sign ^= sign >> 31;
+    sign *= 0xbf58476d1ce4e5b9ull;
+    return sign ^ (sign >> 29);
   }
-  auto counterExampleSize = counterExample.size();
 
-  UniformIntDistribution distribution(0, counterExampleSize);
-  //TODO: Replace with general generator.
-  std::mt19937 generator(std::random_device{}());
-  uint16_t index = distribution(generator);
-  counterExample[index].flip();
-  std::vector<bool> proof(nIn, false);
-  for (uint16_t i = 0; i < counterExampleSize; i++) {
-    proof[inputs[i].idx] = counterExample[i];
+  /// Returns the k-th simulation word of the link.
+  uint64_t getSim(const Link &link, size_t k) const {
+    const auto word = sims[link.idx * nWords + k];
+    return link.inv ? ~word : word;
   }
-  for (size_t i = 0; i < proof.size(); i++) {
-    storage[i].set(storageCount, proof[i]);
+
+  /// Returns the representative of the link source.
+  Link resolve(const Link &link) const {
+    EntryID idx = link.idx;
+    bool inv = link.inv;
+    while (repr[idx].idx != idx) {
+      inv ^= repr[idx].inv;
+      idx = repr[idx].idx;
+    }
+    return Link(idx, inv);
   }
-  storageCount += 1;
-}
 
-private:
-  bool counterExampleFlag = false;
-  std::vector<bool> counterExample{};
-  model::Subnet::LinkList inputs{};
-};
+  static uint64_t makePair(EntryID lhs, EntryID rhs) {
+    return (static_cast<uint64_t>(lhs) << 32) | rhs;
+  }
+
+  Literal lit(const Link &link) const {
+    assert(vars[link.idx] != NoVar);
+    return solver::makeLit(vars[link.idx], link.inv);
+  }
+
+  /// Simulates the cells on the given input words (nWords per input).
+  void simulate(const std::vector<uint64_t> &words);
+  /// Updates the signatures w/ the simulation words.
+  void updateSigns();
+  /// Resimulates the counterexamples and refines the classes.
+  void resimulate();
+
+  /// Adds the representative to its class.
+  void addRep(EntryID entryID);
+  /// Returns the earliest class member that is not proven to be unequal.
+  EntryID findCandidate(EntryID entryID) const;
+
+  /// Encodes the cone of the representative (if it is not encoded yet).
+  void encode(EntryID entryID);
+  void encodeCell(EntryID entryID);
+
+  /// Allows/disallows the decisions on the variables of the cones: the solver
+  /// does not assign the variables of the cones unrelated to the query.
+  void setDecisions(const std::vector<EntryID> &roots, bool isDecision);
+
+  /// Replaces the solver: the propagation in the cones of the previous
+  /// queries and the learnt clauses slow down the subsequent queries.
+  void recycle();
+
+  /// Checks whether the cells are equal (up to the inversion).
+  Status prove(EntryID lhs, EntryID rhs, bool inv);
+  /// Stores the satisfying assignment as the simulation pattern.
+  void addPattern();
 
-EqPointResult check(const uint32_t point1,
-                    const uint32_t point2,
-                    const std::shared_ptr<model::SubnetBuilder> &builder) {
+  /// Merges the cell w/ its candidate or makes it the representative.
+  /// Returns true if the cell has been compared w/ a candidate.
+  bool sweep(EntryID entryID);
+  /// Resimulates the counterexamples and sweeps the remaining classes.
+  bool refine();
 
-  model::SubnetView cone1(builder, point1);
+  /// Checks whether the output can be 1 (w/o limits).
+  CheckerResult checkOutput(const Link &link);
+  /// Returns the counterexample from the simulation words of the link.
+  std::optional<std::vector<bool>> getCounterExample(const Link &link) const;
+  std::vector<bool> getCounterExample();
 
-  model::SubnetView cone2(builder, point2);
+  const model::Subnet &subnet;
+  /// Number of the 64-bit simulation words per cell.
+  const size_t nWords;
+  const size_t conflictLimit;
+  /// Inputs, constants, and logic cells in topological order.
+  std::vector<EntryID> cells;
+  /// Virtual constant 0 (the last entry).
+  const EntryID constID;
 
-  const auto cone1InNum = cone1.getInNum();
-  const auto cone2InNum = cone2.getInNum();
+  /// Simulation words (nWords per cell).
+  std::vector<uint64_t> sims;
+  /// Hashes of all simulation words (w/ the accumulated counterexamples).
+  std::vector<uint64_t> signs;
+  /// Phases of the signatures (the complemented cells are in the same class).
+  std::vector<bool> phases;
 
-  if (cone1InNum != cone2InNum) {
-    return EqPointResult::NOTEQUAL;
+  std::vector<Link> repr;
+  /// Candidate classes: the representatives w/ the same signatures.
+  std::unordered_map<uint64_t, std::vector<EntryID>> classes;
+  /// Representatives in topological order.
+  std::vector<EntryID> reps;
+  /// Pairs of the representatives w/ the undefined equivalence.
+  std::unordered_set<uint64_t> unknown;
+
+  std::unique_ptr<solver::Solver> solver;
+  std::vector<Variable> vars;
+  size_t nQueries{0};
+
+  /// Cone of the current query.
+  std::vector<EntryID> cone;
+  std::vector<uint32_t> marks;
+  uint32_t stamp{0};
+
+  /// Counterexamples collected for resimulation (nWords per input).
+  std::vector<uint64_t> patterns;
+  size_t nPatterns{0};
+
+  std::mt19937_64 generator;
+};
+
+SatSweeper::SatSweeper(const model::Subnet &subnet,
+                       const size_t nWords,
+                       const size_t conflictLimit):
+    subnet(subnet),
+    nWords(nWords),
+    conflictLimit(conflictLimit),
+    constID(subnet.size()),
+    sims((subnet.size() + 1) * nWords, 0),
+    signs(subnet.size() + 1, 0),
+    phases(subnet.size() + 1, false),
+    repr(subnet.size() + 1),
+    solver(std::make_unique<solver::Solver>()),
+    vars(subnet.size() + 1, NoVar),
+    marks(subnet.size() + 1, 0),
+    patterns(subnet.getInNum() * nWords, 0) {
+  for (size_t i = 0; i < subnet.size(); ++i) {
+    const auto &cell = subnet.getCell(i);
+    repr[i] = Link(i);
+
+    if (!cell.isOut()) {
+      cells.push_back(i);
+    }
+    if (cell.isZero()) {
+      repr[i] = Link(constID, false);
+    } else if (cell.isOne()) {
+      repr[i] = Link(constID, true);
+    }
+
+    i += cell.more;
   }
-  auto inputs1 = cone1.getInputs();
-  auto inputs2 = cone2.getInputs();
-  std::unordered_map<uint32_t, uint32_t> inputToPos;
-  for (size_t i = 0; i < inputs2.size(); i++) {
-    inputToPos[inputs2[i].idx] = i;
+  repr[constID] = Link(constID);
+}
+
+bool SatSweeper::isSupported() const {
+  for (const auto i : cells) {
+    const auto &cell = subnet.getCell(i);
+    if (cell.more != 0) {
+      return false;
+    }
+    if (cell.isMaj() && cell.arity != 1 && cell.arity != 3) {
+      return false;
+    }
+    if (!cell.isIn() && !cell.isZero() && !cell.isOne() && !cell.isBuf() &&
+        !cell.isAnd() && !cell.isOr() && !cell.isXor() && !cell.isMaj()) {
+      return false;
+    }
   }
+  return true;
+}
+
+void SatSweeper::simulate(const std::vector<uint64_t> &words) {
+  std::copy(words.begin(), words.end(), sims.begin());
+
+  for (const auto i : cells) {
+    const auto &cell = subnet.getCell(i);
+    if (cell.isIn()) {
+      continue;
+    }
+
+    auto *result = &sims[i * nWords];
+    if (cell.isZero() || cell.isOne()) {
+      std::fill(result, result + nWords, cell.isZero() ? 0ull : ~0ull);
+      continue;
+    }
+
+    const auto link0 = subnet.getLink(i, 0);
+    for (size_t k = 0; k < nWords; ++k) {
+      result[k] = getSim(link0, k);
+    }
 
-  for (size_t i = 0; i < cone1InNum; ++i) {
-    try {
-      inputToPos.at(inputs1[i].idx);
+    if (cell.isMaj() && cell.arity == 3) {
+      const auto link1 = subnet.getLink(i, 1);
+      const auto link2 = subnet.getLink(i, 2);
+      for (size_t k = 0; k < nWords; ++k) {
+        const auto x = result[k];
+        const auto y = getSim(link1, k);
+        const auto z = getSim(link2, k);
+        result[k] = (x & y) | (x & z) | (y & z);
+      }
+      continue;
     }
-    catch (const std::out_of_range &e) {
-      return EqPointResult::NOTEQUAL;
+
+    for (uint16_t j = 1; j < cell.arity; ++j) {
+      const auto link = subnet.getLink(i, j);
+      for (size_t k = 0; k < nWords; ++k) {
+        const auto arg = getSim(link, k);
+        if (cell.isAnd()) {
+          result[k] &= arg;
+        } else if (cell.isOr()) {
+          result[k] |= arg;
+        } else {
+          result[k] ^= arg;
+        }
+      }
     }
   }
-  // FIXME: Returns unknown.
-  CheckerResult res = BaseChecker::getChecker(SAT).areEquivalent(cone1, cone2);
+}
 
-  if (res.notEqual()) {
-    return EqPointResult(EqPointResult::NOTEQUAL,
-                                 res.getCounterExample(),
-                                 cone1.getInputs());
+void SatSweeper::updateSigns() {
+  for (const auto i : cells) {
+    const auto mask = phases[i] ? ~0ull : 0ull;
+    for (size_t k = 0; k < nWords; ++k) {
+      signs[i] = mix(signs[i], sims[i * nWords + k] ^ mask);
+    }
   }
-  if (res.equal()) {
-    return EqPointResult::EQUAL;
+  for (size_t k = 0; k < nWords; ++k) {
+    signs[constID] = mix(signs[constID], 0);
   }
-  return EqPointResult::UNKNOWN;
 }
 
-void simulate(simulator::Simulator &simulator,
-              const uint16_t nIn) {
-  simulator::Simulator::DataVector values(nIn);
-  //TODO: Replace with general generator.
-  std::mt19937 generator;
-  UniformIntDistribution distrib(0, std::numeric_limits<uint64_t>::max());
-  for (size_t k = 0; k < nIn; ++k) {
-    values[k] = distrib(generator);
+void SatSweeper::resimulate() {
+  if (nPatterns == 0) {
+    return;
+  }
+
+  // The unused bits are filled w/ the random patterns.
+  const auto nBits = nWords * 64;
+  for (size_t i = 0; i < subnet.getInNum(); ++i) {
+    for (auto p = nPatterns; p < nBits; ++p) {
+      if (generator() & 1) {
+        patterns[i * nWords + p / 64] |= 1ull << (p % 64);
+      }
+    }
+  }
+
+  simulate(patterns);
+  updateSigns();
+
+  std::fill(patterns.begin(), patterns.end(), 0);
+  nPatterns = 0;
+
+  classes.clear();
+  for (const auto rep : reps) {
+    classes[signs[rep]].push_back(rep);
   }
-  simulator.simulate(values);
 }
 
-void simulate(simulator::Simulator &simulator,
-              const uint16_t nIn,
-              SimValuesStorage &storage) {
-  simulator::Simulator::DataVector values(nIn);
-  for (size_t k = 0; k < nIn; ++k) {
-    values[k] = storage[k].to_ullong();
+void SatSweeper::addRep(const EntryID entryID) {
+  reps.push_back(entryID);
+  classes[signs[entryID]].push_back(entryID);
+}
+
+EntryID SatSweeper::findCandidate(const EntryID entryID) const {
+  const auto i = classes.find(signs[entryID]);
+  if (i == classes.end()) {
+    return entryID;
   }
-  simulator.simulate(values);
-  std::fill(storage.begin(), storage.end(), std::bitset<64>());
+  for (const auto rep : i->second) {
+    if (!unknown.count(makePair(rep, entryID))) {
+      return rep;
+    }
+  }
+  return entryID;
 }
 
-CheckerResult FraigChecker::isSat(const model::Subnet &subnet) const {
-  auto miterBuilderPtr = std::make_shared<model::SubnetBuilder>(subnet);
-  auto &miterBuilder = *miterBuilderPtr;
-  uint16_t storageCount = 0;
-  SimValuesStorage storage(subnet.getInNum());
-
-  while (true) {
-    size_t compareCount = 0;
-    const uint16_t nIn = miterBuilder.getInNum();
-
-    // Simulation
-    simulator::Simulator simulator(miterBuilderPtr);
-    if (storageCount) {
-      simulate(simulator, nIn, storage);
-      storageCount = 0;
-    } else {
-      simulate(simulator, nIn);
-    }
-
-    std::unordered_map<uint64_t, std::set<uint32_t>> eqClassToIdx;
-    model::SubnetBuilder::MergeMap toBeMerged;
-    std::unordered_set<uint32_t> checked;
-
-    for (auto it = miterBuilder.begin();
-              it != miterBuilder.end();
-              it.nextCell()) {
-      const auto &cell = miterBuilder.getCell(*it);
-      if (cell.isOut() || cell.isIn()) {
+void SatSweeper::encode(const EntryID entryID) {
+  const auto nVars = solver->getVarNum();
+  std::vector<EntryID> stack{entryID};
+
+  while (!stack.empty()) {
+    const auto i = stack.back();
+    if (vars[i] != NoVar) {
+      stack.pop_back();
+      continue;
+    }
+
+    bool isReady = true;
+    if (i != constID) {
+      const auto &cell = subnet.getCell(i);
+      for (uint16_t j = 0; j < cell.arity; ++j) {
+        const auto source = resolve(subnet.getLink(i, j)).idx;
+        if (vars[source] == NoVar) {
+          stack.push_back(source);
+          isReady = false;
+        }
+      }
+    }
+
+    if (isReady) {
+      stack.pop_back();
+      encodeCell(i);
+    }
+  }
+
+  // The decisions are allowed only for the query cones.
+  for (auto var = nVars; var < solver->getVarNum(); ++var) {
+    solver->setDecision(var, false);
+  }
+}
+
+void SatSweeper::setDecisions(const std::vector<EntryID> &roots,
+                              const bool isDecision) {
+  if (isDecision) {
+    cone.clear();
+    stamp++;
+
+    std::vector<EntryID> stack(roots);
+    while (!stack.empty()) {
+      const auto i = stack.back();
+      stack.pop_back();
+
+      if (marks[i] == stamp) {
         continue;
       }
-      uint64_t const cellIdx1 = *it;
-      uint64_t const eqClass = simulator.getValue(cellIdx1);
-      if (compareCount > compareLimit) {
-        break;
+      marks[i] = stamp;
+      cone.push_back(i);
+
+      if (i == constID) {
+        continue;
       }
-      if (eqClassToIdx.find(eqClass) != eqClassToIdx.end()) {
-        for (auto cellIdx2 : eqClassToIdx[eqClass]) {
-          if (cellIdx1 == cellIdx2 || checked.find(cellIdx2) != checked.end()) {
-            continue;
-          }
-          compareCount += 1;
-          auto res = check(cellIdx1, cellIdx2, miterBuilderPtr);
-          res.fillStorage(storage, storageCount, nIn);
-          if (res.status == EqPointResult::EQUAL) {
-            toBeMerged[cellIdx2].insert(cellIdx1);
-            checked.insert(cellIdx1);
-          } else {
-            eqClassToIdx[eqClass].insert(cellIdx1);
-          }
-        }
-      } else {
-        eqClassToIdx[eqClass].insert(cellIdx1);
+      const auto &cell = subnet.getCell(i);
+      for (uint16_t j = 0; j < cell.arity; ++j) {
+        stack.push_back(resolve(subnet.getLink(i, j)).idx);
       }
-    } // for idx-to-val
+    }
+  }
+
+  for (const auto i : cone) {
+    solver->setDecision(vars[i], isDecision);
+  }
+}
+
+void SatSweeper::encodeCell(const EntryID entryID) {
+  vars[entryID] = solver->newVar();
+  const auto rhs = lit(Link(entryID));
+
+  if (entryID == constID) {
+    solver->addClause(~rhs);
+    return;
+  }
+
+  const auto &cell = subnet.getCell(entryID);
+  if (cell.isIn()) {
+    return;
+  }
+
+  std::vector<Literal> args(cell.arity);
+  for (uint16_t j = 0; j < cell.arity; ++j) {
+    args[j] = lit(resolve(subnet.getLink(entryID, j)));
+  }
+
+  if (cell.arity == 1) {
+    solver->encodeBuf(rhs, args[0]);
+  } else if (cell.isAnd() || cell.isOr()) {
+    // AND: rhs = &args; OR: ~rhs = &(~args).
+    const bool isOr = cell.isOr();
+    solver::Clause clause;
+    clause.push(isOr ? ~rhs : rhs);
+    for (const auto arg : args) {
+      solver->addClause(isOr ? rhs : ~rhs, isOr ? ~arg : arg);
+      clause.push(isOr ? arg : ~arg);
+    }
+    solver->addClause(clause);
+  } else if (cell.isXor()) {
+    auto acc = args[0];
+    for (uint16_t j = 1; j < cell.arity; ++j) {
+      const auto out = (j + 1 == cell.arity) ? rhs : solver->newLit();
+      solver->encodeXor(out, acc, args[j]);
+      acc = out;
+    }
+  } else {
+    assert(cell.isMaj() && cell.arity == 3);
+    solver->encodeMaj(rhs, args[0], args[1], args[2]);
+  }
+}
+
+void SatSweeper::addPattern() {
+  const auto k = nPatterns / 64;
+  const auto bit = 1ull << (nPatterns % 64);
+
+  for (size_t i = 0; i < subnet.getInNum(); ++i) {
+    // The inputs out of the query cone are not assigned.
+    const bool value = (vars[i] != NoVar && marks[i] == stamp)
+        ? solver->value(vars[i])
+        : (generator() & 1);
+    if (value) {
+      patterns[i * nWords + k] |= bit;
+    }
+  }
+
+  if (++nPatterns == nWords * 64) {
+    resimulate();
+  }
+}
+
+void SatSweeper::recycle() {
+  solver = std::make_unique<solver::Solver>();
+  std::fill(vars.begin(), vars.end(), NoVar);
+  nQueries = 0;
+}
+
+SatSweeper::Status SatSweeper::prove(const EntryID lhs,
+                                     const EntryID rhs,
+                                     const bool inv) {
+  if (++nQueries > FraigChecker::recycleLimit) {
+    recycle();
+  }
+
+  encode(lhs);
+  encode(rhs);
+
+  const auto lhsLit = lit(Link(lhs));
+  const auto rhsLit = lit(Link(rhs, inv));
+
+  // The miter of the cells is asserted via the assumption.
+  const auto miterVar = solver->newVar();
+  const auto miter = solver::makeLit(miterVar, false);
+  solver->setDecision(miterVar, false);
+  solver->encodeXor(miter, lhsLit, rhsLit);
+
+  solver::Clause assumptions;
+  assumptions.push(miter);
+
+  setDecisions({lhs, rhs}, true);
+  const auto status =
+      solver->solveLimited(assumptions, conflictLimit);
+
+  if (status == Minisat::l_True) {
+    addPattern();
+  }
+  setDecisions({}, false);
+
+  if (status == Minisat::l_False) {
+    // The proven equivalence simplifies the subsequent queries.
+    solver->encodeBuf(lhsLit, rhsLit);
+    return EQUAL;
+  }
+  return (status == Minisat::l_True) ? NOTEQUAL : UNKNOWN;
+}
+
+bool SatSweeper::sweep(const EntryID entryID) {
+  const auto candidate = findCandidate(entryID);
+  if (candidate == entryID) {
+    addRep(entryID);
+    return false;
+  }
+
+  const bool inv = phases[entryID] != phases[candidate];
+  const auto status = prove(entryID, candidate, inv);
+
+  if (status == EQUAL) {
+    repr[entryID] = Link(candidate, inv);
+  } else {
+    // The unequal cells are separated by the counterexample.
+    if (status == UNKNOWN) {
+      unknown.insert(makePair(candidate, entryID));
+    }
+    addRep(entryID);
+  }
+  return true;
+}
+
+bool SatSweeper::refine() {
+  resimulate();
+
+  std::vector<EntryID> oldReps;
+  oldReps.swap(reps);
+  classes.clear();
+
+  bool isChanged = false;
+  for (const auto rep : oldReps) {
+    if (BaseChecker::isStopped()) {
+      return false;
+    }
+    isChanged |= sweep(rep);
+  }
+  return isChanged;
+}
+
+std::optional<std::vector<bool>> SatSweeper::getCounterExample(
+    const Link &link) const {
+  for (size_t k = 0; k < nWords; ++k) {
+    const auto word = getSim(link, k);
+    if (word == 0) {
+      continue;
+    }
+
+    uint16_t bit = 0;
+    while (!((word >> bit) & 1)) {
+      bit++;
+    }
+
+    std::vector<bool> counterExample(subnet.getInNum());
+    for (size_t i = 0; i < subnet.getInNum(); ++i) {
+      counterExample[i] = (sims[i * nWords + k] >> bit) & 1;
+    }
+    return counterExample;
+  }
+  return std::nullopt;
+}
+
+std::vector<bool> SatSweeper::getCounterExample() {
+  std::vector<bool> counterExample(subnet.getInNum());
+  for (size_t i = 0; i < subnet.getInNum(); ++i) {
+    counterExample[i] = (vars[i] != NoVar) && solver->value(vars[i]);
+  }
+  return counterExample;
+}
+
+CheckerResult SatSweeper::checkOutput(const Link &link) {
+  const auto source = resolve(link);
+
+  if (source.idx == constID) {
+    return source.inv
+        ? CheckerResult(CheckerResult::NOTEQUAL,
+                        std::vector<bool>(subnet.getInNum(), false))
+        : CheckerResult(CheckerResult::EQUAL);
+  }
+
+  // The simulation patterns may contain a counterexample.
+  if (const auto counterExample = getCounterExample(source)) {
+    return CheckerResult(CheckerResult::NOTEQUAL, *counterExample);
+  }
+
+  encode(source.idx);
+
+  solver::Clause assumptions;
+  assumptions.push(lit(source));
+
+  // The solving is split into the budgeted runs to poll the stop flag.
+  setDecisions({source.idx}, true);
+  auto status = Minisat::l_Undef;
+  if (!BaseChecker::getStopFlag()) {
+    status = solver->solve(assumptions) ? Minisat::l_True : Minisat::l_False;
+  }
+  while (status == Minisat::l_Undef && !BaseChecker::isStopped()) {
+    status = solver->solveLimited(assumptions, conflictLimit);
+  }
+
+  auto result = CheckerResult(CheckerResult::UNKNOWN);
+  if (status == Minisat::l_True) {
+    result = CheckerResult(CheckerResult::NOTEQUAL, getCounterExample());
+  } else if (status == Minisat::l_False) {
+    result = CheckerResult(CheckerResult::EQUAL);
+  }
+  setDecisions({}, false);
+
+  return result;
+}
+
+CheckerResult SatSweeper::run() {
+  // Initial random simulation.
+  std::vector<uint64_t> words(subnet.getInNum() * nWords);
+  for (auto &word : words) {
+    word = generator();
+  }
+  simulate(words);
+
+  for (const auto i : cells) {
+    phases[i] = sims[i * nWords] & 1;
+  }
+  updateSigns();
+
+  // The random patterns may contain a counterexample.
+  for (size_t i = 0; i < subnet.getOutNum(); ++i) {
+    if (const auto counterExample = getCounterExample(subnet.getOut(i))) {
+      return CheckerResult(CheckerResult::NOTEQUAL, *counterExample);
+    }
+  }
+
+  addRep(constID);
 
-    if (toBeMerged.empty()) {
-      break;
+  for (const auto i : cells) {
+    const auto &cell = subnet.getCell(i);
+    if (cell.isZero() || cell.isOne()) {
+      continue;
     }
-    miterBuilder.mergeCells(toBeMerged);
+    if (cell.isIn()) {
+      addRep(i);
+      continue;
+    }
+    if (BaseChecker::isStopped()) {
+      return CheckerResult::UNKNOWN;
+    }
+    sweep(i);
+  }
+
+  // The classes are refined by the counterexamples until no candidates left.
+  while (refine());
+
+  if (BaseChecker::isStopped()) {
+    return CheckerResult::UNKNOWN;
+  }
+
+  for (size_t i = 0; i < subnet.getOutNum(); ++i) {
+    const auto result = checkOutput(subnet.getOut(i));
+    if (!result.equal()) {
+      return result;
+    }
+  }
+
+  return CheckerResult::EQUAL;
+}
+
+} // namespace
+
+CheckerResult FraigChecker::isSat(const model::Subnet &subnet) const {
+  SatSweeper sweeper(subnet, simWords, conflictLimit);
+  if (!sweeper.isSupported()) {
+    return getChecker(SAT).isSat(subnet);
   }
-  // FIXME: Creates a subnet.
-  return getChecker(SAT).isSat(miterBuilder);
+  return sweeper.run();
 }
 
 } // namespace eda::gate::debugger
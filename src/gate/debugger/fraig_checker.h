@@ -9,20 +9,28 @@
 #pragma once
 
 #include "gate/debugger/base_checker.h"
-#include "gate/simulator/simulator.h"
 
-#include <bitset>
-#include <vector>
+#include <cassert>
+#include <cstddef>
 
 namespace eda::gate::debugger {
 
-using SimValuesStorage = std::vector<std::bitset<64>>;
-
 /**
  * \brief Implements FRAIG-based method of LEC.
  *
  * The algorithm is based on the article "Improvements to combinational
  * equivalence checking" by A. Mishchenko, S. Chatterjee, R. Brayton (2006).
+ *
+ * The miter is swept in topological order by a single incremental SAT solver.
+ * The cones are encoded lazily; the candidate equivalences (the cells w/ the
+ * same simulation signatures up to complementation) are checked under the
+ * assumptions w/ the conflict budget. The signatures are hashed vectors of
+ * the simulation words; the classes are partitioned by the signatures. The
+ * counterexamples are accumulated and used for bit-parallel resimulation
+ * that refines the classes; the sweeping is repeated until each class is
+ * either merged or split. The proven equivalences are merged: the subsequent
+ * cells are encoded over the representatives. The solver is recreated after
+ * a number of queries.
  */
 class FraigChecker final : public BaseChecker,
                            public util::Singleton<FraigChecker> {
@@ -32,14 +40,28 @@ public:
   /// @copydoc BaseChecker::isSat
   CheckerResult isSat(const model::Subnet &subnet) const override;
 
-  /// Simulator arity limit
-  static constexpr size_t simLimit = 64;
+  /// Sets the number of 64-bit simulation words per cell.
+  void setSimWords(size_t simWords) {
+    assert(simWords > 0);
+    this->simWords = simWords;
+  }
+
+  /// Sets the number of conflicts allowed in a single equivalence query.
+  void setConflictLimit(size_t conflictLimit) {
+    this->conflictLimit = conflictLimit;
+  }
 
-  /// Cell comparisons limit
-  static constexpr size_t compareLimit = 500;
+  /// Number of queries after which the solver is recreated
+  static constexpr size_t recycleLimit = 100;
 
 private:
-  FraigChecker() {}
+  FraigChecker(size_t simWords, size_t conflictLimit):
+      simWords(simWords), conflictLimit(conflictLimit) {}
+
+  FraigChecker(): FraigChecker(4, 1000) {}
+
+  size_t simWords;
+  size_t conflictLimit;
 };
 
 } // namespace eda::gate::debugger
@@ -0,0 +1,420 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/debugger/lec_preprocessor.h"
+
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace eda::gate::debugger {
+
+using EntryID = model::EntryID;
+using Link = model::Subnet::Link;
+using LinkList = model::Subnet::LinkList;
+
+namespace {
+
+/// And-inverter graph w/ structural hashing.
+class Aig final {
+public:
+  /// Literal: (node << 1) | inversion; node 0 is the constant 0.
+  using Lit = uint32_t;
+  using LitList = std::vector<Lit>;
+
+  static constexpr Lit Zero = 0;
+  static constexpr Lit One = 1;
+
+  static Lit makeLit(const uint32_t node, const bool inv) {
+    return (node << 1) | inv;
+  }
+
+  static uint32_t getNode(const Lit lit) { return lit >> 1; }
+  static bool isInv(const Lit lit) { return lit & 1; }
+
+  Aig(const size_t nIn): nIn(nIn), nodes(nIn + 1) {}
+
+  size_t getInNum() const { return nIn; }
+  size_t size() const { return nodes.size(); }
+
+  Lit getIn(const size_t i) const { return makeLit(i + 1, false); }
+  bool isAnd(const uint32_t node) const { return node > nIn; }
+
+  Lit getLhs(const uint32_t node) const { return nodes[node].first; }
+  Lit getRhs(const uint32_t node) const { return nodes[node].second; }
+
+  Lit makeAnd(Lit lhs, Lit rhs);
+  Lit makeOr(const Lit lhs, const Lit rhs) {
+    return makeAnd(lhs ^ 1, rhs ^ 1) ^ 1;
+  }
+  Lit makeXor(Lit lhs, Lit rhs);
+  Lit makeMux(const Lit sel, const Lit lhs, const Lit rhs) {
+    return makeOr(makeAnd(sel, lhs), makeAnd(sel ^ 1, rhs));
+  }
+  Lit makeMaj(const LitList &args);
+
+  /// Reduces the literals by the balanced tree of the binary operations.
+  template <typename Op>
+  Lit makeTree(LitList args, Op op);
+
+  /// Adds the subnet over the given inputs; returns false if unsupported.
+  bool addSubnet(const model::Subnet &subnet,
+                 const LitList &inputs,
+                 LitList &outputs);
+
+private:
+  bool addCell(const model::Subnet::Cell &cell,
+               const LitList &args,
+               LitList &outputs);
+
+  const size_t nIn;
+  std::vector<std::pair<Lit, Lit>> nodes;
+  std::unordered_map<uint64_t, uint32_t> strash;
+};
+
+Aig::Lit Aig::makeAnd(Lit lhs, Lit rhs) {
+  if (lhs > rhs) {
+    std::swap(lhs, rhs);
+  }
+
+  if (lhs == Zero) return Zero;
+  if (lhs == One) return rhs;
+  if (lhs == rhs) return lhs;
+  if (lhs == (rhs ^ 1)) return Zero;
+
+  const auto key = (static_cast<uint64_t>(lhs) << 32) | rhs;
+  const auto i = strash.find(key);
+  if (i != strash.end()) {
+    return makeLit(i->second, false);
+  }
+
+  const uint32_t node = nodes.size();
+  nodes.emplace_back(lhs, rhs);
+  strash.emplace(key, node);
+  return makeLit(node, false);
+}
+
+Aig::Lit Aig::makeXor(Lit lhs, Lit rhs) {
+  // The inversions are moved to the output: XOR(a, b) over the nodes.
+  const bool inv = isInv(lhs) != isInv(rhs);
+  lhs &= ~1u;
+  rhs &= ~1u;
+
+  Lit result;
+  if (lhs == Zero) {
+    result = rhs;
+  } else if (rhs == Zero) {
+    result = lhs;
+  } else if (lhs == rhs) {
+    result = Zero;
+  } else {
+    result = makeOr(makeAnd(lhs, rhs ^ 1), makeAnd(lhs ^ 1, rhs));
+  }
+  return result ^ inv;
+}
+
+Aig::Lit Aig::makeMaj(const LitList &args) {
+  assert(args.size() & 1);
+  const auto n = args.size();
+
+  if (n == 1) {
+    return args[0];
+  }
+  if (n == 3) {
+    return makeOr(makeAnd(args[0], args[1]),
+                  makeAnd(args[2], makeOr(args[0], args[1])));
+  }
+
+  // Threshold function: th[k] = at least k of the args[i..n) are true.
+  const auto k = (n + 1) / 2;
+  LitList th(k + 1, Zero);
+  th[0] = One;
+  for (size_t i = n; i-- > 0;) {
+    for (size_t j = k; j > 0; --j) {
+      th[j] = makeMux(args[i], th[j - 1], th[j]);
+    }
+  }
+  return th[k];
+}
+
+template <typename Op>
+Aig::Lit Aig::makeTree(LitList args, Op op) {
+  assert(!args.empty());
+  while (args.size() > 1) {
+    size_t j = 0;
+    for (size_t i = 0; i + 1 < args.size(); i += 2) {
+      args[j++] = op(args[i], args[i + 1]);
+    }
+    if (args.size() & 1) {
+      args[j++] = args.back();
+    }
+    args.resize(j);
+  }
+  return args[0];
+}
+
+bool Aig::addCell(const model::Subnet::Cell &cell,
+                  const LitList &args,
+                  LitList &outputs) {
+  const auto andOp = [this](Lit lhs, Lit rhs) { return makeAnd(lhs, rhs); };
+  const auto orOp  = [this](Lit lhs, Lit rhs) { return makeOr(lhs, rhs); };
+  const auto xorOp = [this](Lit lhs, Lit rhs) { return makeXor(lhs, rhs); };
+
+  const auto &type = cell.getType();
+  const auto symbol = type.getSymbol();
+
+  switch (symbol) {
+    case model::ZERO: outputs.push_back(Zero); return true;
+    case model::ONE:  outputs.push_back(One); return true;
+    case model::BUF:  outputs.push_back(args[0]); return true;
+    case model::AND:  outputs.push_back(makeTree(args, andOp)); return true;
+    case model::OR:   outputs.push_back(makeTree(args, orOp)); return true;
+    case model::XOR:  outputs.push_back(makeTree(args, xorOp)); return true;
+    case model::MAJ:
+      if (args.size() & 1) {
+        outputs.push_back(makeMaj(args));
+        return true;
+      }
+      return false;
+    default:
+      break;
+  }
+
+  // The cells w/ the subnet implementation are inlined.
+  if (type.isCombinational() && type.isSubnet()) {
+    return addSubnet(type.getSubnet(), args, outputs);
+  }
+  return false;
+}
+
+bool Aig::addSubnet(const model::Subnet &subnet,
+                    const LitList &inputs,
+                    LitList &outputs) {
+  assert(inputs.size() == subnet.getInNum());
+
+  // Literals of the cell outputs: out=0 and out>0 are stored separately.
+  LitList lits(subnet.size());
+  std::unordered_map<uint64_t, Lit> outLits;
+
+  const auto getLit = [&](const Link &link) {
+    const auto lit = link.out == 0
+        ? lits[link.idx]
+        : outLits[(static_cast<uint64_t>(link.idx) << 3) | link.out];
+    return lit ^ static_cast<Lit>(link.inv);
+  };
+
+  for (EntryID i = 0; i < subnet.size(); ++i) {
+    const auto &cell = subnet.getCell(i);
+
+    if (cell.isIn()) {
+      lits[i] = inputs[i];
+      continue;
+    }
+
+    LitList args(cell.arity);
+    for (uint16_t j = 0; j < cell.arity; ++j) {
+      args[j] = getLit(subnet.getLink(i, j));
+    }
+
+    if (cell.isOut()) {
+      outputs.push_back(args[0]);
+    } else {
+      LitList cellOutputs;
+      if (!addCell(cell, args, cellOutputs)) {
+        return false;
+      }
+      lits[i] = cellOutputs[0];
+      for (size_t j = 1; j < cellOutputs.size(); ++j) {
+        outLits[(static_cast<uint64_t>(i) << 3) | j] = cellOutputs[j];
+      }
+    }
+
+    i += cell.more;
+  }
+
+  return true;
+}
+
+using LitPairs = std::vector<std::pair<Aig::Lit, Aig::Lit>>;
+
+/// Constructs the single-output miter for the output pairs (the cones only).
+void makeReducedMiter(model::SubnetBuilder &builder,
+                      const Aig &aig,
+                      const LitPairs &pairs) {
+  std::vector<bool> marks(aig.size(), false);
+  std::vector<uint32_t> stack;
+  for (const auto &[lhs, rhs] : pairs) {
+    stack.push_back(Aig::getNode(lhs));
+    stack.push_back(Aig::getNode(rhs));
+  }
+
+  while (!stack.empty()) {
+    const auto node = stack.back();
+    stack.pop_back();
+
+    if (marks[node]) {
+      continue;
+    }
+    marks[node] = true;
+
+    if (aig.isAnd(node)) {
+      stack.push_back(Aig::getNode(aig.getLhs(node)));
+      stack.push_back(Aig::getNode(aig.getRhs(node)));
+    }
+  }
+
+  // The miter keeps all the inputs to preserve the counterexample format.
+  const auto inputs = builder.addInputs(aig.getInNum());
+
+  LinkList links(aig.size());
+  if (marks[0]) {
+    links[0] = builder.addCell(model::ZERO);
+  }
+  for (size_t i = 0; i < aig.getInNum(); ++i) {
+    links[i + 1] = inputs[i];
+  }
+
+  const auto getLink = [&links](const Aig::Lit lit) {
+    const auto &link = links[Aig::getNode(lit)];
+    return Aig::isInv(lit) ? ~link : link;
+  };
+
+  for (uint32_t node = aig.getInNum() + 1; node < aig.size(); ++node) {
+    if (marks[node]) {
+      links[node] = builder.addCell(model::AND,
+                                    getLink(aig.getLhs(node)),
+                                    getLink(aig.getRhs(node)));
+    }
+  }
+
+  LinkList xors;
+  for (const auto &[lhs, rhs] : pairs) {
+    xors.push_back(builder.addCell(model::XOR, getLink(lhs), getLink(rhs)));
+  }
+
+  if (xors.size() == 1) {
+    builder.addOutput(xors[0]);
+  } else {
+    builder.addOutput(builder.addCellTree(model::OR, xors, 2));
+  }
+}
+
+} // namespace
+
+CheckerResult LecPreprocessor::preprocess(model::SubnetBuilder &builder,
+                                          const model::Subnet &subnet1,
+                                          const model::Subnet &subnet2,
+                                          const CellToCell &mapping) {
+  const auto nIn = subnet1.getInNum();
+  const auto nOut = subnet1.getOutNum();
+
+  assert(subnet2.getInNum() == nIn);
+  assert(subnet2.getOutNum() == nOut);
+
+  stats.nOut += nOut;
+
+  Aig aig(nIn);
+  Aig::LitList inputs1(nIn), inputs2(nIn);
+  for (size_t i = 0; i < nIn; ++i) {
+    inputs1[i] = aig.getIn(i);
+    inputs2[mapping.find(i)->second] = aig.getIn(i);
+  }
+
+  Aig::LitList outputs1, outputs2;
+  if (!aig.addSubnet(subnet1, inputs1, outputs1) ||
+      !aig.addSubnet(subnet2, inputs2, outputs2)) {
+    BaseChecker::makeMiter(builder, subnet1, subnet2, mapping);
+    return CheckerResult::UNKNOWN;
+  }
+
+  LitPairs pairs;
+  std::unordered_set<uint64_t> keys;
+
+  for (size_t i = 0; i < nOut; ++i) {
+    const auto idx1 = subnet1.size() - nOut + i;
+    const auto idx2 = mapping.find(idx1)->second;
+
+    auto lhs = outputs1[i];
+    auto rhs = outputs2[idx2 - (subnet2.size() - nOut)];
+
+    if (lhs == rhs) {
+      stats.nProven++;
+      continue;
+    }
+    if (lhs == (rhs ^ 1)) {
+      // The outputs differ on any input.
+      stats.nDisproved++;
+      return CheckerResult(CheckerResult::NOTEQUAL, std::vector<bool>(nIn));
+    }
+
+    // XOR(a, b) = XOR(~a, ~b): the pairs are normalized.
+    if (lhs > rhs) {
+      std::swap(lhs, rhs);
+    }
+    if (Aig::isInv(lhs)) {
+      lhs ^= 1;
+      rhs ^= 1;
+    }
+
+    const auto key = (static_cast<uint64_t>(lhs) << 32) | rhs;
+    if (!keys.insert(key).second) {
+      stats.nDuplicates++;
+      continue;
+    }
+    pairs.emplace_back(lhs, rhs);
+  }
+
+  if (pairs.empty()) {
+    return CheckerResult::EQUAL;
+  }
+
+  makeReducedMiter(builder, aig, pairs);
+  return CheckerResult::UNKNOWN;
+}
+
+CheckerResult LecPreprocessor::areEquivalent(const BaseChecker &checker,
+                                             const model::Subnet &subnet1,
+                                             const model::Subnet &subnet2,
+                                             const CellToCell &mapping) {
+  model::SubnetBuilder builder;
+  const auto result = preprocess(builder, subnet1, subnet2, mapping);
+  if (!result.isUnknown()) {
+    return result;
+  }
+  return checker.isSat(model::Subnet::get(builder.make()));
+}
+
+CheckerResult LecPreprocessor::areEquivalent(const BaseChecker &checker,
+                                             const model::Subnet &subnet1,
+                                             const model::Subnet &subnet2) {
+  CellToCell mapping;
+  BaseChecker::makeDefaultMapping(subnet1, subnet2, mapping);
+  return areEquivalent(checker, subnet1, subnet2, mapping);
+}
+
+CheckerResult LecPreprocessor::areEquivalent(const BaseChecker &checker,
+                                             model::DesignBuilder &builder,
+                                             const std::string &point1,
+                                             const std::string &point2) {
+  for (size_t i = 0; i < builder.getSubnetNum(); ++i) {
+    const auto &subnet1 = model::Subnet::get(builder.getSubnetID(i, point1));
+    const auto &subnet2 = model::Subnet::get(builder.getSubnetID(i, point2));
+    const auto result = areEquivalent(checker, subnet1, subnet2);
+
+    if (!result.equal()) {
+      return result;
+    }
+  }
+
+  return CheckerResult::EQUAL;
+}
+
+} // namespace eda::gate::debugger
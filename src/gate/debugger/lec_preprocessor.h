@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "gate/debugger/base_checker.h"
+
+#include <cstddef>
+#include <string>
+
+namespace eda::gate::debugger {
+
+/**
+ * \brief Structural preprocessing of the LEC miter.
+ *
+ * Both subnets are decomposed into the AIG basis and strashed into a shared
+ * graph: the two-input ANDs are hashed w/ the ordered inputs, the constants
+ * are propagated, and the trivial cases (x & x, x & ~x) are simplified. So
+ * the identical logic collapses even if the subnets differ in gate types.
+ * The output pairs w/ the same literal are proven structurally, while the
+ * pairs w/ the complementary literals are disproved. The duplicate pairs are
+ * dropped, and the remaining ones form the reduced miter restricted to their
+ * cones of influence.
+ *
+ * The cells w/ the subnet implementation are inlined; if there are other
+ * cells (e.g. the ones w/o implementation), the plain miter is constructed.
+ */
+class LecPreprocessor final {
+public:
+  using CellToCell = BaseChecker::CellToCell;
+
+  struct Stats final {
+    /// Number of the output pairs.
+    size_t nOut{0};
+    /// Number of the output pairs proven structurally.
+    size_t nProven{0};
+    /// Number of the output pairs disproved structurally.
+    size_t nDisproved{0};
+    /// Number of the duplicate output pairs.
+    size_t nDuplicates{0};
+  };
+
+  /**
+   * @brief Preprocesses the miter for the specified subnets.
+   * @param builder Builder for constructing the reduced miter.
+   * @param subnet1 First subnet.
+   * @param subnet2 Second subnet.
+   * @param mapping Mapping between the PI/PO of the specified subnets.
+   * @return EQUAL/NOTEQUAL if the subnets are checked structurally,
+   * UNKNOWN if the reduced miter is to be checked.
+   */
+  CheckerResult preprocess(model::SubnetBuilder &builder,
+                           const model::Subnet &subnet1,
+                           const model::Subnet &subnet2,
+                           const CellToCell &mapping);
+
+  /**
+   * @brief Checks the equivalence of the given subnets: the reduced miter
+   * is checked by the specified checker.
+   * @param checker Checker of the reduced miter.
+   * @param subnet1 First subnet.
+   * @param subnet2 Second subnet.
+   * @param mapping Mapping between the PI/PO of the specified subnets.
+   * @return Checking result.
+   */
+  CheckerResult areEquivalent(const BaseChecker &checker,
+                              const model::Subnet &subnet1,
+                              const model::Subnet &subnet2,
+                              const CellToCell &mapping);
+
+  /**
+   * @brief Checks the equivalence of the given subnets.
+   * @param checker Checker of the reduced miter.
+   * @param subnet1 First subnet.
+   * @param subnet2 Second subnet.
+   * @return Checking result.
+   */
+  CheckerResult areEquivalent(const BaseChecker &checker,
+                              const model::Subnet &subnet1,
+                              const model::Subnet &subnet2);
+
+  /**
+   * @brief Checks the equivalence of the given check points of the design.
+   * @param checker Checker of the reduced miters.
+   * @param builder Design builder.
+   * @param point1 Name of the first check point.
+   * @param point2 Name of the second check point.
+   * @return Checking result.
+   */
+  CheckerResult areEquivalent(const BaseChecker &checker,
+                              model::DesignBuilder &builder,
+                              const std::string &point1,
+                              const std::string &point2);
+
+  /// Returns the statistics accumulated over the preprocessed miters.
+  const Stats &getStats() const { return stats; }
+
+private:
+  Stats stats;
+};
+
+} // namespace eda::gate::debugger
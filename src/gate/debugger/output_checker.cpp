@@ -0,0 +1,230 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/debugger/output_checker.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+
+namespace eda::gate::debugger {
+
+using EntryID = model::EntryID;
+using Link = model::Subnet::Link;
+using LinkList = model::Subnet::LinkList;
+
+/// Collects the inner cells of the output cone (in topological order).
+static void collectCone(const model::Subnet &miter,
+                        const Link &root,
+                        std::vector<EntryID> &cone,
+                        std::vector<uint32_t> &marks,
+                        const uint32_t stamp) {
+  cone.clear();
+
+  std::vector<EntryID> stack{root.idx};
+  marks[root.idx] = stamp;
+
+  while (!stack.empty()) {
+    const auto i = stack.back();
+    stack.pop_back();
+
+    const auto &cell = miter.getCell(i);
+    if (cell.isIn()) {
+      continue;
+    }
+
+    cone.push_back(i);
+    for (uint16_t j = 0; j < cell.arity; ++j) {
+      const auto link = miter.getLink(i, j);
+      if (marks[link.idx] != stamp) {
+        marks[link.idx] = stamp;
+        stack.push_back(link.idx);
+      }
+    }
+  }
+
+  std::sort(cone.begin(), cone.end());
+}
+
+/// Returns the output value if it is constant by construction.
+static std::optional<bool> getConstValue(const model::Subnet &miter,
+                                         const Link &root) {
+  const auto &cell = miter.getCell(root.idx);
+  if (cell.isZero() || cell.isOne()) {
+    return cell.isOne() != static_cast<bool>(root.inv);
+  }
+
+  // XOR(x, x) or XOR(x, ~x): the output pair is shared by strashing.
+  if (cell.isXor() && cell.arity == 2) {
+    const auto lhs = miter.getLink(root.idx, 0);
+    const auto rhs = miter.getLink(root.idx, 1);
+    if (lhs.idx == rhs.idx && lhs.out == rhs.out) {
+      return (lhs.inv != rhs.inv) != static_cast<bool>(root.inv);
+    }
+  }
+
+  return std::nullopt;
+}
+
+/// Constructs the single-output subnet for the output cone.
+static model::SubnetID makeCone(const model::Subnet &miter,
+                                const Link &root,
+                                const std::vector<EntryID> &cone) {
+  // The cone keeps all the inputs to preserve the counterexample format.
+  model::SubnetBuilder builder;
+  const auto inputs = builder.addInputs(miter.getInNum());
+
+  std::unordered_map<EntryID, Link> map(cone.size());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    map[i] = inputs[i];
+  }
+
+  for (const auto i : cone) {
+    const auto &cell = miter.getCell(i);
+
+    LinkList links(cell.arity);
+    for (uint16_t j = 0; j < cell.arity; ++j) {
+      const auto link = miter.getLink(i, j);
+      links[j] = Link(map[link.idx].idx, link.out, link.inv);
+    }
+
+    map[i] = builder.addCell(cell.getTypeID(), links);
+  }
+
+  builder.addOutput(Link(map[root.idx].idx, root.out, root.inv));
+
+  // The subnet storage is not thread-safe.
+  static std::mutex mutex;
+  std::lock_guard<std::mutex> lock(mutex);
+  return builder.make();
+}
+
+OutputChecker::Result OutputChecker::isSat(const model::Subnet &miter) const {
+  const auto nOut = miter.getOutNum();
+  const auto &checker = BaseChecker::getChecker(settings.lec);
+
+  Result result;
+  result.outputs.assign(nOut, CheckerResult::UNKNOWN);
+
+  // The smaller cones are checked first (they are likely to fail faster).
+  std::vector<uint32_t> marks(miter.size(), 0);
+  std::vector<EntryID> cone;
+  std::vector<std::pair<size_t, size_t>> order(nOut);
+  for (size_t i = 0; i < nOut; ++i) {
+    collectCone(miter, miter.getOut(i), cone, marks, i + 1);
+    order[i] = {cone.size(), i};
+  }
+  std::sort(order.begin(), order.end());
+
+  std::atomic<size_t> next{0};
+  std::atomic<bool> stop{false};
+
+  // The i-th result is written to the i-th slot only.
+  auto worker = [&]() {
+    std::vector<uint32_t> marks(miter.size(), 0);
+    std::vector<EntryID> cone;
+
+    for (size_t k = next++; k < nOut && !stop; k = next++) {
+      const auto i = order[k].second;
+      const auto root = miter.getOut(i);
+
+      auto &output = result.outputs[i];
+      if (const auto value = getConstValue(miter, root)) {
+        output = *value
+            ? CheckerResult(CheckerResult::NOTEQUAL,
+                            std::vector<bool>(miter.getInNum(), false))
+            : CheckerResult(CheckerResult::EQUAL);
+      } else {
+        collectCone(miter, root, cone, marks, k + 1);
+        output = checker.isSat(makeCone(miter, root, cone));
+      }
+
+      if (output.notEqual() && settings.stopOnMismatch) {
+        stop = true;
+      }
+    }
+  };
+
+  const size_t nThreads = std::min<size_t>(nOut, settings.nThreads != 0
+      ? settings.nThreads : std::max(1u, std::thread::hardware_concurrency()));
+
+  if (nThreads <= 1) {
+    worker();
+  } else {
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads);
+    for (size_t i = 0; i < nThreads; ++i) {
+      threads.emplace_back(worker);
+    }
+    for (auto &thread : threads) {
+      thread.join();
+    }
+  }
+
+  // NOTEQUAL dominates ERROR, ERROR dominates UNKNOWN.
+  bool isError = false, isUnknown = false;
+  for (const auto &output : result.outputs) {
+    if (output.notEqual()) {
+      result.result = output;
+      return result;
+    }
+    isError |= output.isError();
+    isUnknown |= output.isUnknown();
+  }
+
+  result.result = isError
+      ? CheckerResult::ERROR
+      : (isUnknown ? CheckerResult::UNKNOWN : CheckerResult::EQUAL);
+  return result;
+}
+
+OutputChecker::Result OutputChecker::areEquivalent(
+    const model::Subnet &subnet1,
+    const model::Subnet &subnet2,
+    const CellToCell &mapping) const {
+  model::SubnetBuilder builder;
+  BaseChecker::makeOutputMiter(builder, subnet1, subnet2, mapping);
+  return isSat(model::Subnet::get(builder.make()));
+}
+
+OutputChecker::Result OutputChecker::areEquivalent(
+    const model::Subnet &subnet1,
+    const model::Subnet &subnet2) const {
+  model::SubnetBuilder builder;
+  BaseChecker::makeOutputMiter(builder, subnet1, subnet2);
+  return isSat(model::Subnet::get(builder.make()));
+}
+
+OutputChecker::Result OutputChecker::areEquivalent(
+    model::DesignBuilder &builder,
+    const std::string &point1,
+    const std::string &point2) const {
+  Result result{CheckerResult::EQUAL, {}};
+
+  for (size_t i = 0; i < builder.getSubnetNum(); ++i) {
+    const auto subnetID1 = builder.getSubnetID(i, point1);
+    const auto subnetID2 = builder.getSubnetID(i, point2);
+    const auto subnetResult = areEquivalent(subnetID1, subnetID2);
+
+    result.outputs.insert(result.outputs.end(),
+                          subnetResult.outputs.begin(),
+                          subnetResult.outputs.end());
+
+    if (!subnetResult.result.equal()) {
+      result.result = subnetResult.result;
+      break;
+    }
+  }
+
+  return result;
+}
+
+} // namespace eda::gate::debugger
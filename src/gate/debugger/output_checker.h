@@ -0,0 +1,111 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "gate/debugger/base_checker.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace eda::gate::debugger {
+
+/**
+ * \brief Checks the equivalence output-by-output.
+ *
+ * The subnets are combined into the multi-output miter (see
+ * BaseChecker::makeOutputMiter): the common logic is shared by structural
+ * hashing, and the i-th miter output is the XOR of the i-th output pair.
+ * Instead of OR-ing the XORs into a single SAT instance, each output cone is
+ * extracted and checked separately by the specified checker. The cones are
+ * checked in ascending order of their sizes by a pool of threads; the outputs
+ * driven by the constants or by XOR(x, x) are resolved w/o the checker.
+ */
+class OutputChecker final {
+public:
+  using CellToCell = BaseChecker::CellToCell;
+  using LecType = BaseChecker::LecType;
+
+  struct Settings final {
+    /// Checker applied to the output cones.
+    LecType lec{LecType::SAT};
+    /// Number of threads (0 stands for the hardware concurrency).
+    size_t nThreads{0};
+    /// Stops checking on the first unequal output.
+    bool stopOnMismatch{false};
+  };
+
+  struct Result final {
+    /// Overall result (the counterexample of the first unequal output).
+    CheckerResult result{CheckerResult::UNKNOWN};
+    /// Per-output results (UNKNOWN for the outputs skipped on stopping).
+    std::vector<CheckerResult> outputs;
+  };
+
+  OutputChecker(const Settings &settings): settings(settings) {}
+
+  OutputChecker(): OutputChecker(Settings{}) {}
+
+  /**
+   * @brief Checks if the outputs of the given miter are satisfiable.
+   * @param miter Multi-output miter.
+   * @return Per-output checking results.
+   */
+  Result isSat(const model::Subnet &miter) const;
+
+  /**
+   * @brief Checks the equivalence of the given subnets output-by-output.
+   * @param subnet1 First subnet.
+   * @param subnet2 Second subnet.
+   * @param mapping Mapping between the PI/PO of the specified subnets.
+   * @return Per-output checking results.
+   */
+  Result areEquivalent(const model::Subnet &subnet1,
+                       const model::Subnet &subnet2,
+                       const CellToCell &mapping) const;
+
+  /**
+   * @brief Checks the equivalence of the given subnets output-by-output.
+   * @param subnet1 First subnet.
+   * @param subnet2 Second subnet.
+   * @return Per-output checking results.
+   */
+  Result areEquivalent(const model::Subnet &subnet1,
+                       const model::Subnet &subnet2) const;
+
+  /**
+   * @brief Checks the equivalence of the given subnets output-by-output.
+   * @param subnetID1 Identifier of the first subnet.
+   * @param subnetID2 Identifier of the second subnet.
+   * @return Per-output checking results.
+   */
+  Result areEquivalent(const model::SubnetID subnetID1,
+                       const model::SubnetID subnetID2) const {
+    const auto &subnet1 = model::Subnet::get(subnetID1);
+    const auto &subnet2 = model::Subnet::get(subnetID2);
+    return areEquivalent(subnet1, subnet2);
+  }
+
+  /**
+   * @brief Checks the equivalence of the given check points of the design
+   * subnet-by-subnet (stops on the first unequal subnet).
+   * @param builder Design builder storing the check points.
+   * @param point1 Name of the first check point.
+   * @param point2 Name of the second check point.
+   * @return Per-output checking results (of all the checked subnets).
+   */
+  Result areEquivalent(model::DesignBuilder &builder,
+                       const std::string &point1,
+                       const std::string &point2) const;
+
+private:
+  const Settings settings;
+};
+
+} // namespace eda::gate::debugger
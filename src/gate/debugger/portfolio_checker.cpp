@@ -0,0 +1,106 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/debugger/bdd_checker.h"
+#include "gate/debugger/portfolio_checker.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+namespace eda::gate::debugger {
+
+using Clock = std::chrono::steady_clock;
+
+/// Checkers run by the portfolio.
+static const std::vector<BaseChecker::LecType> engines{
+  options::RND,
+  options::FRAIG,
+  options::SAT,
+  options::BDD
+};
+
+void PortfolioChecker::resetStats() {
+  std::lock_guard<std::mutex> lock(mutex);
+  stats.clear();
+  for (const auto lec : engines) {
+    stats.push_back(EngineStats{lec});
+  }
+}
+
+CheckerResult PortfolioChecker::isSat(const model::Subnet &subnet) const {
+  // The BDD checker is the last one and may be disabled.
+  const size_t nEngines = engines.size() - (bddNodeLimit == 0 ? 1 : 0);
+
+  const auto *outerStop = getStopFlag();
+  StopFlag stop{isStopped()};
+
+  std::mutex resultMutex;
+  std::condition_variable finished;
+
+  size_t nFinished = 0;
+  size_t winner = nEngines;
+  CheckerResult result = CheckerResult::UNKNOWN;
+  std::vector<double> times(nEngines);
+
+  auto worker = [&](const size_t i) {
+    setStopFlag(&stop);
+
+    const auto start = Clock::now();
+    const auto engineResult = (engines[i] == options::BDD)
+        ? BddChecker::get().isSat(subnet, bddNodeLimit)
+        : getChecker(engines[i]).isSat(subnet);
+    const std::chrono::duration<double> time = Clock::now() - start;
+
+    std::lock_guard<std::mutex> lock(resultMutex);
+    times[i] = time.count();
+
+    // The first definitive result cancels the other checkers.
+    const bool isDefinitive = engineResult.equal() || engineResult.notEqual();
+    if (winner == nEngines && isDefinitive) {
+      winner = i;
+      result = engineResult;
+      stop = true;
+    }
+
+    ++nFinished;
+    finished.notify_one();
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(nEngines);
+  for (size_t i = 0; i < nEngines; ++i) {
+    threads.emplace_back(worker, i);
+  }
+
+  {
+    // The cancellation of the portfolio itself is propagated to the checkers.
+    std::unique_lock<std::mutex> lock(resultMutex);
+    while (nFinished < nEngines) {
+      finished.wait_for(lock, std::chrono::milliseconds(10));
+      if (outerStop && outerStop->load(std::memory_order_relaxed)) {
+        stop = true;
+      }
+    }
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  for (size_t i = 0; i < nEngines; ++i) {
+    stats[i].nRuns++;
+    stats[i].nWins += (i == winner) ? 1 : 0;
+    stats[i].time += times[i];
+  }
+
+  return result;
+}
+
+} // namespace eda::gate::debugger
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "gate/debugger/base_checker.h"
+#include "util/singleton.h"
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+namespace eda::gate::debugger {
+
+/**
+ * \brief Checks the equivalence by running several checkers concurrently.
+ *
+ * The RND, FRAIG, SAT, and BDD (w/ the node limit) checkers are launched in
+ * separate threads on the same miter. The first definitive result (EQUAL or
+ * NOTEQUAL) is returned, while the other checkers are cancelled via the stop
+ * flag (see BaseChecker::setStopFlag). If no checker succeeds, the result is
+ * UNKNOWN. The run counts and times of the checkers are accumulated.
+ */
+class PortfolioChecker final : public BaseChecker,
+                               public util::Singleton<PortfolioChecker> {
+  friend class util::Singleton<PortfolioChecker>;
+
+public:
+  struct EngineStats final {
+    /// Checker type.
+    LecType lec;
+    /// Number of the runs.
+    size_t nRuns{0};
+    /// Number of the runs returned first w/ the definitive result.
+    size_t nWins{0};
+    /// Total run time in seconds (incl. the cancelled runs).
+    double time{0.0};
+  };
+
+  /// Default maximum number of live BDD nodes.
+  static constexpr unsigned DefaultBddNodeLimit = 1000000;
+
+  /// @copydoc BaseChecker::isSat
+  CheckerResult isSat(const model::Subnet &subnet) const override;
+
+  /// Sets the maximum number of live BDD nodes (0 disables the BDD checker).
+  void setBddNodeLimit(unsigned bddNodeLimit) {
+    this->bddNodeLimit = bddNodeLimit;
+  }
+
+  /// Returns the statistics accumulated over the runs.
+  std::vector<EngineStats> getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+  }
+
+  /// Resets the accumulated statistics.
+  void resetStats();
+
+private:
+  PortfolioChecker() { resetStats(); }
+
+  unsigned bddNodeLimit{DefaultBddNodeLimit};
+
+  mutable std::mutex mutex;
+  mutable std::vector<EngineStats> stats;
+};
+
+} // namespace eda::gate::debugger
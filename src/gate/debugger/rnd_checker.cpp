@@ -9,28 +9,44 @@
 #include "gate/debugger/rnd_checker.h"
 #include "util/logging.h"
 
+#include <algorithm>
+#include <atomic>
 #include <bitset>
 #include <cassert>
-#include <cmath>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
 
 namespace eda::gate::debugger {
 
-simulator::Simulator::DataVector getAllValues(size_t nIn, size_t count) {
-  size_t startValue = count * 64;
-  std::vector<std::bitset<64>> vec(nIn);
-  for (size_t i = startValue; i < startValue + 64; i++) {
-    std::bitset<64> current(i);
-    for (size_t j = 0; j < vec.size(); j++) {
-      if (current.test(j)) {
-        vec[j].set(i - startValue);
-      }
-    }
+using DataVector = simulator::Simulator::DataVector;
+
+/// Values of the low 6 inputs in a 64-pattern block.
+static constexpr uint64_t InMasks[] = {
+  0xaaaaaaaaaaaaaaaaull,
+  0xccccccccccccccccull,
+  0xf0f0f0f0f0f0f0f0ull,
+  0xff00ff00ff00ff00ull,
+  0xffff0000ffff0000ull,
+  0xffffffff00000000ull
+};
+
+/// Sets the values of the high inputs (the block counter).
+static void setBlockValues(DataVector &values, const uint64_t block) {
+  for (size_t i = 6; i < values.size(); ++i) {
+    values[i] = ((block >> (i - 6)) & 1) ? ~0ull : 0ull;
   }
-  simulator::Simulator::DataVector res;
-  for (size_t k = 0; k < vec.size(); k++) {
-    res.push_back(vec[k].to_ullong());
+}
+
+DataVector getAllValues(size_t nIn, size_t count) {
+  DataVector values(nIn);
+  for (size_t i = 0; i < nIn && i < 6; ++i) {
+    values[i] = InMasks[i];
   }
-  return res;
+  setBlockValues(values, count);
+  return values;
 }
 
 std::vector<bool> getCounterEx(const std::bitset<64> output,
@@ -50,49 +66,104 @@ std::vector<bool> getCounterEx(const std::bitset<64> output,
 
 CheckerResult RndChecker::isSat(const model::Subnet &subnet) const {
   assert(subnet.getOutNum() == 1);
+  return exhaustive ? checkExhaustive(subnet) : checkRandom(subnet);
+}
 
-  const auto inputNum = subnet.getInNum();
+CheckerResult RndChecker::checkRandom(const model::Subnet &subnet) const {
+  const auto nIn = subnet.getInNum();
 
   auto builder = std::make_shared<model::SubnetBuilder>(subnet);
   simulator::Simulator simulator(builder);
-  simulator::Simulator::DataVector values(inputNum);
+  DataVector values(nIn);
+
+  std::mt19937_64 generator(seed);
+  for (size_t t = 0; t < tries && !isStopped(); t++) {
+    for (size_t i = 0; i < nIn; i++) {
+      values[i] = generator();
+    }
+    simulator.simulate(values);
+    const std::bitset<64> output = simulator.getOutput(0);
+    if (output.any()) {
+      return CheckerResult(CheckerResult::NOTEQUAL,
+                           getCounterEx(output, values));
+    }
+  }
+  return CheckerResult::UNKNOWN;
+}
+
+CheckerResult RndChecker::checkExhaustive(const model::Subnet &subnet) const {
+  const auto nIn = subnet.getInNum();
 
-  if (!exhaustive) {
-    for (size_t t = 0; t < tries; t++) {
-      for (size_t i = 0; i < inputNum; i++) {
-        values[i] = std::rand();
+  if (nIn > MaxExhaustiveInNum) {
+    LOG_ERROR << "Unsupported number of inputs: " << nIn << std::endl;
+    return CheckerResult::ERROR;
+  }
+
+  const uint64_t nBlocks = (nIn > 6) ? (1ull << (nIn - 6)) : 1;
+  const size_t nWorkers = std::min<uint64_t>(nBlocks, nThreads != 0
+      ? nThreads : std::max(1u, std::thread::hardware_concurrency()));
+
+  std::atomic<bool> isFound{false};
+  std::atomic<bool> isCancelled{false};
+  std::mutex mutex;
+  std::vector<bool> counterEx;
+
+  // The workers inherit the stop flag of the calling thread.
+  const auto *stopFlag = getStopFlag();
+
+  // Each worker simulates the disjoint range of blocks.
+  auto worker = [&](simulator::Simulator &simulator,
+                    const uint64_t begin,
+                    const uint64_t end) {
+    setStopFlag(stopFlag);
+    auto values = getAllValues(nIn, begin);
+    for (auto block = begin; block < end && !isFound; ++block) {
+      if (isStopped()) {
+        isCancelled = true;
+        return;
       }
+      setBlockValues(values, block);
       simulator.simulate(values);
+
       const std::bitset<64> output = simulator.getOutput(0);
       if (output.any()) {
-        return CheckerResult(CheckerResult::NOTEQUAL,
-                             getCounterEx(output, values));
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!isFound) {
+          counterEx = getCounterEx(output, values);
+          isFound = true;
+        }
+        return;
       }
     }
-    return CheckerResult::UNKNOWN;
+  };
+
+  // Each worker has its own simulator (the simulator state is mutable).
+  std::vector<std::unique_ptr<simulator::Simulator>> simulators;
+  for (size_t i = 0; i < nWorkers; ++i) {
+    auto builder = std::make_shared<model::SubnetBuilder>(subnet);
+    simulators.push_back(std::make_unique<simulator::Simulator>(builder));
   }
 
-  if (exhaustive) {
-    if (inputNum > 32) {
-      LOG_ERROR << "Unsupported number of inputs: " << inputNum << std::endl;
-      return CheckerResult::ERROR;
+  const auto range = (nBlocks + nWorkers - 1) / nWorkers;
+  if (nWorkers == 1) {
+    worker(*simulators[0], 0, nBlocks);
+  } else {
+    std::vector<std::thread> threads;
+    threads.reserve(nWorkers);
+    for (size_t i = 0; i < nWorkers; ++i) {
+      const auto begin = i * range;
+      const auto end = std::min(begin + range, nBlocks);
+      threads.emplace_back(worker, std::ref(*simulators[i]), begin, end);
     }
-
-    const auto inputPower = (1ull << inputNum);
-
-    size_t iterations = (inputPower <= 64) ? 1ull : (inputPower >> 6);
-    for (size_t i = 0; i < iterations; i++) {
-      simulator.simulate(getAllValues(inputNum, i));
-      const std::bitset<64> output = simulator.getOutput(0);
-      if (output.any()) {
-        return CheckerResult(CheckerResult::NOTEQUAL,
-                             getCounterEx(output, values));
-      }
+    for (auto &thread : threads) {
+      thread.join();
     }
-    return CheckerResult::EQUAL;
   }
 
-  return CheckerResult::ERROR;
+  if (isFound) {
+    return CheckerResult(CheckerResult::NOTEQUAL, counterEx);
+  }
+  return isCancelled ? CheckerResult::UNKNOWN : CheckerResult::EQUAL;
 }
 
 } // namespace eda::gate::debugger
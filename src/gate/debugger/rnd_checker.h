@@ -12,16 +12,35 @@
 #include "gate/model/subnet.h"
 #include "gate/simulator/simulator.h"
 
+#include <cstddef>
+#include <cstdint>
+
 namespace eda::gate::debugger {
 
+/**
+ * @brief Returns the input words for the given block of 64 input patterns
+ * (the bit-sliced counter: the i-th input of the p-th pattern is the i-th bit
+ * of (count * 64 + p)).
+ */
 simulator::Simulator::DataVector getAllValues(size_t nIn, size_t count);
 
-/// Checks the equivalence of the specified nets using simulation.
+/**
+ * \brief Checks the equivalence of the specified nets using simulation.
+ *
+ * In the exhaustive mode, the input patterns are enumerated by the bit-sliced
+ * counter: the low 6 inputs take the constant masks, while the others are
+ * constant within a 64-pattern block and are counted at the word level. The
+ * blocks are split into disjoint ranges simulated by a pool of threads. In
+ * the random mode, the input words are generated by a 64-bit PRNG.
+ */
 class RndChecker final : public BaseChecker,
                          public util::Singleton<RndChecker> {
   friend class util::Singleton<RndChecker>;
 
 public:
+  /// Maximum number of inputs allowed in the exhaustive mode.
+  static constexpr size_t MaxExhaustiveInNum = 40;
+
   /// @copydoc BaseChecker::isSat
   CheckerResult isSat(const model::Subnet &subnet) const override;
 
@@ -35,6 +54,12 @@ public:
    */
   void setExhaustive(bool exhaustive) { this->exhaustive = exhaustive; }
 
+  /// Sets the number of threads (0 stands for the hardware concurrency).
+  void setThreads(size_t nThreads) { this->nThreads = nThreads; }
+
+  /// Sets the seed of the random values.
+  void setSeed(uint64_t seed) { this->seed = seed; }
+
 private:
   RndChecker(bool exhaustive, unsigned tries) {
     this->exhaustive = exhaustive;
@@ -43,8 +68,13 @@ private:
 
   RndChecker(): RndChecker(false, 1024) {}
 
+  CheckerResult checkRandom(const model::Subnet &subnet) const;
+  CheckerResult checkExhaustive(const model::Subnet &subnet) const;
+
   unsigned tries;
   bool exhaustive;
+  size_t nThreads{0};
+  uint64_t seed{0};
 };
 
 } // namespace eda::gate::debugger
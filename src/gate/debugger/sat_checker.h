@@ -12,6 +12,7 @@
 #include "gate/model/utils/subnet_cnf_encoder.h"
 
 #include <cassert>
+#include <cstdint>
 #include <vector>
 
 namespace eda::gate::debugger {
@@ -21,6 +22,9 @@ class SatChecker final : public BaseChecker,
   friend class util::Singleton<SatChecker>;
 
 public:
+  /// Number of conflicts between polling the stop flag.
+  static constexpr uint64_t StopPollConflicts = 10000;
+
   /// @copydoc BaseChecker::isSat
   CheckerResult isSat(const model::Subnet &subnet) const override {
     assert(subnet.getOutNum() == 1 && "Miter w/ multiple outputs");
@@ -28,14 +32,28 @@ public:
     solver::Solver solver;
     model::SubnetEncoderContext context(subnet, solver);
 
+    // Only the output cone is encoded (the dangling cells are skipped).
     const auto &encoder = model::SubnetEncoder::get();
-    encoder.encode(subnet, context, solver);
+    encoder.encode(subnet, {0}, context, solver);
     solver.addClause(context.lit(subnet.getOut(0), 1));
 
-    if (solver.solve()) {
+    // The solving is split into the budgeted runs to poll the stop flag.
+    auto status = Minisat::l_Undef;
+    if (!getStopFlag()) {
+      status = solver.solve() ? Minisat::l_True : Minisat::l_False;
+    }
+    while (status == Minisat::l_Undef && !isStopped()) {
+      status = solver.solveLimited(solver::Clause(), StopPollConflicts);
+    }
+
+    if (status == Minisat::l_Undef) {
+      return CheckerResult::UNKNOWN;
+    }
+    if (status == Minisat::l_True) {
       std::vector<bool> counterExample;
       for (size_t i = 0; i < subnet.getInNum(); ++i) {
-        counterExample.push_back(solver.value(context.var(i, 0)));
+        // The encoder represents the true value by the negative literal.
+        counterExample.push_back(!solver.value(context.var(i, 0)));
       }
       return CheckerResult(CheckerResult::NOTEQUAL, counterExample);
     }
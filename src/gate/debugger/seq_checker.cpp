@@ -0,0 +1,228 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/debugger/seq_checker.h"
+#include "gate/model/utils/subnet_cnf_encoder.h"
+
+#include <cassert>
+
+namespace eda::gate::debugger {
+
+using Link = model::Subnet::Link;
+using LinkList = model::Subnet::LinkList;
+using Literal = solver::Literal;
+using Solver = solver::Solver;
+
+SeqCircuit SeqChecker::makeMiter(const SeqCircuit &circuit1,
+                                 const SeqCircuit &circuit2) {
+  const auto &subnet1 = model::Subnet::get(circuit1.subnetID);
+  const auto &subnet2 = model::Subnet::get(circuit2.subnetID);
+
+  const size_t nIn = subnet1.getInNum() - circuit1.nState;
+  const size_t nOut = subnet1.getOutNum() - circuit1.nState;
+  assert(nIn == subnet2.getInNum() - circuit2.nState);
+  assert(nOut == subnet2.getOutNum() - circuit2.nState);
+  assert(nOut > 0);
+
+  // Inputs: the primary inputs, the first state, and the second state.
+  model::SubnetBuilder builder;
+  const auto inputs = builder.addInputs(nIn);
+  const auto state1 = builder.addInputs(circuit1.nState);
+  const auto state2 = builder.addInputs(circuit2.nState);
+
+  LinkList links1(inputs), links2(inputs);
+  links1.insert(links1.end(), state1.begin(), state1.end());
+  links2.insert(links2.end(), state2.begin(), state2.end());
+
+  const auto outputs1 = builder.addSubnet(subnet1, links1);
+  const auto outputs2 = builder.addSubnet(subnet2, links2);
+
+  // Outputs: the mismatch, the first next state, and the second next state.
+  LinkList xors(nOut);
+  for (size_t i = 0; i < nOut; ++i) {
+    xors[i] = builder.addCell(model::XOR, outputs1[i], outputs2[i]);
+  }
+  builder.addOutput(xors.size() == 1
+      ? xors[0] : builder.addCellTree(model::OR, xors, 2));
+
+  for (size_t i = nOut; i < outputs1.size(); ++i) {
+    builder.addOutput(outputs1[i]);
+  }
+  for (size_t i = nOut; i < outputs2.size(); ++i) {
+    builder.addOutput(outputs2[i]);
+  }
+
+  SeqCircuit miter;
+  miter.subnetID = builder.make();
+  miter.nState = circuit1.nState + circuit2.nState;
+  miter.init.resize(miter.nState, false);
+
+  for (size_t i = 0; i < circuit1.init.size(); ++i) {
+    miter.init[i] = circuit1.init[i];
+  }
+  for (size_t i = 0; i < circuit2.init.size(); ++i) {
+    miter.init[circuit1.nState + i] = circuit2.init[i];
+  }
+
+  return miter;
+}
+
+namespace {
+
+/// Time frame of the unrolled circuit.
+struct Frame final {
+  /// Primary inputs.
+  std::vector<Literal> inputs;
+  /// Current state.
+  std::vector<Literal> state;
+  /// Next state.
+  std::vector<Literal> next;
+  /// Mismatch output.
+  Literal bad;
+};
+
+/// Incrementally unrolled circuit.
+class Unrolling final {
+public:
+  Unrolling(const model::Subnet &subnet, const size_t nState):
+      subnet(subnet), nState(nState) {}
+
+  /// Adds the frame connected to the previous one (if exists).
+  void addFrame() {
+    model::SubnetEncoderContext context(subnet, solver);
+    model::SubnetEncoder::get().encode(subnet, context, solver);
+
+    // The encoder represents the true value by the negative literal.
+    const size_t nIn = subnet.getInNum() - nState;
+    const size_t out = subnet.size() - subnet.getOutNum();
+
+    Frame frame;
+    for (size_t i = 0; i < nIn; ++i) {
+      frame.inputs.push_back(context.lit(i, 0, 1));
+    }
+    for (size_t i = 0; i < nState; ++i) {
+      frame.state.push_back(context.lit(nIn + i, 0, 1));
+      frame.next.push_back(context.lit(out + 1 + i, 0, 1));
+    }
+    frame.bad = context.lit(out, 0, 1);
+
+    if (!frames.empty()) {
+      const auto &prev = frames.back();
+      for (size_t i = 0; i < nState; ++i) {
+        solver.encodeBuf(frame.state[i], prev.next[i]);
+      }
+    }
+
+    frames.push_back(std::move(frame));
+  }
+
+  /// Constrains the state of the first frame.
+  void setInit(const std::vector<bool> &init) {
+    for (size_t i = 0; i < nState; ++i) {
+      solver.addClause(init[i] ? frames[0].state[i] : ~frames[0].state[i]);
+    }
+  }
+
+  /// Requires the state of the last frame to differ from the previous ones.
+  void addSimplePath() {
+    const auto &last = frames.back();
+    for (size_t k = 0; k + 1 < frames.size(); ++k) {
+      solver::Clause clause;
+      for (size_t i = 0; i < nState; ++i) {
+        // d <=> (s_k[i] != s_last[i]).
+        const auto diff = solver.newLit();
+        solver.encodeXor(diff, frames[k].state[i], last.state[i]);
+        clause.push(diff);
+      }
+      solver.addClause(clause);
+    }
+  }
+
+  /// Checks if the mismatch of the last frame is satisfiable.
+  bool isBad() {
+    solver::Clause assumptions;
+    assumptions.push(frames.back().bad);
+    return solver.solve(assumptions);
+  }
+
+  /// Requires the last frame to match.
+  void setGood() {
+    solver.addClause(~frames.back().bad);
+  }
+
+  /// Returns the primary input values (if the formula is SAT).
+  std::vector<std::vector<bool>> getTrace() {
+    std::vector<std::vector<bool>> trace(frames.size());
+    for (size_t k = 0; k < frames.size(); ++k) {
+      for (const auto lit : frames[k].inputs) {
+        trace[k].push_back(value(lit));
+      }
+    }
+    return trace;
+  }
+
+private:
+  bool value(const Literal lit) {
+    return solver.value(Minisat::var(lit)) != Minisat::sign(lit);
+  }
+
+  const model::Subnet &subnet;
+  const size_t nState;
+
+  Solver solver;
+  std::vector<Frame> frames;
+};
+
+} // namespace
+
+SeqChecker::Result SeqChecker::isSat(const SeqCircuit &miter) const {
+  const auto &subnet = model::Subnet::get(miter.subnetID);
+  assert(subnet.getOutNum() == miter.nState + 1);
+
+  std::vector<bool> init(miter.init);
+  init.resize(miter.nState, false);
+
+  Unrolling base(subnet, miter.nState);
+  Unrolling step(subnet, miter.nState);
+
+  Result result;
+  for (size_t k = 0; k < settings.maxDepth; ++k) {
+    result.depth = k + 1;
+
+    // Base case: the mismatch is reachable in k steps.
+    base.addFrame();
+    if (k == 0) {
+      base.setInit(init);
+    }
+    if (base.isBad()) {
+      result.result = CheckerResult::NOTEQUAL;
+      result.trace = base.getTrace();
+      return result;
+    }
+    base.setGood();
+
+    if (!settings.induction) {
+      continue;
+    }
+
+    // Induction step: k matching frames imply the matching (k+1)-th one.
+    step.addFrame();
+    if (settings.simplePath) {
+      step.addSimplePath();
+    }
+    if (!step.isBad()) {
+      result.result = CheckerResult::EQUAL;
+      return result;
+    }
+    step.setGood();
+  }
+
+  return result;
+}
+
+} // namespace eda::gate::debugger
@@ -0,0 +1,105 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "gate/debugger/base_checker.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace eda::gate::debugger {
+
+/**
+ * \brief Sequential circuit: the combinational logic w/ the state elements.
+ *
+ * The last nState inputs of the subnet are the current state (the flip-flop
+ * outputs), while the last nState outputs are the next state (the flip-flop
+ * inputs). The other inputs/outputs are the primary ones.
+ */
+struct SeqCircuit final {
+  /// Combinational logic.
+  model::SubnetID subnetID;
+  /// Number of the state elements.
+  size_t nState{0};
+  /// Initial state (all zeros if empty).
+  std::vector<bool> init;
+};
+
+/**
+ * \brief Checks the sequential equivalence of the circuits.
+ *
+ * The circuits are combined into the product machine whose output is the
+ * disjunction of the XORs of the corresponding primary outputs. The bounded
+ * model checking (BMC) unrolls the product machine frame-by-frame from the
+ * initial state in a single incremental solver: the mismatch of the k-th
+ * frame is checked under the assumption, and, if it is unsatisfiable, it is
+ * added as a lemma for the next frames. The k-induction step uses another
+ * incremental solver: the unrolling starts from an arbitrary state, the
+ * first k frames are constrained to match, and the states are required to
+ * be pairwise distinct (simple path). If the mismatch of the (k+1)-th frame
+ * is unsatisfiable, the circuits are proven equivalent. The base and step
+ * solvers are interleaved frame-by-frame in the same thread.
+ */
+class SeqChecker final {
+public:
+  struct Settings final {
+    /// Maximum number of the unrolled frames.
+    size_t maxDepth{20};
+    /// Enables the k-induction step.
+    bool induction{true};
+    /// Enables the simple path constraints in the induction step.
+    bool simplePath{true};
+  };
+
+  struct Result final {
+    /// EQUAL if proven by induction, NOTEQUAL if the trace is found,
+    /// UNKNOWN if the maximum depth is reached.
+    CheckerResult result{CheckerResult::UNKNOWN};
+    /// Number of the unrolled frames.
+    size_t depth{0};
+    /// Primary input values for each frame of the counterexample trace.
+    std::vector<std::vector<bool>> trace;
+  };
+
+  SeqChecker(const Settings &settings): settings(settings) {}
+
+  SeqChecker(): SeqChecker(Settings{}) {}
+
+  /**
+   * @brief Constructs the product machine of the given circuits.
+   * @param circuit1 First circuit.
+   * @param circuit2 Second circuit.
+   * @return Sequential circuit w/ the single primary output (mismatch).
+   */
+  static SeqCircuit makeMiter(const SeqCircuit &circuit1,
+                              const SeqCircuit &circuit2);
+
+  /**
+   * @brief Checks if the output of the given product machine is reachable.
+   * @param miter Product machine w/ the single primary output.
+   * @return Checking result.
+   */
+  Result isSat(const SeqCircuit &miter) const;
+
+  /**
+   * @brief Checks the sequential equivalence of the given circuits.
+   * @param circuit1 First circuit.
+   * @param circuit2 Second circuit.
+   * @return Checking result.
+   */
+  Result areEquivalent(const SeqCircuit &circuit1,
+                       const SeqCircuit &circuit2) const {
+    return isSat(makeMiter(circuit1, circuit2));
+  }
+
+private:
+  const Settings settings;
+};
+
+} // namespace eda::gate::debugger
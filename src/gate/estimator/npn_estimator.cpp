@@ -10,6 +10,7 @@
 #include "gate/model/subnetview.h"
 #include "gate/optimizer/cut_extractor.h"
 #include "gate/optimizer/safe_passer.h"
+#include "util/npn_canonization.h"
 
 namespace eda::gate::estimator {
 
@@ -45,7 +46,7 @@ void NpnEstimator::estimate(const SubnetBuilderPtr &builder,
       auto tt = cone.evaluateTruthTable();
       auto ttk = nVars < k ? kitty::extend_to(tt, k) : tt;
 
-      const auto config = kitty::exact_npn_canonization(ttk);
+      const auto config = util::npnCanonization(ttk);
       ttk = util::getTT(config);
 
       if (result.find(ttk) == result.end()) {
@@ -10,13 +10,13 @@
 
 #include "gate/criterion/criterion.h"
 #include "gate/estimator/simple_time_model.h"
+#include "gate/estimator/timing_analyzer.h"
 #include "gate/library/library.h"
 #include "gate/model/subnet.h"
 #include "gate/techmapper/subnet_techmapper_base.h"
 
 #include <algorithm>
 #include <cfloat>
-#include <unordered_map>
 
 namespace eda::gate::estimator {
 
@@ -105,40 +105,9 @@ inline double getDelay(const library::StandardCell &cell,
 
 inline double getArrivalTime(model::SubnetID subnetID,
                              const library::SCLibrary &library) {
-  std::unordered_map<uint64_t, double> arrivalMap, delayMap;
-
-  double maxArrivalTime = 0;
-  // TODO: properly check that deafult wlm is set
-  const library::WireLoadModel *wlm = library.getProperties().defaultWLM;
-
-  auto entries = model::Subnet::get(subnetID).getEntries();
-  for (uint64_t i = 0; i < entries.size(); i += 1 + entries[i].cell.more) {
-    if (shouldSkipCell(entries[i].cell)) {
-      continue;
-    }
-    double delay = 0, arrival = 0;
-    for (const auto& link : entries[i].cell.link) {
-      if (delayMap.count(link.idx)) {
-        delay = std::max(delay, delayMap[link.idx]);
-        arrival = std::max(arrival, arrivalMap[link.idx]);
-      }
-    }
-    const auto *cellPtr = library.getCellPtr(entries[i].cell.getTypeID());
-    assert(cellPtr != nullptr);
-
-    size_t fanout = entries[i].cell.getOutNum();
-    
-    /// TODO: can do proper calculations instead of estimation
-    double fanoutCap = getEstimatedOutCapacitance(*cellPtr, wlm, fanout);
-    auto estimatedSD = NLDM::cellOutputSDEstimation(*cellPtr, delay,
-                                                      fanoutCap);
-
-    arrivalMap[i] = estimatedSD.slew + arrival;
-    delayMap[i] = estimatedSD.delay + delay;
-
-    maxArrivalTime = std::max(maxArrivalTime, delayMap[i]);
-  }
-  return maxArrivalTime;
+  model::SubnetBuilder builder(subnetID);
+  TimingAnalyzer analyzer(builder, library);
+  return analyzer.getDelay();
 }
 
 inline criterion::CostVector getPPA(
@@ -126,6 +126,16 @@ NLDM::EstimatedSD NLDM::cellOutputSDEstimation(
   NLDM::EstimatedSD estimatedSDC {0.0, 0.0};
 
   for (const auto &pin : cell.outputPins) {
+    if (pin.timingArcs.size() == pin.delayFall.size()) {
+      // Fast path: the LUTs are compiled on library load.
+      for (const auto &arc : pin.timingArcs) {
+        const auto value = arc.getValue(inputTransTime, outputTotalCap);
+        estimatedSDC.delay = std::max(estimatedSDC.delay, value.delay);
+        estimatedSDC.slew = std::max(estimatedSDC.slew, value.slew);
+      }
+      continue;
+    }
+
     size_t timingArcNum = pin.delayFall.size();
     for (size_t i = 0; i < timingArcNum; ++i) {
       //TODO: properly handle LUTs with other sizes
@@ -0,0 +1,487 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/estimator/timing_analyzer.h"
+
+#include <functional>
+#include <iomanip>
+#include <queue>
+#include <utility>
+
+namespace eda::gate::estimator {
+
+using Unateness = library::Unateness;
+
+TimingAnalyzer::TimingAnalyzer(SubnetBuilder &builder,
+                               const library::SCLibrary &library,
+                               const Settings &settings):
+    builder(builder),
+    library(library),
+    settings(settings),
+    wlm(settings.wlm ? settings.wlm : library.getProperties().defaultWLM),
+    linkBuffer(SubnetBuilder::Cell::MaxArity),
+    fanoutLinkBuffer(SubnetBuilder::Cell::MaxArity) {
+  if (wlm && wlm->wireLength.empty()) {
+    wlm = nullptr;
+  }
+  if (!builder.areFanoutsEnabled()) {
+    builder.enableFanouts();
+  }
+  analyze();
+}
+
+void TimingAnalyzer::resize() {
+  const size_t size = builder.getMaxIdx() + 1;
+  if (arrival.size() >= size) {
+    return;
+  }
+
+  arrival.resize(size);
+  slew.resize(size);
+  tail.resize(size, RiseFall{NoArc, NoArc});
+  load.resize(size, 0.);
+  arcOffset.resize(size, 0);
+  arcNum.resize(size, 0);
+  refcount.resize(size, 0);
+}
+
+void TimingAnalyzer::allocArcs(EntryID entryID) {
+  const auto arity = builder.getCell(entryID).arity;
+  if (arcNum[entryID] != arity) {
+    arcOffset[entryID] = arcs.size();
+    arcNum[entryID] = arity;
+    arcs.resize(arcs.size() + arity);
+  }
+}
+
+void TimingAnalyzer::analyze() {
+  arrival.clear();
+  slew.clear();
+  tail.clear();
+  load.clear();
+  arcOffset.clear();
+  arcNum.clear();
+  arcs.clear();
+  refcount.clear();
+  changed.clear();
+  outputs.clear();
+
+  resize();
+
+  std::vector<EntryID> order;
+  order.reserve(builder.getCellNum());
+
+  for (auto it = builder.begin(); it != builder.end(); it.nextCell()) {
+    const auto entryID = *it;
+    order.push_back(entryID);
+    if (builder.getCell(entryID).isOut()) {
+      outputs.push_back(entryID);
+    }
+    allocArcs(entryID);
+    evaluate(entryID);
+  }
+
+  computeDelay();
+
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    tail[*it] = evaluateTail(*it);
+  }
+}
+
+void TimingAnalyzer::markChanged(EntryID entryID) {
+  changed.push_back(entryID);
+}
+
+void TimingAnalyzer::collectAffected(EntryID entryID,
+                                     std::vector<bool> &visited,
+                                     std::vector<EntryID> &affected) {
+  // The old fanins lose the fanout (they are stored in the arcs).
+  for (uint16_t j = 0; j < arcNum[entryID]; ++j) {
+    const auto sourceID = getArcs(entryID)[j].source;
+    if (visited[sourceID]) {
+      continue;
+    }
+    visited[sourceID] = true;
+
+    if (!isValid(sourceID)) {
+      // The cell has been deleted: its fanins lose the fanout.
+      collectAffected(sourceID, visited, affected);
+      arcNum[sourceID] = 0;
+    } else if (builder.getCell(sourceID).refcount != refcount[sourceID]) {
+      affected.push_back(sourceID);
+    }
+  }
+}
+
+void TimingAnalyzer::update() {
+  if (changed.empty()) {
+    return;
+  }
+
+  resize();
+
+  const size_t size = arrival.size();
+  std::vector<bool> visited(size, false);
+  std::vector<EntryID> affected;
+
+  // The changed entries, their old fanins, and their new fanins.
+  for (const auto entryID : changed) {
+    visited[entryID] = true;
+  }
+  for (const auto entryID : changed) {
+    collectAffected(entryID, visited, affected);
+    if (!isValid(entryID)) {
+      arcNum[entryID] = 0;
+      continue;
+    }
+    affected.push_back(entryID);
+
+    uint16_t nLinks;
+    const auto *links = getLinks(entryID, nLinks);
+    for (uint16_t j = 0; j < nLinks; ++j) {
+      affected.push_back(links[j].idx);
+    }
+  }
+  changed.clear();
+
+  using QueueItem = std::pair<model::SubnetDepth, EntryID>;
+  std::vector<bool> queued(size, false);
+
+  // Forward propagation (in the topological order).
+  std::priority_queue<QueueItem, std::vector<QueueItem>,
+                      std::greater<QueueItem>> forward;
+  for (const auto entryID : affected) {
+    if (!queued[entryID]) {
+      queued[entryID] = true;
+      forward.emplace(builder.getDepth(entryID), entryID);
+    }
+  }
+
+  std::vector<EntryID> evaluated;
+  while (!forward.empty()) {
+    const auto entryID = forward.top().second;
+    forward.pop();
+    queued[entryID] = false;
+
+    const auto oldArrival = arrival[entryID];
+    const auto oldSlew = slew[entryID];
+
+    allocArcs(entryID);
+    evaluate(entryID);
+    evaluated.push_back(entryID);
+
+    if (arrival[entryID] == oldArrival && slew[entryID] == oldSlew) {
+      continue;
+    }
+    for (const auto fanoutID : builder.getFanouts(entryID)) {
+      if (!queued[fanoutID]) {
+        queued[fanoutID] = true;
+        forward.emplace(builder.getDepth(fanoutID), fanoutID);
+      }
+    }
+  }
+
+  computeDelay();
+
+  // Backward propagation (in the reverse topological order).
+  std::priority_queue<QueueItem> backward;
+  const auto enqueue = [&](EntryID entryID) {
+    if (!queued[entryID]) {
+      queued[entryID] = true;
+      backward.emplace(builder.getDepth(entryID), entryID);
+    }
+  };
+
+  for (const auto entryID : evaluated) {
+    enqueue(entryID);
+    uint16_t nLinks;
+    const auto *links = getLinks(entryID, nLinks);
+    for (uint16_t j = 0; j < nLinks; ++j) {
+      enqueue(links[j].idx);
+    }
+  }
+
+  while (!backward.empty()) {
+    const auto entryID = backward.top().second;
+    backward.pop();
+    queued[entryID] = false;
+
+    const auto newTail = evaluateTail(entryID);
+    if (newTail == tail[entryID]) {
+      continue;
+    }
+    tail[entryID] = newTail;
+
+    uint16_t nLinks;
+    const auto *links = getLinks(entryID, nLinks);
+    for (uint16_t j = 0; j < nLinks; ++j) {
+      enqueue(links[j].idx);
+    }
+  }
+}
+
+double TimingAnalyzer::computeLoad(EntryID entryID, uint16_t output) const {
+  if (!builder.getCell(entryID).refcount) {
+    return 0.;
+  }
+
+  auto fanouts = builder.getFanouts(entryID);
+  std::sort(fanouts.begin(), fanouts.end());
+  fanouts.erase(std::unique(fanouts.begin(), fanouts.end()), fanouts.end());
+
+  double capacitance = 0.;
+  size_t fanout = 0;
+
+  for (const auto fanoutID : fanouts) {
+    const auto &fanoutCell = builder.getCell(fanoutID);
+    const auto *libCell = library.getCellPtr(fanoutCell.getTypeID());
+
+    uint16_t nLinks;
+    const auto *links = builder.getLinks(
+        fanoutID, fanoutLinkBuffer.data(), nLinks);
+
+    for (uint16_t j = 0; j < nLinks; ++j) {
+      if (links[j].idx != entryID || links[j].out != output) {
+        continue;
+      }
+      fanout++;
+      if (libCell && j < libCell->inputPins.size()) {
+        capacitance += libCell->inputPins[j].capacitance;
+      } else if (fanoutCell.isOut()) {
+        capacitance += settings.outputLoad;
+      }
+    }
+  }
+
+  if (wlm && fanout) {
+    capacitance += wlm->getFanoutCapacitance(fanout);
+  }
+  return capacitance;
+}
+
+void TimingAnalyzer::evaluate(EntryID entryID) {
+  const auto &cell = builder.getCell(entryID);
+  refcount[entryID] = cell.refcount;
+
+  if (cell.isIn()) {
+    arrival[entryID] = RiseFall{settings.inputArrival, settings.inputArrival};
+    slew[entryID] = RiseFall{settings.inputSlew, settings.inputSlew};
+    load[entryID] = computeLoad(entryID, 0);
+    return;
+  }
+
+  uint16_t nLinks;
+  const auto *links = getLinks(entryID, nLinks);
+  auto *cellArcs = arcs.data() + arcOffset[entryID];
+
+  for (uint16_t j = 0; j < nLinks; ++j) {
+    cellArcs[j] = Arc{links[j].idx};
+  }
+
+  RiseFall cellArrival{NoArc, NoArc};
+  RiseFall cellSlew{0., 0.};
+
+  const auto propagate = [&](double &outArrival, double &outSlew,
+                             double &arcDelay, double inArrival,
+                             const library::CompiledTimingArc::Value &value) {
+    outArrival = std::max(outArrival, inArrival + value.delay);
+    outSlew = std::max(outSlew, value.slew);
+    arcDelay = std::max(arcDelay, value.delay);
+  };
+
+  const auto *libCell = library.getCellPtr(cell.getTypeID());
+  const size_t nOut = libCell ? libCell->outputPins.size() : 0;
+
+  double cellLoad = 0.;
+  for (uint16_t out = 0; out < nOut; ++out) {
+    const auto &pin = libCell->outputPins[out];
+    const double outLoad = computeLoad(entryID, out);
+    cellLoad += outLoad;
+
+    for (size_t k = 0; k < pin.timingArcs.size(); ++k) {
+      const auto &arc = pin.timingArcs[k];
+      const int16_t input =
+          k < pin.timingArcInputs.size() ? pin.timingArcInputs[k] : -1;
+
+      // Unknown related pin: the arc is applied to all the inputs.
+      const uint16_t jBegin = input < 0 ? 0 : input;
+      const uint16_t jEnd =
+          input < 0 ? nLinks : std::min<int>(input + 1, nLinks);
+
+      for (uint16_t j = jBegin; j < jEnd; ++j) {
+        const auto sense = j < pin.unateness.size() ? pin.unateness[j]
+                                                    : Unateness::Binate;
+        const auto &inArrival = arrival[links[j].idx];
+        const auto &inSlew = slew[links[j].idx];
+        auto &cellArc = cellArcs[j];
+
+        if (sense != Unateness::Negative) {
+          propagate(cellArrival.rise, cellSlew.rise, cellArc.rr, inArrival.rise,
+                    arc.getRiseValue(inSlew.rise, outLoad));
+          propagate(cellArrival.fall, cellSlew.fall, cellArc.ff, inArrival.fall,
+                    arc.getFallValue(inSlew.fall, outLoad));
+        }
+        if (sense != Unateness::Positive) {
+          propagate(cellArrival.rise, cellSlew.rise, cellArc.fr, inArrival.fall,
+                    arc.getRiseValue(inSlew.fall, outLoad));
+          propagate(cellArrival.fall, cellSlew.fall, cellArc.rf, inArrival.rise,
+                    arc.getFallValue(inSlew.rise, outLoad));
+        }
+      }
+    }
+  }
+
+  if (!libCell) {
+    cellLoad = cell.isOut() ? settings.outputLoad : computeLoad(entryID, 0);
+  }
+  load[entryID] = cellLoad;
+
+  if (cellArrival.rise != NoArc || cellArrival.fall != NoArc) {
+    arrival[entryID] = cellArrival;
+    slew[entryID] = cellSlew;
+    return;
+  }
+
+  // Outputs, buffers, and cells w/o timing arcs are treated as wires.
+  cellArrival = RiseFall{NoArc, NoArc};
+  for (uint16_t j = 0; j < nLinks; ++j) {
+    const auto &inArrival = arrival[links[j].idx];
+    const auto &inSlew = slew[links[j].idx];
+    auto &cellArc = cellArcs[j];
+
+    if (!links[j].inv) {
+      cellArc.rr = cellArc.ff = 0.;
+      cellArrival.rise = std::max(cellArrival.rise, inArrival.rise);
+      cellArrival.fall = std::max(cellArrival.fall, inArrival.fall);
+      cellSlew.rise = std::max(cellSlew.rise, inSlew.rise);
+      cellSlew.fall = std::max(cellSlew.fall, inSlew.fall);
+    } else {
+      cellArc.rf = cellArc.fr = 0.;
+      cellArrival.rise = std::max(cellArrival.rise, inArrival.fall);
+      cellArrival.fall = std::max(cellArrival.fall, inArrival.rise);
+      cellSlew.rise = std::max(cellSlew.rise, inSlew.fall);
+      cellSlew.fall = std::max(cellSlew.fall, inSlew.rise);
+    }
+  }
+
+  // Constants.
+  if (!nLinks) {
+    cellArrival = RiseFall{0., 0.};
+  }
+
+  arrival[entryID] = cellArrival;
+  slew[entryID] = cellSlew;
+}
+
+TimingAnalyzer::RiseFall TimingAnalyzer::evaluateTail(EntryID entryID) const {
+  if (builder.getCell(entryID).isOut()) {
+    return RiseFall{0., 0.};
+  }
+
+  RiseFall result{NoArc, NoArc};
+  for (const auto fanoutID : builder.getFanouts(entryID)) {
+    const auto &fanoutTail = tail[fanoutID];
+    const auto *fanoutArcs = getArcs(fanoutID);
+
+    for (uint16_t j = 0; j < arcNum[fanoutID]; ++j) {
+      const auto &arc = fanoutArcs[j];
+      if (arc.source != entryID) {
+        continue;
+      }
+      result.rise = std::max({result.rise, arc.rr + fanoutTail.rise,
+                                           arc.rf + fanoutTail.fall});
+      result.fall = std::max({result.fall, arc.fr + fanoutTail.rise,
+                                           arc.ff + fanoutTail.fall});
+    }
+  }
+  return result;
+}
+
+void TimingAnalyzer::computeDelay() {
+  delay = 0.;
+  for (const auto outputID : outputs) {
+    delay = std::max(delay, arrival[outputID].getMax());
+  }
+}
+
+TimingAnalyzer::Path TimingAnalyzer::getCriticalPath() const {
+  Path path;
+  if (outputs.empty()) {
+    return path;
+  }
+
+  auto entryID = *std::max_element(outputs.begin(), outputs.end(),
+      [this](EntryID lhs, EntryID rhs) {
+        return arrival[lhs].getMax() < arrival[rhs].getMax();
+      });
+  bool isRise = arrival[entryID].rise >= arrival[entryID].fall;
+
+  while (true) {
+    const auto &entryArrival = arrival[entryID];
+    const auto &entrySlew = slew[entryID];
+    path.push_back(PathPoint{entryID,
+                             isRise,
+                             isRise ? entryArrival.rise : entryArrival.fall,
+                             isRise ? entrySlew.rise : entrySlew.fall});
+
+    // Find the input transition determining the arrival time.
+    double bestArrival = NoArc;
+    EntryID bestID = entryID;
+    bool bestIsRise = isRise;
+
+    const auto *entryArcs = getArcs(entryID);
+    for (uint16_t j = 0; j < arcNum[entryID]; ++j) {
+      const auto &arc = entryArcs[j];
+      const auto &inArrival = arrival[arc.source];
+
+      const double fromRise = inArrival.rise + (isRise ? arc.rr : arc.rf);
+      const double fromFall = inArrival.fall + (isRise ? arc.fr : arc.ff);
+
+      if (fromRise > bestArrival) {
+        bestArrival = fromRise;
+        bestID = arc.source;
+        bestIsRise = true;
+      }
+      if (fromFall > bestArrival) {
+        bestArrival = fromFall;
+        bestID = arc.source;
+        bestIsRise = false;
+      }
+    }
+
+    if (bestID == entryID) {
+      break;
+    }
+    entryID = bestID;
+    isRise = bestIsRise;
+  }
+
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+void TimingAnalyzer::printCriticalPath(std::ostream &out) const {
+  const auto path = getCriticalPath();
+
+  out << std::setw(8) << std::left << "Entry"
+      << std::setw(40) << std::left << "Cell"
+      << std::setw(6) << std::left << "Edge"
+      << std::setw(12) << std::left << "Arrival"
+      << "Slew" << std::endl;
+
+  for (const auto &point : path) {
+    const auto &cell = builder.getCell(point.entryID);
+    out << std::setw(8) << std::left << point.entryID
+        << std::setw(40) << std::left << cell.getType().getName()
+        << std::setw(6) << std::left << (point.isRise ? "rise" : "fall")
+        << std::setw(12) << std::left << std::fixed << point.arrival
+        << point.slew << std::endl;
+  }
+}
+
+} // namespace eda::gate::estimator
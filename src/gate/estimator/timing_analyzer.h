@@ -0,0 +1,242 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "gate/library/library.h"
+#include "gate/model/subnet.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <vector>
+
+namespace eda::gate::estimator {
+
+/**
+ * \brief Static timing analyzer of tech-mapped subnets.
+ *
+ * The analyzer computes the rise/fall arrival times, slews, and required
+ * times of the subnet cells w/ the NLDM tables of the library. The output
+ * loads are the input pin capacitances of the fanouts plus the wire-load
+ * model capacitance. The timing data are stored in arrays indexed by the
+ * entry identifiers, so the analyzer is bound to the builder and should be
+ * updated (see update()) after the builder has been modified.
+ *
+ * Incremental update: the entries changed by a local replacement should be
+ * marked via markChanged() (e.g., w/ the getChangeCallback() callback passed
+ * to SubnetBuilder::replace() as onNewCell and onRecomputedDepth). Then, the
+ * timing is propagated forward from the changed entries and their fanins
+ * (whose loads might change) and backward to the fanin cones.
+ */
+class TimingAnalyzer final {
+public:
+  using EntryID = model::EntryID;
+  using SubnetBuilder = model::SubnetBuilder;
+
+  /// Rise and fall values.
+  struct RiseFall final {
+    double getMax() const { return std::max(rise, fall); }
+    double getMin() const { return std::min(rise, fall); }
+
+    bool operator==(const RiseFall &other) const {
+      return rise == other.rise && fall == other.fall;
+    }
+    bool operator!=(const RiseFall &other) const {
+      return !(*this == other);
+    }
+
+    double rise{0.};
+    double fall{0.};
+  };
+
+  /// Analysis settings.
+  struct Settings final {
+    /// Arrival time at the subnet inputs.
+    double inputArrival{0.};
+    /// Transition time at the subnet inputs.
+    double inputSlew{0.};
+    /// Capacitive load of the subnet outputs.
+    double outputLoad{0.};
+    /// Required time at the subnet outputs (the delay is used if negative).
+    double requiredTime{-1.};
+    /// Wire-load model (the default one of the library is used if null).
+    const library::WireLoadModel *wlm{nullptr};
+  };
+
+  /// Point of a timing path.
+  struct PathPoint final {
+    EntryID entryID;
+    bool isRise;
+    double arrival;
+    double slew;
+  };
+
+  /// Timing path (from an input to an output).
+  using Path = std::vector<PathPoint>;
+
+  TimingAnalyzer(SubnetBuilder &builder,
+                 const library::SCLibrary &library,
+                 const Settings &settings);
+
+  TimingAnalyzer(SubnetBuilder &builder,
+                 const library::SCLibrary &library):
+      TimingAnalyzer(builder, library, Settings{}) {}
+
+  /// Analyzes the subnet from scratch.
+  void analyze();
+
+  /// Marks the entry as changed (new or relinked).
+  void markChanged(EntryID entryID);
+
+  /// Returns the callback that marks the entries as changed.
+  SubnetBuilder::CellActionCallback getChangeCallback() {
+    return [this](EntryID entryID) { markChanged(entryID); };
+  }
+
+  /// Propagates the timing changes caused by the marked entries.
+  void update();
+
+  /// Returns the (worst) arrival time of the entry.
+  double getArrival(EntryID entryID) const {
+    return arrival[entryID].getMax();
+  }
+
+  /// Returns the rise/fall arrival times of the entry.
+  const RiseFall &getArrivalRiseFall(EntryID entryID) const {
+    return arrival[entryID];
+  }
+
+  /// Returns the (worst) slew of the entry.
+  double getSlew(EntryID entryID) const {
+    return slew[entryID].getMax();
+  }
+
+  /// Returns the rise/fall slews of the entry.
+  const RiseFall &getSlewRiseFall(EntryID entryID) const {
+    return slew[entryID];
+  }
+
+  /// Returns the output load of the entry.
+  double getLoad(EntryID entryID) const {
+    return load[entryID];
+  }
+
+  /// Returns the (worst) required time of the entry.
+  double getRequired(EntryID entryID) const {
+    return getRequiredTime() - tail[entryID].getMax();
+  }
+
+  /// Returns the rise/fall required times of the entry.
+  RiseFall getRequiredRiseFall(EntryID entryID) const {
+    const auto time = getRequiredTime();
+    return RiseFall{time - tail[entryID].rise, time - tail[entryID].fall};
+  }
+
+  /// Returns the slack of the entry (infinity if there is no path).
+  double getSlack(EntryID entryID) const {
+    const auto time = getRequiredTime();
+    return std::min(time - tail[entryID].rise - arrival[entryID].rise,
+                    time - tail[entryID].fall - arrival[entryID].fall);
+  }
+
+  /// Returns the subnet delay (the maximum output arrival time).
+  double getDelay() const { return delay; }
+
+  /// Returns the required time of the subnet outputs.
+  double getRequiredTime() const {
+    return settings.requiredTime >= 0. ? settings.requiredTime : delay;
+  }
+
+  /// Returns the worst slack of the subnet.
+  double getWorstSlack() const { return getRequiredTime() - delay; }
+
+  /// Returns the critical path.
+  Path getCriticalPath() const;
+
+  /// Prints the critical path.
+  void printCriticalPath(std::ostream &out) const;
+
+private:
+  static constexpr double NoArc = -std::numeric_limits<double>::infinity();
+
+  /// Delays from the input transitions to the output transitions.
+  struct Arc final {
+    /// Source entry (the link is stored to track the replacements).
+    EntryID source{0};
+    double rr{NoArc}; // rise-to-rise
+    double rf{NoArc}; // rise-to-fall
+    double fr{NoArc}; // fall-to-rise
+    double ff{NoArc}; // fall-to-fall
+  };
+
+  /// Allocates the timing data for the new entries.
+  void resize();
+
+  /// Allocates the arcs of the entry.
+  void allocArcs(EntryID entryID);
+
+  /// Collects the entries affected by the changed entry.
+  void collectAffected(EntryID entryID,
+                       std::vector<bool> &visited,
+                       std::vector<EntryID> &affected);
+
+  /// Computes the arrival times, the slews, and the arcs of the entry.
+  void evaluate(EntryID entryID);
+  /// Computes the maximum delays from the entry to the subnet outputs.
+  RiseFall evaluateTail(EntryID entryID) const;
+
+  /// Computes the load of the entry output.
+  double computeLoad(EntryID entryID, uint16_t output) const;
+  /// Updates the subnet delay.
+  void computeDelay();
+
+  const SubnetBuilder::Link *getLinks(EntryID entryID, uint16_t &nLinks) const {
+    return builder.getLinks(entryID, linkBuffer.data(), nLinks);
+  }
+
+  const Arc *getArcs(EntryID entryID) const {
+    return arcs.data() + arcOffset[entryID];
+  }
+
+  bool isValid(EntryID entryID) const {
+    return builder.getDepth(entryID) != SubnetBuilder::invalidDepth;
+  }
+
+  SubnetBuilder &builder;
+  const library::SCLibrary &library;
+  const Settings settings;
+  const library::WireLoadModel *wlm;
+
+  std::vector<RiseFall> arrival;
+  std::vector<RiseFall> slew;
+  std::vector<RiseFall> tail;
+  std::vector<double> load;
+
+  /// Arcs of the entries (one per link) stored in the pool.
+  std::vector<uint32_t> arcOffset;
+  std::vector<uint16_t> arcNum;
+  std::vector<Arc> arcs;
+
+  /// Reference counts (to detect the fanout changes).
+  std::vector<uint32_t> refcount;
+
+  /// Entries marked as changed.
+  std::vector<EntryID> changed;
+
+  /// Subnet outputs.
+  std::vector<EntryID> outputs;
+  /// Subnet delay.
+  double delay{0.};
+
+  mutable std::vector<SubnetBuilder::Link> linkBuffer;
+  mutable std::vector<SubnetBuilder::Link> fanoutLinkBuffer;
+};
+
+} // namespace eda::gate::estimator
@@ -0,0 +1,171 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/library/compiled_lut.h"
+#include "gate/library/library_types.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace eda::gate::library {
+
+CompiledLut::Axis CompiledLut::compileAxis(const std::vector<double> &index) {
+  Axis axis;
+  axis.size = index.size();
+  axis.indexOffset = data.size();
+  data.insert(data.end(), index.begin(), index.end());
+
+  axis.rspanOffset = data.size();
+  for (size_t i = 1; i < index.size(); ++i) {
+    const double span = index[i] - index[i - 1];
+    data.push_back(span != 0. ? 1. / span : 0.);
+  }
+
+  if (index.size() >= 2) {
+    const double step = (index.back() - index.front()) / (index.size() - 1);
+    axis.isUniform = step > 0.;
+    for (size_t i = 1; i < index.size() && axis.isUniform; ++i) {
+      const double expected = index.front() + i * step;
+      axis.isUniform = std::fabs(index[i] - expected) <= 1e-6 * step;
+    }
+    if (axis.isUniform) {
+      axis.origin = index.front();
+      axis.rstep = 1. / step;
+    }
+  }
+
+  return axis;
+}
+
+CompiledLut::CompiledLut(const LUT &lut) {
+  if (lut.indexes.empty() || lut.values.empty()) {
+    return;
+  }
+
+  // 1D tables are treated as 2D tables w/ a single column.
+  static const std::vector<double> single{0.};
+  const auto &indexX = lut.indexes[0];
+  const auto &indexY = lut.indexes.size() > 1 ? lut.indexes[1] : single;
+
+  const size_t nX = indexX.size();
+  const size_t nY = indexY.size();
+  if (nX == 0 || nY == 0 || lut.values.size() < nX * nY) {
+    return;
+  }
+
+  data.reserve(2 * (nX + nY) + nX * nY);
+  xAxis = compileAxis(indexX);
+  yAxis = compileAxis(indexY);
+
+  // The values are taken in the same way as by LUT::getValue().
+  valueOffset = data.size();
+  for (size_t i = 0; i < nX; ++i) {
+    for (size_t j = 0; j < nY; ++j) {
+      data.push_back(lut.indexes.size() > 1 ? lut.getValue(i, j)
+                                            : lut.values[i]);
+    }
+  }
+}
+
+bool CompiledLut::hasSameGrid(const CompiledLut &other) const {
+  if (xAxis.size != other.xAxis.size || yAxis.size != other.yAxis.size) {
+    return false;
+  }
+
+  // The indices are stored first.
+  const size_t n = xAxis.size + yAxis.size - 2 + xAxis.size + yAxis.size;
+  return std::equal(data.begin(), data.begin() + n, other.data.begin());
+}
+
+void CompiledLut::getValues(const double *x,
+                            const double *y,
+                            double *result,
+                            const size_t n) const {
+  assert(!isEmpty());
+  for (size_t i = 0; i < n; ++i) {
+    result[i] = getValue(locateX(x[i]), locateY(y[i]));
+  }
+}
+
+CompiledTimingArc::CompiledTimingArc(const LUT &delayFall,
+                                     const LUT &delayRise,
+                                     const LUT &slewFall,
+                                     const LUT &slewRise):
+    delayFall(delayFall),
+    delayRise(delayRise),
+    slewFall(slewFall),
+    slewRise(slewRise) {
+  hasSameGrid = !this->delayFall.isEmpty()
+      && !this->delayRise.isEmpty()
+      && !this->slewFall.isEmpty()
+      && !this->slewRise.isEmpty()
+      && this->delayFall.hasSameGrid(this->delayRise)
+      && this->delayFall.hasSameGrid(this->slewFall)
+      && this->delayFall.hasSameGrid(this->slewRise);
+}
+
+static double getLutValue(const CompiledLut &lut,
+                          const double x,
+                          const double y) {
+  // Missing tables do not contribute to the maximum.
+  return lut.isEmpty() ? 0. : lut.getValue(x, y);
+}
+
+CompiledTimingArc::Value CompiledTimingArc::getValue(
+    const double inputSlew, const double outputCap) const {
+  if (hasSameGrid) {
+    const auto px = delayFall.locateX(inputSlew);
+    const auto py = delayFall.locateY(outputCap);
+
+    return Value{
+        std::max(delayFall.getValue(px, py), delayRise.getValue(px, py)),
+        std::max(slewFall.getValue(px, py), slewRise.getValue(px, py))};
+  }
+
+  return Value{
+      std::max(getLutValue(delayFall, inputSlew, outputCap),
+               getLutValue(delayRise, inputSlew, outputCap)),
+      std::max(getLutValue(slewFall, inputSlew, outputCap),
+               getLutValue(slewRise, inputSlew, outputCap))};
+}
+
+static CompiledTimingArc::Value getLutValues(const CompiledLut &delay,
+                                            const CompiledLut &slew,
+                                            const bool hasSameGrid,
+                                            const double x,
+                                            const double y) {
+  if (hasSameGrid) {
+    const auto px = delay.locateX(x);
+    const auto py = delay.locateY(y);
+    return CompiledTimingArc::Value{delay.getValue(px, py),
+                                    slew.getValue(px, py)};
+  }
+  return CompiledTimingArc::Value{getLutValue(delay, x, y),
+                                  getLutValue(slew, x, y)};
+}
+
+CompiledTimingArc::Value CompiledTimingArc::getRiseValue(
+    const double inputSlew, const double outputCap) const {
+  return getLutValues(delayRise, slewRise, hasSameGrid, inputSlew, outputCap);
+}
+
+CompiledTimingArc::Value CompiledTimingArc::getFallValue(
+    const double inputSlew, const double outputCap) const {
+  return getLutValues(delayFall, slewFall, hasSameGrid, inputSlew, outputCap);
+}
+
+void CompiledTimingArc::getValues(const double *inputSlew,
+                                  const double *outputCap,
+                                  Value *result,
+                                  const size_t n) const {
+  for (size_t i = 0; i < n; ++i) {
+    result[i] = getValue(inputSlew[i], outputCap[i]);
+  }
+}
+
+} // namespace eda::gate::library
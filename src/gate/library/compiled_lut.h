@@ -0,0 +1,163 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace eda::gate::library {
+
+struct LUT;
+
+/**
+ * \brief Two-dimensional LUT compiled for fast (bi)linear interpolation.
+ *
+ * The indices, the reciprocal spans of the index segments, and the values
+ * are stored in one contiguous float array. For uniform grids, the segment
+ * is computed arithmetically; otherwise, it is found by a linear scan (the
+ * NLDM tables are small). Out-of-range points are extrapolated using the
+ * border segments, which gives the same results as the original LUT lookup.
+ */
+class CompiledLut final {
+public:
+  /// Point location: segment index and relative position in the segment.
+  struct Point final {
+    uint32_t i{0};
+    double t{0.};
+  };
+
+  CompiledLut() = default;
+  explicit CompiledLut(const LUT &lut);
+
+  /// Checks whether the LUT is empty (there is nothing to interpolate).
+  bool isEmpty() const { return data.empty(); }
+
+  /// Checks whether the LUTs have the same indices.
+  bool hasSameGrid(const CompiledLut &other) const;
+
+  Point locateX(const double x) const { return locate(xAxis, x); }
+  Point locateY(const double y) const { return locate(yAxis, y); }
+
+  /// Interpolates the value at the located point.
+  double getValue(const Point &px, const Point &py) const {
+    const float *v = data.data() + valueOffset;
+    const uint32_t nY = yAxis.size;
+    const uint32_t dX = xAxis.size > 1 ? nY : 0;
+    const uint32_t dY = nY > 1 ? 1 : 0;
+
+    const float *row0 = v + px.i * nY + py.i;
+    const float *row1 = row0 + dX;
+
+    const double r0 = row0[0] + py.t * (row0[dY] - row0[0]);
+    const double r1 = row1[0] + py.t * (row1[dY] - row1[0]);
+    return r0 + px.t * (r1 - r0);
+  }
+
+  /// Interpolates the value at the given point.
+  double getValue(const double x, const double y) const {
+    assert(!isEmpty());
+    return getValue(locateX(x), locateY(y));
+  }
+
+  /// Interpolates the values at the given points.
+  void getValues(const double *x,
+                 const double *y,
+                 double *result,
+                 const size_t n) const;
+
+private:
+  struct Axis final {
+    /// Number of the points.
+    uint32_t size{0};
+    /// Offset of the indices in the data array.
+    uint32_t indexOffset{0};
+    /// Offset of the reciprocal spans in the data array.
+    uint32_t rspanOffset{0};
+    /// Uniform grid: origin and reciprocal step.
+    bool isUniform{false};
+    double origin{0.};
+    double rstep{0.};
+  };
+
+  Axis compileAxis(const std::vector<double> &index);
+
+  Point locate(const Axis &axis, const double x) const {
+    if (axis.size < 2) {
+      return Point{0, 0.};
+    }
+
+    const float *index = data.data() + axis.indexOffset;
+    const uint32_t last = axis.size - 2;
+
+    uint32_t i = 0;
+    if (axis.isUniform) {
+      const double k = (x - axis.origin) * axis.rstep;
+      i = k <= 0. ? 0 : (k >= last ? last : static_cast<uint32_t>(k));
+    } else {
+      while (i < last && x >= index[i + 1]) {
+        i++;
+      }
+    }
+
+    const float *rspan = data.data() + axis.rspanOffset;
+    return Point{i, (x - index[i]) * rspan[i]};
+  }
+
+  Axis xAxis;
+  Axis yAxis;
+  uint32_t valueOffset{0};
+
+  /// Indices, reciprocal spans, and values.
+  std::vector<float> data;
+};
+
+/**
+ * \brief Compiled delay and slew LUTs of a timing arc.
+ *
+ * The tables of an arc are usually defined by the same template: if so, the
+ * point is located once for all the four tables.
+ */
+class CompiledTimingArc final {
+public:
+  /// Delay and slew of the arc (maximum of the rise and fall values).
+  struct Value final {
+    double delay;
+    double slew;
+  };
+
+  CompiledTimingArc(const LUT &delayFall,
+                    const LUT &delayRise,
+                    const LUT &slewFall,
+                    const LUT &slewRise);
+
+  /// Returns the delay and the slew for the input slew and the output load.
+  Value getValue(const double inputSlew, const double outputCap) const;
+
+  /// Returns the delay and the slew of the rising output transition.
+  Value getRiseValue(const double inputSlew, const double outputCap) const;
+  /// Returns the delay and the slew of the falling output transition.
+  Value getFallValue(const double inputSlew, const double outputCap) const;
+
+  /// Returns the delays and the slews for the given points.
+  void getValues(const double *inputSlew,
+                 const double *outputCap,
+                 Value *result,
+                 const size_t n) const;
+
+private:
+  CompiledLut delayFall, delayRise;
+  CompiledLut slewFall, slewRise;
+
+  /// All the tables have the same indices.
+  bool hasSameGrid;
+};
+
+} // namespace eda::gate::library
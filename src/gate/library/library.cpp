@@ -1199,6 +1199,19 @@ static kitty::dynamic_truth_table getFunction(
   return truthTable;
 }
 
+static Unateness getUnateness(const kitty::dynamic_truth_table &func,
+                              const uint var) {
+  const auto cofactor0 = kitty::cofactor0(func, var);
+  const auto cofactor1 = kitty::cofactor1(func, var);
+  if (kitty::is_const0(cofactor0 & ~cofactor1)) {
+    return Unateness::Positive;
+  }
+  if (kitty::is_const0(cofactor1 & ~cofactor0)) {
+    return Unateness::Negative;
+  }
+  return Unateness::Binate;
+}
+
 void SCLibrary::internalLoadCombCell(StandardCell &&cell) {
   const auto ports = getPorts(cell);
   const auto nInputs = model::CellTypeAttr::getInBitWidth(ports);
@@ -1294,6 +1307,17 @@ void SCLibrary::internalLoadCombCell(StandardCell &&cell) {
   cell.ctt = ctt;
   cell.transform = t;
 
+  for (size_t out = 0; out < cell.outputPins.size(); ++out) {
+    auto &pin = cell.outputPins[out];
+    pin.compileTimingArcs(cell.inputPins);
+    if (nInputs != 0) {
+      pin.unateness.resize(nInputs);
+      for (uint in = 0; in < nInputs; in++) {
+        pin.unateness[in] = getUnateness(funcs[out], in);
+      }
+    }
+  }
+
   size_t i = 0;
   for (auto tt : cell.ctt) {
     const auto strFunc = kitty::to_hex(tt);
@@ -1514,6 +1538,14 @@ void SCLibrary::addSuperCells() {
   combCells_.insert(combCells_.end(), superCells.begin(), superCells.end());
 }
 
+void SCLibrary::addSuperGates() {
+  SuperGateGenerator generator(combCells_, superGateSettings_);
+  auto superGates = generator.generate();
+  combCells_.insert(combCells_.end(),
+                    std::make_move_iterator(superGates.begin()),
+                    std::make_move_iterator(superGates.end()));
+}
+
 void SCLibrary::addConstCells() {
   // Two LinkLists: for cellToAdd and for the cell.
   std::string baseNames[2] = {"ONE", "ZERO"};
@@ -10,6 +10,7 @@
 
 #include "gate/function/truth_table.h" //TODO: try to move to source
 #include "gate/library/library_types.h"
+#include "gate/library/supergate_generator.h"
 
 #include <list>
 #include <string>
@@ -21,6 +22,7 @@ namespace eda::gate::library {
 class SCLibrary final {
 public:
   friend class SCLibraryFactory;
+  friend class SCLibrarySnapshot;
 
   struct SCLibraryProperties {
     uint maxArity = 0;
@@ -59,12 +61,23 @@ public:
   const SCLibraryProperties & getProperties() const {
     return properties_;
   };
+  bool isPrepared() const {
+    return libPrepared;
+  }
+  /// Sets the supergate generation settings (used by prepareLib()).
+  void setSuperGateSettings(const SuperGateGenerator::Settings &settings) {
+    superGateSettings_ = settings;
+  }
+  const SuperGateGenerator::Settings &getSuperGateSettings() const {
+    return superGateSettings_;
+  }
   void prepareLib() {
     if (!libPrepared) {
       findCheapestCells();
       addSuperCells();
       addConstCells();
       completePclasses();
+      addSuperGates();
       updateProperties();
       fillSearchMap();
       libPrepared = true;
@@ -93,6 +106,7 @@ private:
 
   void addSuperCells();
   void addConstCells();
+  void addSuperGates();
   void fillSearchMap();
   void updateProperties();
 
@@ -141,6 +155,7 @@ private:
   std::vector< std::pair<StandardCell, size_t>> negCombCells_;
   std::vector< std::pair<StandardCell, size_t>> constOneCells_;
   std::vector< std::pair<StandardCell, size_t>> constZeroCells_;
+  SuperGateGenerator::Settings superGateSettings_;
   bool libPrepared = false;
 
   //TODO: remove
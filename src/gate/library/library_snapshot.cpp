@@ -0,0 +1,913 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/library/library_factory.h"
+#include "gate/library/library_snapshot.h"
+#include "gate/library/readcells_srcfile_parser.h"
+#include "gate/model/subnet.h"
+#include "util/serializer.h"
+
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace eda::gate::library {
+
+using CellTypeID = model::CellTypeID;
+using Entry = model::Subnet::Entry;
+using Header = SCLibrarySnapshotHeader;
+
+/// Tag of the library cell types in the subnet entries (gates are not tagged).
+static constexpr uint32_t LibraryTypeTag = 1u << 31;
+/// Null index (e.g., of the cheapest cell).
+static constexpr uint32_t NullIndex = -1u;
+
+//===----------------------------------------------------------------------===//
+// Writer
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+class SnapshotWriter final {
+public:
+  SnapshotWriter(std::ostream &out): out(out) {}
+
+  template <typename T>
+  void write(const T &value) {
+    util::pushIntoStream(out, value);
+  }
+
+  template <typename T>
+  void writeArray(const std::vector<T> &array) {
+    write<uint32_t>(array.size());
+    out.write(reinterpret_cast<const char*>(array.data()),
+              array.size() * sizeof(T));
+    check();
+  }
+
+  void writeString(const std::string &string) {
+    write<uint32_t>(string.size());
+    out.write(string.data(), string.size());
+    check();
+  }
+
+  void writeStrings(const std::vector<std::string> &strings) {
+    write<uint32_t>(strings.size());
+    for (const auto &string : strings) {
+      writeString(string);
+    }
+  }
+
+  void writeTruthTable(const kitty::dynamic_truth_table &tt) {
+    write<uint32_t>(tt.num_vars());
+    writeArray(std::vector<uint64_t>(tt.cbegin(), tt.cend()));
+  }
+
+  void writeLut(const LUT &lut) {
+    writeString(lut.name);
+    write<uint32_t>(lut.indexes.size());
+    for (const auto &index : lut.indexes) {
+      writeArray(index);
+    }
+    writeArray(lut.values);
+  }
+
+  void writeLuts(const std::vector<LUT> &luts) {
+    write<uint32_t>(luts.size());
+    for (const auto &lut : luts) {
+      writeLut(lut);
+    }
+  }
+
+private:
+  void check() {
+    if (out.fail()) {
+      throw std::runtime_error("Serialization: Failed to push data into stream");
+    }
+  }
+
+  std::ostream &out;
+};
+
+//===----------------------------------------------------------------------===//
+// Reader
+//===----------------------------------------------------------------------===//
+
+class SnapshotReader final {
+public:
+  SnapshotReader(const char *begin, const char *end): pos(begin), end(end) {}
+
+  template <typename T>
+  T read() {
+    T value;
+    std::memcpy(&value, take(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  /// Reads the number of items (each item takes at least the given size).
+  /// The number is checked before allocating the items.
+  size_t readSize(size_t itemSize = 1) {
+    const size_t size = read<uint32_t>();
+    if (size > static_cast<size_t>(end - pos) / itemSize) {
+      throw std::runtime_error("Invalid library snapshot: unexpected end");
+    }
+    return size;
+  }
+
+  template <typename T>
+  std::vector<T> readArray() {
+    const auto size = readSize(sizeof(T));
+    std::vector<T> array(size);
+    std::memcpy(array.data(), take(size * sizeof(T)), size * sizeof(T));
+    return array;
+  }
+
+  std::string readString() {
+    const auto size = readSize();
+    return std::string(take(size), size);
+  }
+
+  std::vector<std::string> readStrings() {
+    std::vector<std::string> strings(readSize(sizeof(uint32_t)));
+    for (auto &string : strings) {
+      string = readString();
+    }
+    return strings;
+  }
+
+  kitty::dynamic_truth_table readTruthTable() {
+    const auto nVars = read<uint32_t>();
+    const auto words = readArray<uint64_t>();
+    // The number of words is checked before allocating the table.
+    const size_t nWords = nVars <= 6 ? 1 : (size_t{1} << (nVars - 6));
+    if (nVars > 32 || words.size() != nWords) {
+      throw std::runtime_error("Invalid library snapshot: truth table");
+    }
+    kitty::dynamic_truth_table tt(nVars);
+    std::copy(words.begin(), words.end(), tt.begin());
+    return tt;
+  }
+
+  LUT readLut() {
+    LUT lut;
+    lut.name = readString();
+    lut.indexes.resize(readSize(sizeof(uint32_t)));
+    for (auto &index : lut.indexes) {
+      index = readArray<double>();
+    }
+    lut.values = readArray<double>();
+    return lut;
+  }
+
+  std::vector<LUT> readLuts() {
+    std::vector<LUT> luts(readSize(sizeof(uint32_t)));
+    for (auto &lut : luts) {
+      lut = readLut();
+    }
+    return luts;
+  }
+
+  bool isEnd() const { return pos == end; }
+
+private:
+  const char *take(size_t size) {
+    if (static_cast<size_t>(end - pos) < size) {
+      throw std::runtime_error("Invalid library snapshot: unexpected end");
+    }
+    const char *data = pos;
+    pos += size;
+    return data;
+  }
+
+  const char *pos;
+  const char *end;
+};
+
+/// Read-only memory-mapped file.
+class MappedFile final {
+public:
+  MappedFile(const std::string &fileName) {
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw std::runtime_error("Failed to open library snapshot " + fileName);
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      close(fd);
+      throw std::runtime_error("Failed to stat library snapshot " + fileName);
+    }
+    size = st.st_size;
+
+    void *ptr = size ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0)
+                     : MAP_FAILED;
+    close(fd);
+    if (ptr == MAP_FAILED) {
+      throw std::runtime_error("Failed to map library snapshot " + fileName);
+    }
+    data = static_cast<const char*>(ptr);
+  }
+
+  ~MappedFile() {
+    munmap(const_cast<char*>(data), size);
+  }
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  const char *data{nullptr};
+  size_t size{0};
+};
+
+} // namespace
+
+//===----------------------------------------------------------------------===//
+// Cell Types
+//===----------------------------------------------------------------------===//
+
+using TypeIndices = std::unordered_map<CellTypeID, uint32_t>;
+
+/// Checks whether the cell type is a standard gate (incl. inputs/outputs).
+static bool isStandardGate(const CellTypeID typeID) {
+  const auto &type = model::CellType::get(typeID);
+  return model::getCellTypeID(type.getSymbol()) == typeID;
+}
+
+/// Collects the library cell types (the used types precede the users).
+static void collectTypes(CellTypeID typeID,
+                         TypeIndices &indices,
+                         std::vector<CellTypeID> &types) {
+  if (indices.find(typeID) != indices.end()) {
+    return;
+  }
+
+  const auto &type = model::CellType::get(typeID);
+  if (type.isSubnet()) {
+    const auto &subnet = type.getSubnet();
+    const auto &entries = subnet.getEntries();
+    for (size_t i = 0; i < subnet.size(); ++i) {
+      const auto &cell = entries[i].cell;
+      if (!isStandardGate(cell.getTypeID())) {
+        collectTypes(cell.getTypeID(), indices, types);
+      }
+      i += cell.more;
+    }
+  }
+
+  indices.emplace(typeID, types.size());
+  types.push_back(typeID);
+}
+
+static void writeType(SnapshotWriter &writer,
+                      CellTypeID typeID,
+                      const TypeIndices &indices) {
+  const auto &type = model::CellType::get(typeID);
+
+  writer.writeString(type.getName());
+  writer.write<uint16_t>(type.getSymbol());
+  writer.write<uint16_t>(type.getInNum());
+  writer.write<uint16_t>(type.getOutNum());
+
+  writer.write<uint8_t>(type.hasAttr());
+  if (type.hasAttr()) {
+    const auto &attr = type.getAttr();
+    const auto ports = attr.getOrderedPorts();
+    writer.write<uint32_t>(ports.size());
+    for (const auto &port : ports) {
+      writer.writeString(port.hasName() ? port.getName() : "");
+      writer.write(port.width);
+      writer.write(port.input);
+      writer.write(port.index);
+    }
+    writer.write(attr.getPhysProps());
+  }
+
+  writer.write<uint8_t>(type.isSubnet());
+  if (!type.isSubnet()) {
+    return;
+  }
+
+  const auto &subnet = type.getSubnet();
+  writer.write<uint64_t>(subnet.getInNum());
+  writer.write<uint64_t>(subnet.getOutNum());
+  writer.write<uint64_t>(subnet.getCellNum());
+  writer.write<uint64_t>(subnet.getBufNum());
+
+  const auto &array = subnet.getEntries();
+  std::vector<Entry> entries(subnet.size());
+  for (size_t i = 0; i < entries.size(); ++i) {
+    entries[i] = array[i];
+  }
+  for (size_t i = 0; i < entries.size(); ++i) {
+    auto &cell = entries[i].cell;
+    if (isStandardGate(cell.getTypeID())) {
+      cell.type = cell.getSymbol();
+    } else {
+      cell.type = LibraryTypeTag | indices.at(cell.getTypeID());
+    }
+    // Link entries do not contain cell types.
+    i += cell.more;
+  }
+  writer.writeArray(entries);
+}
+
+/// Checks the arity and the links of the i-th entry (the links must refer
+/// to the preceding cells).
+static void checkCell(const std::vector<Entry> &entries,
+                      const std::vector<bool> &isCell,
+                      const size_t i) {
+  using Cell = model::Subnet::Cell;
+
+  const auto &cell = entries[i].cell;
+  const auto &type = cell.getType();
+
+  const size_t more = cell.arity > Cell::InPlaceLinks
+      ? (cell.arity - Cell::InPlaceLinks + Cell::InEntryLinks - 1)
+          / Cell::InEntryLinks
+      : 0;
+  if (cell.more != more || i + more >= entries.size()) {
+    throw std::runtime_error("Invalid library snapshot: cell links");
+  }
+  if (type.isInNumFixed() && type.getInNum() != cell.arity) {
+    throw std::runtime_error("Invalid library snapshot: cell arity");
+  }
+
+  for (uint16_t j = 0; j < cell.arity; ++j) {
+    const auto [e, k] = model::Subnet::getLinkIndices(i, j);
+    const auto &link = (e == i) ? cell.link[k] : entries[e].link[k];
+    if (link.idx >= i || !isCell[link.idx]) {
+      throw std::runtime_error("Invalid library snapshot: link");
+    }
+    const auto &source = entries[link.idx].cell.getType();
+    if (source.isOutNumFixed() && link.out >= source.getOutNum()) {
+      throw std::runtime_error("Invalid library snapshot: link output");
+    }
+  }
+}
+
+static CellTypeID readType(SnapshotReader &reader,
+                           const std::vector<CellTypeID> &types) {
+  const auto name = reader.readString();
+  const auto symbol = static_cast<model::CellSymbol>(reader.read<uint16_t>());
+  const auto nIn = reader.read<uint16_t>();
+  const auto nOut = reader.read<uint16_t>();
+
+  model::CellTypeAttrID attrID = model::OBJ_NULL_ID;
+  if (reader.read<uint8_t>()) {
+    model::CellType::PortVector ports(reader.readSize(sizeof(uint32_t)));
+    for (auto &port : ports) {
+      const auto portName = reader.readString();
+      const auto width = reader.read<model::Port::Width>();
+      const auto input = reader.read<model::Port::Flags>();
+      const auto index = reader.read<model::Port::Index>();
+      port = portName.empty() ? model::Port(width, input, index)
+                              : model::Port(portName, width, input, index);
+    }
+    attrID = model::makeCellTypeAttr(ports);
+    model::CellTypeAttr::get(attrID).setPhysProps(
+        reader.read<model::PhysicalProperties>());
+  }
+
+  uint64_t implID = model::OBJ_NULL_ID;
+  if (reader.read<uint8_t>()) {
+    const auto nInSubnet = reader.read<uint64_t>();
+    const auto nOutSubnet = reader.read<uint64_t>();
+    const auto nCell = reader.read<uint64_t>();
+    const auto nBuf = reader.read<uint64_t>();
+
+    auto entries = reader.readArray<Entry>();
+    if (nInSubnet + nOutSubnet > entries.size()) {
+      throw std::runtime_error("Invalid library snapshot: subnet");
+    }
+
+    std::vector<bool> isCell(entries.size(), false);
+    for (size_t i = 0; i < entries.size(); ++i) {
+      auto &cell = entries[i].cell;
+      if (cell.type & LibraryTypeTag) {
+        const auto index = cell.type & ~LibraryTypeTag;
+        if (index >= types.size()) {
+          throw std::runtime_error("Invalid library snapshot: cell type");
+        }
+        cell.type = CellTypeID::makeSID(types[index]);
+      } else {
+        const auto sid =
+            model::getCellTypeSID(static_cast<model::CellSymbol>(cell.type));
+        if (sid == -1u) {
+          throw std::runtime_error("Invalid library snapshot: gate");
+        }
+        cell.type = sid;
+      }
+      checkCell(entries, isCell, i);
+      isCell[i] = true;
+      i += cell.more;
+    }
+
+    // The entries are copied as is: no rebuilding via SubnetBuilder.
+    implID = model::allocateObject<model::Subnet>(
+        nInSubnet, nOutSubnet, nCell, nBuf, entries);
+  }
+
+  return model::makeCellType(
+      symbol,
+      name,
+      implID,
+      attrID,
+      model::CellProperties{1, 0, 1, 0, 0, 0, 0, 0, 0},
+      nIn,
+      nOut);
+}
+
+//===----------------------------------------------------------------------===//
+// Cells
+//===----------------------------------------------------------------------===//
+
+static void writeCell(SnapshotWriter &writer,
+                      const StandardCell &cell,
+                      const TypeIndices &indices) {
+  writer.write<uint32_t>(indices.at(cell.cellTypeID));
+  writer.writeString(cell.name);
+
+  writer.write<uint32_t>(cell.ctt.size());
+  for (const auto &ctt : cell.ctt) {
+    writer.writeTruthTable(ctt);
+  }
+  writer.write<uint32_t>(cell.transform.size());
+  for (const auto &transform : cell.transform) {
+    writer.write(transform.negationMask);
+    writer.writeArray(transform.permutation);
+  }
+
+  writer.write(cell.propertyArea);
+  writer.write(cell.propertyDelay);
+  writer.write(cell.propertyLeakagePower);
+
+  writer.write<uint32_t>(cell.inputPins.size());
+  for (const auto &pin : cell.inputPins) {
+    writer.writeString(pin.name);
+    writer.writeLuts(pin.powerFall);
+    writer.writeLuts(pin.powerRise);
+    writer.write(pin.capacitance);
+    writer.write(pin.fallCapacitance);
+    writer.write(pin.riseCapacitance);
+  }
+
+  writer.write<uint32_t>(cell.outputPins.size());
+  for (const auto &pin : cell.outputPins) {
+    writer.writeString(pin.name);
+    writer.writeLuts(pin.powerFall);
+    writer.writeLuts(pin.powerRise);
+    writer.write(pin.maxCapacitance);
+    writer.writeLuts(pin.delayFall);
+    writer.writeLuts(pin.delayRise);
+    writer.writeLuts(pin.slewFall);
+    writer.writeLuts(pin.slewRise);
+    writer.writeArray(pin.timingSence);
+    writer.writeString(pin.stringFunction);
+    writer.writeStrings(pin.relatedPins);
+    writer.writeArray(pin.unateness);
+  }
+}
+
+static StandardCell readCell(SnapshotReader &reader,
+                             const std::vector<CellTypeID> &types) {
+  StandardCell cell;
+
+  const auto typeIndex = reader.read<uint32_t>();
+  if (typeIndex >= types.size()) {
+    throw std::runtime_error("Invalid library snapshot: cell type");
+  }
+  cell.cellTypeID = types[typeIndex];
+  cell.name = reader.readString();
+
+  cell.ctt.resize(reader.readSize(sizeof(uint32_t)));
+  for (auto &ctt : cell.ctt) {
+    ctt = reader.readTruthTable();
+  }
+  cell.transform.resize(reader.readSize(sizeof(uint32_t)));
+  for (auto &transform : cell.transform) {
+    transform.negationMask = reader.read<uint32_t>();
+    transform.permutation = reader.readArray<uint8_t>();
+  }
+
+  cell.propertyArea = reader.read<double>();
+  cell.propertyDelay = reader.read<double>();
+  cell.propertyLeakagePower = reader.read<double>();
+
+  cell.inputPins.resize(reader.readSize(sizeof(uint32_t)));
+  for (auto &pin : cell.inputPins) {
+    pin.name = reader.readString();
+    pin.powerFall = reader.readLuts();
+    pin.powerRise = reader.readLuts();
+    pin.capacitance = reader.read<double>();
+    pin.fallCapacitance = reader.read<double>();
+    pin.riseCapacitance = reader.read<double>();
+  }
+
+  cell.outputPins.resize(reader.readSize(sizeof(uint32_t)));
+  for (auto &pin : cell.outputPins) {
+    pin.name = reader.readString();
+    pin.powerFall = reader.readLuts();
+    pin.powerRise = reader.readLuts();
+    pin.maxCapacitance = reader.read<double>();
+    pin.delayFall = reader.readLuts();
+    pin.delayRise = reader.readLuts();
+    pin.slewFall = reader.readLuts();
+    pin.slewRise = reader.readLuts();
+    pin.timingSence = reader.readArray<int>();
+    pin.stringFunction = reader.readString();
+    pin.relatedPins = reader.readStrings();
+    pin.unateness = reader.readArray<Unateness>();
+    pin.compileTimingArcs(cell.inputPins);
+  }
+
+  return cell;
+}
+
+//===----------------------------------------------------------------------===//
+// Library
+//===----------------------------------------------------------------------===//
+
+using CellIndices = std::unordered_map<CellTypeID, uint32_t>;
+
+static void writeCellRefs(
+    SnapshotWriter &writer,
+    const std::vector<std::pair<StandardCell, size_t>> &cells,
+    const CellIndices &indices) {
+  writer.write<uint32_t>(cells.size());
+  for (const auto &[cell, output] : cells) {
+    writer.write<uint32_t>(indices.at(cell.cellTypeID));
+    writer.write<uint64_t>(output);
+  }
+}
+
+static std::vector<std::pair<StandardCell, size_t>> readCellRefs(
+    SnapshotReader &reader,
+    const std::vector<StandardCell> &cells) {
+  std::vector<std::pair<StandardCell, size_t>> refs(
+      reader.readSize(sizeof(uint32_t) + sizeof(uint64_t)));
+  for (auto &[cell, output] : refs) {
+    const auto index = reader.read<uint32_t>();
+    if (index >= cells.size()) {
+      throw std::runtime_error("Invalid library snapshot: cell");
+    }
+    cell = cells[index];
+    output = reader.read<uint64_t>();
+  }
+  return refs;
+}
+
+static void writeCheapCell(
+    SnapshotWriter &writer,
+    const std::pair<const StandardCell*, size_t> &cheapCell,
+    const std::vector<std::pair<StandardCell, size_t>> &cells) {
+  uint32_t index = NullIndex;
+  for (size_t i = 0; i < cells.size(); ++i) {
+    if (&cells[i].first == cheapCell.first) {
+      index = i;
+      break;
+    }
+  }
+  writer.write<uint32_t>(index);
+  writer.write<uint64_t>(cheapCell.second);
+}
+
+static std::pair<const StandardCell*, size_t> readCheapCell(
+    SnapshotReader &reader,
+    const std::vector<std::pair<StandardCell, size_t>> &cells) {
+  const auto index = reader.read<uint32_t>();
+  const auto output = reader.read<uint64_t>();
+  if (index == NullIndex) {
+    return {nullptr, output};
+  }
+  if (index >= cells.size()) {
+    throw std::runtime_error("Invalid library snapshot: cheapest cell");
+  }
+  return {&cells[index].first, output};
+}
+
+static std::vector<std::string> getNames(
+    const std::unordered_set<std::string> &names) {
+  return std::vector<std::string>(names.begin(), names.end());
+}
+
+uint64_t SCLibrarySnapshot::getKey(
+    const std::vector<std::string> &fileNames,
+    const SuperGateGenerator::Settings &settings) {
+  // FNV-1a hash of the file contents.
+  constexpr uint64_t prime = 0x100000001b3ull;
+  uint64_t hash = 0xcbf29ce484222325ull;
+
+  const auto update = [&hash](const char *data, size_t size) {
+    for (size_t i = 0; i < size; ++i) {
+      hash = (hash ^ static_cast<uint8_t>(data[i])) * prime;
+    }
+  };
+
+  std::vector<char> buffer(1 << 16);
+  for (const auto &fileName : fileNames) {
+    std::ifstream in(fileName, std::ios::binary);
+    if (!in.is_open()) {
+      throw std::runtime_error("Failed to open file " + fileName);
+    }
+
+    uint64_t size = 0;
+    while (in) {
+      in.read(buffer.data(), buffer.size());
+      update(buffer.data(), in.gcount());
+      size += in.gcount();
+    }
+    // The file sizes separate the files.
+    update(reinterpret_cast<const char*>(&size), sizeof(size));
+  }
+
+  // The supergates depend on the generation settings.
+  const uint64_t fields[] = {settings.maxInputs, settings.maxDepth,
+                             settings.maxNum};
+  update(reinterpret_cast<const char*>(fields), sizeof(fields));
+  return hash;
+}
+
+void SCLibrarySnapshot::write(const SCLibrary &library,
+                              uint64_t key,
+                              const std::string &fileName) {
+  if (!library.libPrepared) {
+    throw std::runtime_error("Library snapshot requires prepared library");
+  }
+
+  TypeIndices typeIndices;
+  std::vector<CellTypeID> types;
+  CellIndices cellIndices;
+
+  const auto &cells = library.combCells_;
+  for (size_t i = 0; i < cells.size(); ++i) {
+    collectTypes(cells[i].cellTypeID, typeIndices, types);
+    cellIndices.emplace(cells[i].cellTypeID, i);
+  }
+
+  // Write to a temporary file and rename it to make the update atomic.
+  // The name is unique, so concurrent writers do not clash.
+  static std::atomic<uint32_t> counter{0};
+  const std::string tmpName = fileName + "." + std::to_string(getpid()) +
+      "." + std::to_string(counter++) + ".tmp";
+  try {
+    std::ofstream out(tmpName, std::ios::binary);
+    if (!out.is_open()) {
+      throw std::runtime_error("Failed to create library snapshot " + fileName);
+    }
+
+    Header header;
+    std::memcpy(header.magic, Header::Magic, sizeof(header.magic));
+    header.version = Header::Version;
+    header.reserved = 0;
+    header.key = key;
+    header.fileSize = 0; // Updated at the end
+    util::pushIntoStream(out, header);
+
+    SnapshotWriter writer(out);
+
+    writer.write<uint32_t>(types.size());
+    for (const auto typeID : types) {
+      writeType(writer, typeID, typeIndices);
+    }
+
+    writer.write<uint32_t>(cells.size());
+    for (const auto &cell : cells) {
+      writeCell(writer, cell, typeIndices);
+    }
+    writeCellRefs(writer, library.negCombCells_, cellIndices);
+    writeCellRefs(writer, library.constOneCells_, cellIndices);
+    writeCellRefs(writer, library.constZeroCells_, cellIndices);
+
+    const auto &properties = library.properties_;
+    writer.write<uint32_t>(properties.maxArity);
+    writeCheapCell(writer, properties.cheapNegCell, library.negCombCells_);
+    writeCheapCell(writer, properties.cheapOneCell, library.constOneCells_);
+    writeCheapCell(writer, properties.cheapZeroCell, library.constZeroCells_);
+
+    writer.write<uint8_t>(properties.wlmSelection.has_value());
+    if (properties.wlmSelection) {
+      const auto &selection = properties.wlmSelection->wlmFromArea;
+      writer.write<uint32_t>(selection.size());
+      for (const auto &item : selection) {
+        writer.write(item.leftBound);
+        writer.write(item.rightBound);
+        writer.writeString(item.wlmName);
+      }
+    }
+
+    const auto &wires = library.wires_;
+    uint32_t defaultWLM = NullIndex;
+    for (size_t i = 0; i < wires.size(); ++i) {
+      if (&wires[i] == properties.defaultWLM) {
+        defaultWLM = i;
+      }
+    }
+    writer.write<uint32_t>(defaultWLM);
+
+    writer.write<uint32_t>(wires.size());
+    for (const auto &wlm : wires) {
+      writer.writeString(wlm.name);
+      writer.write(wlm.resistance);
+      writer.write(wlm.capacitance);
+      writer.write(wlm.slope);
+      writer.write<uint32_t>(wlm.wireLength.size());
+      for (const auto &item : wlm.wireLength) {
+        writer.write<uint64_t>(item.fanoutCount);
+        writer.write(item.length);
+      }
+    }
+
+    writer.write<uint32_t>(library.templates_.size());
+    for (const auto &lutTemplate : library.templates_) {
+      writer.writeString(lutTemplate.name);
+      writer.writeArray(lutTemplate.variables);
+      writer.write<uint32_t>(lutTemplate.indexes.size());
+      for (const auto &index : lutTemplate.indexes) {
+        writer.writeArray(index);
+      }
+    }
+
+    const auto &collisions = library.collisions_;
+    writer.writeStrings(getNames(collisions.cellNames));
+    writer.writeStrings(getNames(collisions.templateNames));
+    writer.writeStrings(getNames(collisions.wlmNames));
+
+    header.fileSize = out.tellp();
+    out.seekp(0);
+    util::pushIntoStream(out, header);
+    out.close();
+
+    std::filesystem::rename(tmpName, fileName);
+  } catch (...) {
+    std::error_code error;
+    std::filesystem::remove(tmpName, error);
+    throw;
+  }
+}
+
+std::unique_ptr<SCLibrary> SCLibrarySnapshot::load(
+    const std::string &fileName,
+    uint64_t key,
+    const SuperGateGenerator::Settings &settings) {
+  std::error_code error;
+  if (!std::filesystem::exists(fileName, error)) {
+    return nullptr;
+  }
+
+  const MappedFile file(fileName);
+  SnapshotReader reader(file.data, file.data + file.size);
+
+  const auto header = reader.read<Header>();
+  if (std::memcmp(header.magic, Header::Magic, sizeof(header.magic))
+      || header.version != Header::Version
+      || header.fileSize != file.size) {
+    throw std::runtime_error("Invalid library snapshot " + fileName);
+  }
+  if (header.key != key) {
+    return nullptr;
+  }
+
+  std::vector<CellTypeID> types;
+  const auto nTypes = reader.readSize();
+  types.reserve(nTypes);
+  for (size_t i = 0; i < nTypes; ++i) {
+    types.push_back(readType(reader, types));
+  }
+
+  std::unique_ptr<SCLibrary> library(new SCLibrary());
+
+  auto &cells = library->combCells_;
+  cells.resize(reader.readSize(sizeof(uint32_t)));
+  for (auto &cell : cells) {
+    cell = readCell(reader, types);
+  }
+  library->negCombCells_ = readCellRefs(reader, cells);
+  library->constOneCells_ = readCellRefs(reader, cells);
+  library->constZeroCells_ = readCellRefs(reader, cells);
+
+  auto &properties = library->properties_;
+  properties.maxArity = reader.read<uint32_t>();
+  properties.cheapNegCell = readCheapCell(reader, library->negCombCells_);
+  properties.cheapOneCell = readCheapCell(reader, library->constOneCells_);
+  properties.cheapZeroCell = readCheapCell(reader, library->constZeroCells_);
+
+  if (reader.read<uint8_t>()) {
+    WireLoadSelection selection;
+    selection.wlmFromArea.resize(reader.readSize(2 * sizeof(double)));
+    for (auto &item : selection.wlmFromArea) {
+      item.leftBound = reader.read<double>();
+      item.rightBound = reader.read<double>();
+      item.wlmName = reader.readString();
+    }
+    properties.wlmSelection = std::move(selection);
+  }
+
+  const auto defaultWLM = reader.read<uint32_t>();
+
+  auto &wires = library->wires_;
+  wires.resize(reader.readSize(sizeof(uint32_t)));
+  for (auto &wlm : wires) {
+    wlm.name = reader.readString();
+    wlm.resistance = reader.read<double>();
+    wlm.capacitance = reader.read<double>();
+    wlm.slope = reader.read<double>();
+    wlm.wireLength.resize(
+        reader.readSize(sizeof(uint64_t) + sizeof(double)));
+    for (auto &item : wlm.wireLength) {
+      item.fanoutCount = reader.read<uint64_t>();
+      item.length = reader.read<double>();
+    }
+  }
+  if (defaultWLM != NullIndex) {
+    if (defaultWLM >= wires.size()) {
+      throw std::runtime_error("Invalid library snapshot: default WLM");
+    }
+    properties.defaultWLM = &wires[defaultWLM];
+  }
+
+  library->templates_.resize(reader.readSize(sizeof(uint32_t)));
+  for (auto &lutTemplate : library->templates_) {
+    lutTemplate.name = reader.readString();
+    lutTemplate.variables = reader.readArray<LutTemplate::NameID>();
+    lutTemplate.indexes.resize(reader.readSize(sizeof(uint32_t)));
+    for (auto &index : lutTemplate.indexes) {
+      index = reader.readArray<double>();
+    }
+  }
+
+  auto &collisions = library->collisions_;
+  for (const auto &name : reader.readStrings()) {
+    collisions.cellNames.insert(name);
+  }
+  for (const auto &name : reader.readStrings()) {
+    collisions.templateNames.insert(name);
+  }
+  for (const auto &name : reader.readStrings()) {
+    collisions.wlmNames.insert(name);
+  }
+
+  if (!reader.isEnd()) {
+    throw std::runtime_error("Invalid library snapshot " + fileName);
+  }
+
+  library->setSuperGateSettings(settings);
+  library->fillSearchMap();
+  library->libPrepared = true;
+  return library;
+}
+
+std::unique_ptr<SCLibrary> loadLibrary(
+    const std::vector<std::string> &fileNames,
+    const std::string &snapshotFileName,
+    const SuperGateGenerator::Settings &superGateSettings) {
+  const auto key = snapshotFileName.empty()
+      ? 0 : SCLibrarySnapshot::getKey(fileNames, superGateSettings);
+
+  if (!snapshotFileName.empty()) {
+    try {
+      if (auto library = SCLibrarySnapshot::load(snapshotFileName, key,
+                                                 superGateSettings)) {
+        return library;
+      }
+    } catch (const std::runtime_error &) {
+      // Fall back to the Liberty files (e.g., the snapshot is corrupted).
+    }
+  }
+
+  auto library = SCLibraryFactory::newLibraryUPtr();
+  for (const auto &fileName : fileNames) {
+    ReadCellsParser parser(fileName);
+    if (!SCLibraryFactory::fillLibrary(*library, parser)) {
+      throw std::runtime_error("Failed to fill library from " + fileName);
+    }
+  }
+  library->setSuperGateSettings(superGateSettings);
+  library->prepareLib();
+
+  if (!snapshotFileName.empty()) {
+    try {
+      SCLibrarySnapshot::write(*library, key, snapshotFileName);
+    } catch (const std::exception &) {
+      // The snapshot is just a cache: the directory may be read-only.
+    }
+  }
+
+  return library;
+}
+
+} // namespace eda::gate::library
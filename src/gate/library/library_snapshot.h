@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "gate/library/library.h"
+#include "gate/library/supergate_generator.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace eda::gate::library {
+
+/// Header of a prepared library snapshot.
+struct SCLibrarySnapshotHeader final {
+  static constexpr char Magic[8] = {'U', 'T', 'L', 'I', 'B', 'S', 'N', 'P'};
+  static constexpr uint32_t Version = 2;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t reserved;
+  /// Hash of the Liberty files the library has been loaded from.
+  uint64_t key;
+  uint64_t fileSize;
+};
+static_assert(sizeof(SCLibrarySnapshotHeader) == 32);
+
+/**
+ * \brief Binary snapshot of a prepared library (see SCLibrary::prepareLib()).
+ *
+ * | Header | Cell types | Cells | Properties | WLMs | Templates | Names |
+ *
+ * The snapshot stores the library cells (including the supercells, the
+ * supergates, and the cells completing the P-classes) w/ their canonical
+ * truth tables and transformations as well as the cell types implementing
+ * them. The cell type subnets are stored as raw entries: the library cell
+ * types are referred to by their indices in the snapshot, the gates are
+ * referred to by their symbols. The compiled LUTs are rebuilt on loading
+ * (it is cheap compared to parsing and canonization).
+ *
+ * The snapshot is validated on loading (the sizes, the type references, the
+ * cell arities, and the links), so a corrupted snapshot causes an exception
+ * rather than undefined behavior.
+ *
+ * The snapshot is keyed by the hash of the Liberty file contents and the
+ * supergate settings, so it is ignored if any of the files or the settings
+ * has been changed.
+ */
+class SCLibrarySnapshot final {
+public:
+  /// Computes the key of the given Liberty files (order-dependent) and
+  /// the supergate settings.
+  static uint64_t getKey(const std::vector<std::string> &fileNames,
+                         const SuperGateGenerator::Settings &settings = {});
+
+  /// Writes the snapshot of the prepared library.
+  static void write(const SCLibrary &library,
+                    uint64_t key,
+                    const std::string &fileName);
+
+  /// Maps the snapshot and loads the prepared library from it.
+  /// Returns nullptr if there is no snapshot or it has a different key;
+  /// throws if the snapshot is invalid.
+  static std::unique_ptr<SCLibrary> load(
+      const std::string &fileName,
+      uint64_t key,
+      const SuperGateGenerator::Settings &settings = {});
+};
+
+/**
+ * \brief Loads and prepares the library described by the Liberty files.
+ *
+ * The snapshot file (if specified) is used as a cache: it is loaded if it
+ * is valid and matches the files; otherwise, the files are parsed, the
+ * library is prepared w/ the given supergate settings, and the snapshot is
+ * (re)written (if possible).
+ */
+std::unique_ptr<SCLibrary> loadLibrary(
+    const std::vector<std::string> &fileNames,
+    const std::string &snapshotFileName,
+    const SuperGateGenerator::Settings &superGateSettings = {});
+
+} // namespace eda::gate::library
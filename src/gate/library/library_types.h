@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "gate/library/compiled_lut.h"
 #include "gate/model/celltype.h"
 #include "kitty/dynamic_truth_table.hpp"
 #include "util/double_math.h"
@@ -160,6 +161,13 @@ namespace eda::gate::library {
     }
   };
 
+  /// Unateness of an output function in an input.
+  enum class Unateness : uint8_t {
+    Positive,
+    Negative,
+    Binate
+  };
+
   struct Pin {
     std::string name;
     std::vector<LUT> powerFall, powerRise;
@@ -177,9 +185,42 @@ namespace eda::gate::library {
     double maxCapacitance = 0.0;
     std::vector<LUT> delayFall, delayRise;
     std::vector<LUT> slewFall, slewRise;
+    /// Timing LUTs compiled for estimation (see compileTimingArcs()).
+    std::vector<CompiledTimingArc> timingArcs;
 
     std::vector<int> timingSence; //TODO: probably used incorrectly
     std::string stringFunction; //TODO: probably should not be like that
+
+    /// Related input pins of the timing arcs.
+    std::vector<std::string> relatedPins;
+    /// Indices of the related input pins of the timing arcs (-1 if unknown).
+    std::vector<int16_t> timingArcInputs;
+    /// Unateness of the pin function in the cell inputs.
+    std::vector<Unateness> unateness;
+
+    /// Compiles the delay/slew LUTs of the timing arcs (on library load).
+    void compileTimingArcs(const std::vector<InputPin> &inputPins) {
+      static const LUT empty{};
+      const auto get = [](const std::vector<LUT> &luts, size_t i)
+          -> const LUT& { return i < luts.size() ? luts[i] : empty; };
+
+      timingArcs.clear();
+      timingArcs.reserve(delayFall.size());
+      for (size_t i = 0; i < delayFall.size(); ++i) {
+        timingArcs.emplace_back(get(delayFall, i), get(delayRise, i),
+                                get(slewFall, i), get(slewRise, i));
+      }
+
+      timingArcInputs.assign(delayFall.size(), -1);
+      for (size_t i = 0; i < delayFall.size() && i < relatedPins.size(); ++i) {
+        for (size_t j = 0; j < inputPins.size(); ++j) {
+          if (inputPins[j].name == relatedPins[i]) {
+            timingArcInputs[i] = j;
+            break;
+          }
+        }
+      }
+    }
   };
 
 } // namespace eda::gate::library
\ No newline at end of file
@@ -236,6 +236,8 @@ static bool parseOutputPin(const readcells::AttributeList &rcPin,
       setLut(out.slewRise, "rise_transition", *timing);
       out.timingSence.push_back(
         timing->getIntegerAttribute("timing_sense", 0));
+      out.relatedPins.push_back(
+        std::string(timing->getStringAttribute("related_pin", "")));
     }
   }
 
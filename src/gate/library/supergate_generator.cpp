@@ -0,0 +1,481 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/library/supergate_generator.h"
+#include "gate/model/subnet.h"
+#include "gate/model/utils/subnet_truth_table.h"
+#include "util/kitty_utils.h"
+#include "util/npn_canonization.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <functional>
+
+namespace eda::gate::library {
+
+using Link = model::Subnet::Link;
+using LinkList = model::Subnet::LinkList;
+
+/// Maximum number of variables stored in a 64-bit word.
+static constexpr uint16_t MaxVars = 6;
+
+static uint64_t getMask(const uint16_t nVars) {
+  return nVars >= MaxVars ? ~0ull : (1ull << (1u << nVars)) - 1;
+}
+
+/// Packs the number of variables and the function into a key.
+static uint64_t makeKey(const uint16_t nVars, const uint64_t tt) {
+  return nVars < MaxVars ? (tt | (1ull << (1u << nVars))) : tt;
+}
+
+static uint64_t getWord(const kitty::dynamic_truth_table &tt) {
+  return tt.num_blocks() ? tt._bits[0] & getMask(tt.num_vars()) : 0;
+}
+
+/// Returns the projection function of the variable.
+static uint64_t getVar(const uint16_t var, const uint16_t nVars) {
+  uint64_t tt = 0;
+  for (uint64_t x = 0; x < (1ull << nVars); ++x) {
+    tt |= ((x >> var) & 1) << x;
+  }
+  return tt;
+}
+
+/// Moves the variables of the function to [offset, offset + m).
+static uint64_t shift(const uint64_t f,
+                      const uint16_t m,
+                      const uint16_t offset,
+                      const uint16_t nVars) {
+  uint64_t tt = 0;
+  for (uint64_t x = 0; x < (1ull << nVars); ++x) {
+    tt |= ((f >> ((x >> offset) & ((1ull << m) - 1))) & 1) << x;
+  }
+  return tt;
+}
+
+static float getArea(const StandardCell &cell) {
+  return model::CellType::get(cell.cellTypeID).getAttr().getPhysProps().area;
+}
+
+/// Estimates the gate delay: the worst arc for the zero input slew and
+/// the load equal to the average input capacitance of the gate.
+static float getDelay(const StandardCell &cell) {
+  double load = 0.;
+  for (const auto &pin : cell.inputPins) {
+    load += pin.capacitance;
+  }
+  if (!cell.inputPins.empty()) {
+    load /= cell.inputPins.size();
+  }
+
+  double delay = 0.;
+  for (const auto &pin : cell.outputPins) {
+    for (const auto &arc : pin.timingArcs) {
+      delay = std::max(delay, arc.getValue(0., load).delay);
+    }
+  }
+  return delay;
+}
+
+/// Returns the indices of the timing arcs related to the input pin (the arcs
+/// w/ unknown related pins are applied to all the inputs).
+static std::vector<size_t> getArcs(const OutputPin &pin, const size_t input) {
+  std::vector<size_t> arcs;
+  for (size_t i = 0; i < pin.timingArcs.size(); ++i) {
+    const auto related =
+        i < pin.timingArcInputs.size() ? pin.timingArcInputs[i] : -1;
+    if (related < 0 || static_cast<size_t>(related) == input) {
+      arcs.push_back(i);
+    }
+  }
+  return arcs;
+}
+
+/// Estimates the delay of the arcs related to the input pin for the zero
+/// input slew and the given load.
+static float getDelay(const StandardCell &cell,
+                      const size_t input,
+                      const double load) {
+  double delay = 0.;
+  for (const auto i : getArcs(cell.outputPins[0], input)) {
+    delay = std::max(delay,
+        cell.outputPins[0].timingArcs[i].getValue(0., load).delay);
+  }
+  return delay;
+}
+
+static Unateness getUnateness(const StandardCell &cell, const size_t input) {
+  const auto &unateness = cell.outputPins[0].unateness;
+  return input < unateness.size() ? unateness[input] : Unateness::Binate;
+}
+
+/// Composes the unateness of the gates along a path.
+static Unateness compose(const Unateness lhs, const Unateness rhs) {
+  if (lhs == Unateness::Binate || rhs == Unateness::Binate) {
+    return Unateness::Binate;
+  }
+  return lhs == rhs ? Unateness::Positive : Unateness::Negative;
+}
+
+static LUT shift(const LUT &lut, const double offset) {
+  LUT result = lut;
+  for (auto &value : result.values) {
+    value += offset;
+  }
+  return result;
+}
+
+/// Checks whether (area, delay) is not better than (lhsArea, lhsDelay).
+static bool isDominated(const float lhsArea,
+                        const float lhsDelay,
+                        const float area,
+                        const float delay) {
+  return lhsArea <= area && lhsDelay <= delay;
+}
+
+SuperGateGenerator::SuperGateGenerator(const std::vector<StandardCell> &cells,
+                                       const Settings &settings):
+    settings(settings) {
+  init(cells);
+}
+
+void SuperGateGenerator::init(const std::vector<StandardCell> &cells) {
+  const auto maxInputs = std::min(settings.maxInputs, MaxVars);
+
+  // The cheapest elementary gate for each function.
+  std::unordered_map<uint64_t, size_t> gateOf;
+
+  for (const auto &cell : cells) {
+    const auto &type = model::CellType::get(cell.cellTypeID);
+    const auto area = getArea(cell);
+    const auto delay = getDelay(cell);
+
+    if (std::isnan(area)) {
+      continue;
+    }
+
+    for (const auto &ctt : cell.ctt) {
+      if (ctt.num_vars() > maxInputs) {
+        continue;
+      }
+      fronts[makeKey(ctt.num_vars(), getWord(ctt))].push_back(
+          Point{area, delay, -1});
+    }
+
+    // Composite cells (supercells, etc.) are not elementary.
+    if (!type.isSubnet() || type.getSubnet().isTechMapped()) {
+      continue;
+    }
+    const auto nInputs = type.getInNum();
+    if (type.getOutNum() != 1 || nInputs == 0 || nInputs > maxInputs) {
+      continue;
+    }
+
+    const auto tt = getWord(model::evaluate(type.getSubnet())[0]);
+    // Buffers and constants are useless in supergates.
+    if ((nInputs == 1 && tt == getVar(0, 1)) || tt == 0 ||
+        tt == getMask(nInputs)) {
+      continue;
+    }
+
+    const auto key = makeKey(nInputs, tt);
+    const auto i = gateOf.find(key);
+    if (i != gateOf.end()) {
+      auto &gate = gates[i->second];
+      if (gate.area < area || (gate.area == area && gate.delay <= delay)) {
+        continue;
+      }
+      gate.cell = &cell;
+      gate.area = area;
+      gate.delay = delay;
+      continue;
+    }
+
+    gateOf.emplace(key, gates.size());
+    gates.push_back(Gate{gates.size(), &cell,
+                         std::vector<int32_t>(nInputs, -1), tt, nInputs, 1,
+                         area, delay});
+  }
+
+  nElementary = gates.size();
+}
+
+void SuperGateGenerator::expand(const size_t root, const uint16_t depth) {
+  std::vector<int32_t> fanins;
+  fanins.reserve(gates[root].nInputs);
+  expand(root, depth, fanins, 0, false);
+}
+
+void SuperGateGenerator::expand(const size_t root,
+                                const uint16_t depth,
+                                std::vector<int32_t> &fanins,
+                                const uint16_t nInputs,
+                                const bool isDeep) {
+  if (nGenerated >= settings.maxNum) {
+    return;
+  }
+
+  // The gate list grows during the enumeration (no references are kept).
+  const auto arity = gates[root].nInputs;
+
+  if (fanins.size() == arity) {
+    if (!isDeep) {
+      return;
+    }
+    const auto &rootGate = gates[root];
+    Gate gate{root, rootGate.cell, fanins, 0, nInputs, depth,
+              rootGate.area, 0.};
+    float delay = 0.;
+    for (const auto fanin : fanins) {
+      if (fanin >= 0) {
+        gate.area += gates[fanin].area;
+        delay = std::max(delay, gates[fanin].delay);
+      }
+    }
+    gate.delay = rootGate.delay + delay;
+    gate.tt = evaluate(gate);
+    add(std::move(gate));
+    return;
+  }
+
+  // Each of the remaining pins requires at least one input.
+  const auto maxInputs = std::min(settings.maxInputs, MaxVars);
+  const uint16_t nRemaining = arity - fanins.size() - 1;
+  if (nInputs + nRemaining + 1 > maxInputs) {
+    return;
+  }
+
+  // The pin is a supergate input.
+  fanins.push_back(-1);
+  expand(root, depth, fanins, nInputs + 1, isDeep);
+  fanins.pop_back();
+
+  // The pin is driven by a gate of a smaller depth.
+  for (size_t i = 0; i < gates.size(); ++i) {
+    const auto faninDepth = gates[i].depth;
+    const auto faninInputs = gates[i].nInputs;
+    if (faninDepth >= depth) {
+      continue;
+    }
+    if (nInputs + nRemaining + faninInputs > maxInputs) {
+      continue;
+    }
+    fanins.push_back(static_cast<int32_t>(i));
+    expand(root, depth, fanins, nInputs + faninInputs,
+           isDeep || faninDepth + 1 == depth);
+    fanins.pop_back();
+  }
+}
+
+uint64_t SuperGateGenerator::evaluate(const Gate &gate) const {
+  const auto &root = gates[gate.root];
+
+  // Functions of the root pins over the supergate inputs.
+  std::vector<uint64_t> pins(gate.fanins.size());
+  uint16_t offset = 0;
+  for (size_t j = 0; j < gate.fanins.size(); ++j) {
+    if (gate.fanins[j] < 0) {
+      pins[j] = getVar(offset++, gate.nInputs);
+    } else {
+      const auto &fanin = gates[gate.fanins[j]];
+      pins[j] = shift(fanin.tt, fanin.nInputs, offset, gate.nInputs);
+      offset += fanin.nInputs;
+    }
+  }
+  assert(offset == gate.nInputs);
+
+  uint64_t tt = 0;
+  for (uint64_t x = 0; x < (1ull << gate.nInputs); ++x) {
+    uint64_t y = 0;
+    for (size_t j = 0; j < pins.size(); ++j) {
+      y |= ((pins[j] >> x) & 1) << j;
+    }
+    tt |= ((root.tt >> y) & 1) << x;
+  }
+  return tt;
+}
+
+void SuperGateGenerator::add(Gate &&gate) {
+  kitty::dynamic_truth_table tt(gate.nInputs);
+  kitty::create_from_words(tt, &gate.tt, &gate.tt + 1);
+  const auto ctt = util::getTT(util::pCanonization(tt));
+
+  auto &front = fronts[makeKey(gate.nInputs, getWord(ctt))];
+  for (const auto &point : front) {
+    if (isDominated(point.area, point.delay, gate.area, gate.delay)) {
+      return;
+    }
+  }
+
+  front.erase(std::remove_if(front.begin(), front.end(),
+      [&gate](const Point &point) {
+        return isDominated(gate.area, gate.delay, point.area, point.delay);
+      }), front.end());
+
+  front.push_back(Point{gate.area, gate.delay,
+                        static_cast<int32_t>(gates.size())});
+  gates.push_back(std::move(gate));
+  nGenerated++;
+}
+
+StandardCell SuperGateGenerator::makeCell(const Gate &gate) const {
+  StandardCell cell;
+  model::SubnetBuilder builder;
+  const auto inputs = builder.addInputs(gate.nInputs);
+
+  // Path from a supergate input to the output.
+  struct Path final {
+    /// Root gate pin the path enters the root through.
+    size_t rootPin;
+    /// Delay of the non-root gates along the path.
+    double delay;
+    Unateness unateness;
+  };
+  std::vector<Path> paths;
+
+  float power = 0.;
+  size_t next = 0;
+
+  // The load is the input capacitance of the pin driven by the gate.
+  std::function<Link(const Gate&, const Path&, double, std::string&)> build =
+      [&](const Gate &current, const Path &path, const double load,
+          std::string &name) {
+    const auto &root = *gates[current.root].cell;
+    const bool isRoot = (&current == &gate);
+    power += std::isnan(root.propertyLeakagePower)
+        ? 0. : root.propertyLeakagePower;
+
+    name += root.name + "(";
+    LinkList links;
+    for (size_t j = 0; j < current.fanins.size(); ++j) {
+      if (j > 0) {
+        name += ",";
+      }
+      // The root gate delay is taken into account by its timing arcs.
+      const Path pinPath{isRoot ? j : path.rootPin,
+                         isRoot ? 0. : path.delay + getDelay(root, j, load),
+                         compose(path.unateness, getUnateness(root, j))};
+      if (current.fanins[j] < 0) {
+        auto pin = root.inputPins[j];
+        pin.name = "I" + std::to_string(next);
+        cell.inputPins.push_back(std::move(pin));
+        paths.push_back(pinPath);
+        links.push_back(inputs[next++]);
+        name += "*";
+      } else {
+        links.push_back(build(gates[current.fanins[j]], pinPath,
+                              root.inputPins[j].capacitance, name));
+      }
+    }
+    name += ")";
+    return builder.addCell(root.cellTypeID, links);
+  };
+
+  std::string name;
+  builder.addOutput(build(gate, Path{0, 0., Unateness::Positive}, 0., name));
+  const auto subnetID = builder.make();
+
+  // The timing arcs of a supergate input are the arcs of the root pin on
+  // the path shifted by the delay of the other gates along the path (they
+  // are estimated for the zero input slew and the actual pin loads).
+  const auto &rootPin = gate.cell->outputPins[0];
+  OutputPin outputPin;
+  outputPin.name = rootPin.name;
+  outputPin.powerFall = rootPin.powerFall;
+  outputPin.powerRise = rootPin.powerRise;
+  outputPin.maxCapacitance = rootPin.maxCapacitance;
+
+  static const LUT empty{};
+  const auto get = [](const std::vector<LUT> &luts, size_t i) -> const LUT& {
+    return i < luts.size() ? luts[i] : empty;
+  };
+
+  for (size_t k = 0; k < paths.size(); ++k) {
+    const auto &path = paths[k];
+    for (const auto i : getArcs(rootPin, path.rootPin)) {
+      outputPin.delayFall.push_back(shift(get(rootPin.delayFall, i),
+                                          path.delay));
+      outputPin.delayRise.push_back(shift(get(rootPin.delayRise, i),
+                                          path.delay));
+      outputPin.slewFall.push_back(get(rootPin.slewFall, i));
+      outputPin.slewRise.push_back(get(rootPin.slewRise, i));
+      if (i < rootPin.timingSence.size()) {
+        outputPin.timingSence.push_back(rootPin.timingSence[i]);
+      }
+      outputPin.relatedPins.push_back(cell.inputPins[k].name);
+    }
+    outputPin.unateness.push_back(path.unateness);
+  }
+  outputPin.compileTimingArcs(cell.inputPins);
+  cell.outputPins.push_back(std::move(outputPin));
+
+  model::PhysicalProperties props;
+  props.area = gate.area;
+  props.delay = gate.delay;
+  props.power = power;
+
+  model::CellType::PortVector ports;
+  size_t index{0};
+  for (const auto &pin : cell.inputPins) {
+    ports.emplace_back(pin.name, 1, true, index++);
+  }
+  ports.emplace_back(cell.outputPins[0].name, 1, false, index++);
+  const auto attrID = model::makeCellTypeAttr(ports);
+  model::CellTypeAttr::get(attrID).setPhysProps(props);
+
+  cell.cellTypeID = model::makeCellType(
+      model::CellSymbol::UNDEF,
+      name,
+      subnetID,
+      attrID,
+      model::CellProperties{1, 0, 1, 0, 0, 0, 0, 0, 0},
+      gate.nInputs,
+      1);
+
+  kitty::dynamic_truth_table tt(gate.nInputs);
+  kitty::create_from_words(tt, &gate.tt, &gate.tt + 1);
+  const auto config = util::pCanonization(tt);
+  cell.ctt.push_back(util::getTT(config));
+  cell.transform.push_back(util::getTransformation(config));
+
+  cell.propertyArea = props.area;
+  cell.propertyDelay = props.delay;
+  cell.propertyLeakagePower = props.power;
+  cell.name = name;
+  return cell;
+}
+
+std::vector<StandardCell> SuperGateGenerator::generate() {
+  for (uint16_t depth = 2; depth <= settings.maxDepth; ++depth) {
+    // The gates of the previous depths are fixed during the iteration.
+    for (size_t root = 0; root < nElementary; ++root) {
+      expand(root, depth);
+    }
+  }
+
+  // The supergates dominated by the later ones are dropped.
+  std::vector<bool> isOnFront(gates.size(), false);
+  for (const auto &[key, front] : fronts) {
+    for (const auto &point : front) {
+      if (point.gate >= 0) {
+        isOnFront[point.gate] = true;
+      }
+    }
+  }
+
+  std::vector<StandardCell> result;
+  for (size_t i = nElementary; i < gates.size(); ++i) {
+    if (isOnFront[i]) {
+      result.push_back(makeCell(gates[i]));
+    }
+  }
+  return result;
+}
+
+} // namespace eda::gate::library
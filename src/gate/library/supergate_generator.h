@@ -0,0 +1,114 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "gate/library/library_types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace eda::gate::library {
+
+/**
+ * \brief Generates supergates: trees of library gates w/ a few inputs.
+ *
+ * The elementary gates are the cheapest single-output library cells of each
+ * function. A supergate of depth d is an elementary gate whose inputs are
+ * either supergate inputs or supergates of depth < d (the inputs are not
+ * shared, so a supergate is a tree). The supergate area is the sum of the
+ * gate areas; the delay is the sum of the gate delays along the longest
+ * path (each gate delay is estimated by the NLDM tables for the zero input
+ * slew and the load of the gate input capacitance).
+ *
+ * For each canonical function (P-class), only the supergates that are not
+ * dominated by (area, delay) by the library cells or by other supergates
+ * are kept. The generated cells are composite: they are implemented by the
+ * subnets of the library cells and are inlined by the mapper.
+ *
+ * The timing arcs of a supergate input are the arcs of the root gate pin on
+ * the path from the input shifted by the delay of the other gates along the
+ * path, so the mapper estimates a supergate by its tree delay.
+ */
+class SuperGateGenerator final {
+public:
+  struct Settings final {
+    /// Maximum number of the supergate inputs.
+    uint16_t maxInputs{4};
+    /// Maximum number of the gate levels (1 disables the generation).
+    uint16_t maxDepth{2};
+    /// Maximum number of the generated supergates.
+    size_t maxNum{1000};
+  };
+
+  /// The cells are the library cells (the existing supergates included).
+  SuperGateGenerator(const std::vector<StandardCell> &cells,
+                     const Settings &settings);
+
+  /// Generates the non-dominated supergates.
+  std::vector<StandardCell> generate();
+
+private:
+  struct Gate final {
+    /// Root elementary gate index (the gate itself for the elementary ones).
+    size_t root;
+    /// Root library cell.
+    const StandardCell *cell;
+    /// Fanin gate indices (-1 stands for a supergate input).
+    std::vector<int32_t> fanins;
+    /// Function (the variables are the inputs in the depth-first order).
+    uint64_t tt;
+    uint16_t nInputs;
+    uint16_t depth;
+    float area;
+    float delay;
+  };
+
+  /// Non-dominated implementation of a function (gate is -1 for cells).
+  struct Point final {
+    float area;
+    float delay;
+    int32_t gate;
+  };
+
+  using Front = std::vector<Point>;
+
+  /// Collects the elementary gates and the library cell fronts.
+  void init(const std::vector<StandardCell> &cells);
+
+  /// Enumerates the supergates of the given depth rooted at the gate.
+  void expand(size_t root, uint16_t depth);
+  void expand(size_t root,
+              uint16_t depth,
+              std::vector<int32_t> &fanins,
+              uint16_t nInputs,
+              bool isDeep);
+
+  /// Adds the supergate if it is not dominated.
+  void add(Gate &&gate);
+
+  /// Computes the supergate function.
+  uint64_t evaluate(const Gate &gate) const;
+
+  /// Builds the library cell for the supergate.
+  StandardCell makeCell(const Gate &gate) const;
+
+  const Settings settings;
+
+  /// Elementary gates go first; then the supergates.
+  std::vector<Gate> gates;
+  size_t nElementary{0};
+  size_t nGenerated{0};
+
+  /// Non-dominated implementations of the canonical functions.
+  std::unordered_map<uint64_t, Front> fronts;
+};
+
+} // namespace eda::gate::library
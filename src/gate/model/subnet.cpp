@@ -8,6 +8,7 @@
 
 #include "gate/model/printer/net_printer.h"
 #include "gate/model/subnet.h"
+#include "gate/model/subnet_npn_view.h"
 #include "gate/model/subnetview.h"
 
 #include <cmath>
@@ -439,6 +440,21 @@ void fillMapping<SubnetBuilder>(const SubnetBuilder &rhs,
 }
 //-- FIXME:
 
+template <>
+void fillMapping<SubnetNpnView>(const SubnetNpnView &rhs,
+                                const InOutMapping &iomapping,
+                                SubnetBuilder::EntryToEntry &rhsToLhs) {
+  assert(rhs.getInNum() == iomapping.getInNum());
+  assert(rhs.getOutNum() == iomapping.getOutNum());
+
+  for (SubnetSz i = 0; i < iomapping.getInNum(); ++i) {
+    rhsToLhs[rhs.getInIdx(i)] = iomapping.getIn(i).idx;
+  }
+  for (SubnetSz i = 0; i < iomapping.getOutNum(); ++i) {
+    rhsToLhs[rhs.getOutIdx(i)] = iomapping.getOut(i).idx;
+  }
+}
+
 template <>
 void fillMapping<SubnetView>(const SubnetView &rhs,
                              const InOutMapping &iomapping,
@@ -540,6 +556,27 @@ void SubnetBuilder::replace(
       onRecomputedDepth);
 }
 
+void SubnetBuilder::replace(
+    const SubnetNpnView &rhs,
+    const InOutMapping &iomapping,
+    const CellActionCallback *onNewCell,
+    const CellActionCallback *onEqualDepth,
+    const CellActionCallback *onGreaterDepth,
+    const CellActionCallback *onRecomputedDepth) {
+
+  using RhsIt = SubnetNpnView::Iterator;
+
+  EntryToEntry rhsToLhs;
+  replace<SubnetNpnView, SubnetNpnView, RhsIt>(
+    rhs, rhs, rhs.getOutIdx(0), iomapping, rhsToLhs,
+    [&](RhsIt iter, EntryID i) {
+      return *iter;
+    },
+    nullptr /* weight provider */, onNewCell, onEqualDepth, onGreaterDepth,
+    onRecomputedDepth
+  );
+}
+
 template <typename RhsContainer, typename RhsIterable, typename RhsIt>
 void SubnetBuilder::replace(
     const RhsContainer &rhsContainer,
@@ -697,6 +734,14 @@ SubnetBuilder::Effect SubnetBuilder::evaluateReplace(
       weightModifier);
 }
 
+SubnetBuilder::Effect SubnetBuilder::evaluateReplace(
+    const SubnetNpnView &rhs,
+    const InOutMapping &iomapping,
+    const CellWeightModifier *weightModifier) const {
+  assert(!weightModifier && "Weight modifier is used w/o weight provider");
+  return evaluateReplace<SubnetNpnView>(rhs, iomapping, nullptr, nullptr);
+}
+
 template <typename RhsContainer>
 SubnetBuilder::Effect SubnetBuilder::evaluateReplace(
     const RhsContainer &rhsContainer,
@@ -801,6 +846,26 @@ SubnetBuilder::Effect SubnetBuilder::newEntriesEval(
   );
 }
 
+SubnetBuilder::Effect SubnetBuilder::newEntriesEval(
+    const SubnetNpnView &rhs,
+    const InOutMapping &iomapping,
+    std::unordered_set<EntryID> &reusedLhsEntries,
+    std::unordered_map<EntryID, uint32_t> &entryNewRefcount,
+    const CellWeightProvider *weightProvider,
+    const CellWeightModifier *weightModifier) const {
+
+  using RhsIt = SubnetNpnView::Iterator;
+
+  EntryToEntry rhsToLhs;
+  return newEntriesEval<SubnetNpnView, SubnetNpnView, RhsIt>(
+    rhs, rhs, iomapping, rhsToLhs,
+    [&](RhsIt iter, EntryID i) {
+      return *iter;
+    },
+    reusedLhsEntries, entryNewRefcount, weightProvider, weightModifier
+  );
+}
+
 template <typename RhsContainer>
 float SubnetBuilder::incOldLinksRefcnt(
     const RhsContainer &rhsContainer,
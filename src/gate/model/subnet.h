@@ -296,6 +296,7 @@ struct std::hash<eda::gate::model::StrashKey> {
 
 namespace eda::gate::model {
 
+class SubnetNpnView;
 class SubnetView;
 
 class SubnetBuilder final {
@@ -732,6 +733,17 @@ public:
       const CellActionCallback *onGreaterDepth = nullptr,
       const CellActionCallback *onRecomputedDepth = nullptr);
 
+  /// Replaces the given single-output fragment w/ the NPN-transformed subnet
+  /// (rhs) w/o allocating the transformed subnet.
+  /// Precondition: cell arities <= Cell::InPlaceLinks.
+  void replace(
+      const SubnetNpnView &rhs,
+      const InOutMapping &iomapping,
+      const CellActionCallback *onNewCell = nullptr,
+      const CellActionCallback *onEqualDepth = nullptr,
+      const CellActionCallback *onGreaterDepth = nullptr,
+      const CellActionCallback *onRecomputedDepth = nullptr);
+
   /// Returns the effect of the replacement with rhs.
   Effect evaluateReplace(
       const SubnetObject &rhs,
@@ -757,6 +769,12 @@ public:
       const InOutMapping &iomapping,
       const CellWeightModifier *weightModifier = nullptr) const;
 
+  /// Returns the effect of the replacement with the NPN-transformed subnet.
+  Effect evaluateReplace(
+      const SubnetNpnView &rhs,
+      const InOutMapping &iomapping,
+      const CellWeightModifier *weightModifier = nullptr) const;
+
   /// Replaces the given cell w/ the new one. Recursively deletes the cells
   /// from the transitive fanin cone whose reference counts have become zero
   /// (if @param delZeroRefcount is set).
@@ -778,6 +796,9 @@ public:
   /// Replaces the given cells w/ one.
   void replaceWithOne(const EntrySet &entryIDs);
 
+  /// Checks whether fanouts receiving by entry index is enabled.
+  bool areFanoutsEnabled() const { return fanoutsEnabled; }
+
   /// Enables fanouts receiving by entry index.
   void enableFanouts();
 
@@ -890,6 +911,16 @@ private:
       const CellWeightProvider *weightProvider,
       const CellWeightModifier *weightModifier) const;
 
+  /// Returns the add-effect of the replacement:
+  /// the number of cells (value of weight) added and new depth of the root.
+  Effect newEntriesEval(
+      const SubnetNpnView &rhs,
+      const InOutMapping &iomapping,
+      std::unordered_set<EntryID> &reusedLhsEntries,
+      std::unordered_map<EntryID, uint32_t> &entryNewRefcount,
+      const CellWeightProvider *weightProvider,
+      const CellWeightModifier *weightModifier) const;
+
   /// Returns the add-effect of the replacement:
   /// the number of cells (value of weight) added and new depth of the root.
   Effect newEntriesEval(
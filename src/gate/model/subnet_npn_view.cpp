@@ -0,0 +1,52 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/model/subnet_npn_view.h"
+
+namespace eda::gate::model {
+
+SubnetNpnView::SubnetNpnView(const Subnet &subnet,
+                             const NpnTransformation &t,
+                             uint16_t nInUsed):
+    subnet(subnet),
+    negationMask(t.negationMask),
+    nIn(t.permutation.size()) {
+
+  assert(nIn <= MaxIn && nIn <= subnet.getInNum());
+  assert(subnet.getOutNum() == 1);
+
+#ifndef NDEBUG
+  // The links are read from the cells (the link entries are not supported).
+  const auto &entries = subnet.getEntries();
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const auto &cell = entries[i].cell;
+    assert(cell.arity <= Cell::InPlaceLinks && "Link entries are unsupported");
+    i += cell.more;
+  }
+#endif // NDEBUG
+
+  // The same input order as in util::npnTransform.
+  const uint16_t notUsed = nIn <= nInUsed ? 0 : nIn - nInUsed;
+  this->nInUsed = nIn - notUsed;
+
+  uint16_t inputID = this->nInUsed;
+  uint16_t nRemoved = 0;
+  for (size_t j = nIn; j > 0; --j) {
+    const EntryID i = t.permutation[j - 1];
+    if (subnet.getCell(i).refcount || nRemoved == notUsed) {
+      inputs[--inputID] = i;
+    } else {
+      nRemoved++;
+    }
+  }
+
+  assert(inputID == 0 && nRemoved == notUsed &&
+         "Subnet depends on more variables than was specified");
+}
+
+} // namespace eda::gate::model
@@ -0,0 +1,151 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "gate/model/subnet.h"
+#include "util/npn_transformation.h"
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+namespace eda::gate::model {
+
+/**
+ * \brief Single-output subnet w/ an NPN transformation applied on the fly.
+ *
+ * The view is equivalent to the subnet returned by util::npnTransform but
+ * does not allocate it: the links to the inputs and the output link are
+ * negated according to the transformation, while the input permutation
+ * (and removal of the unused inputs) is done by the input order of the view.
+ * The view can be passed to SubnetBuilder::replace/evaluateReplace; the i-th
+ * view input corresponds to the i-th input of the in/out mapping.
+ *
+ * Precondition: the subnet cell arities are <= Cell::InPlaceLinks.
+ */
+class SubnetNpnView final {
+public:
+  using Cell = Subnet::Cell;
+  using Link = Subnet::Link;
+  using LinkList = Subnet::LinkList;
+  using NpnTransformation = util::NpnTransformation;
+
+  /// Maximum number of the subnet inputs.
+  static constexpr size_t MaxIn = 16;
+
+  /**
+   * \brief Iterates over the used inputs (in the view order) and then over
+   * the inner cells and the output of the subnet.
+   */
+  class Iterator final {
+  public:
+    typedef EntryID value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const value_type *pointer;
+    typedef const value_type &reference;
+    typedef std::forward_iterator_tag iterator_category;
+
+    Iterator(const SubnetNpnView *view, EntryID pos): view(view), pos(pos) {}
+
+    EntryID operator*() const {
+      return pos < view->nInUsed ? view->inputs[pos]
+                                 : view->nIn + (pos - view->nInUsed);
+    }
+
+    Iterator &operator++() {
+      pos++;
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator i = *this;
+      pos++;
+      return i;
+    }
+
+    bool operator==(const Iterator &other) const { return pos == other.pos; }
+    bool operator!=(const Iterator &other) const { return pos != other.pos; }
+
+  private:
+    const SubnetNpnView *view;
+    EntryID pos;
+  };
+
+  /// Constructs the view of the subnet transformed by t. If nInUsed is less
+  /// than the number of the subnet inputs, unused inputs are removed.
+  SubnetNpnView(const Subnet &subnet,
+                const NpnTransformation &t,
+                uint16_t nInUsed = -1);
+
+  /// Returns the underlying (untransformed) subnet.
+  const Subnet &getSubnet() const { return subnet; }
+
+  /// Returns the number of the view inputs.
+  SubnetSz getInNum() const { return nInUsed; }
+  /// Returns the number of outputs.
+  SubnetSz getOutNum() const { return subnet.getOutNum(); }
+
+  /// Returns the subnet entry corresponding to the i-th view input.
+  EntryID getInIdx(const uint32_t i) const {
+    assert(i < nInUsed);
+    return inputs[i];
+  }
+  /// Returns the i-th output index.
+  EntryID getOutIdx(const uint32_t i) const { return subnet.getOutIdx(i); }
+  /// Returns the maximum entry index.
+  EntryID getMaxIdx() const { return subnet.getMaxIdx(); }
+
+  /// Returns the i-th cell (links are not transformed).
+  const Cell &getCell(EntryID i) const { return subnet.getCell(i); }
+
+  /// Returns the j-th transformed link of the i-th cell.
+  Link getLink(EntryID i, uint16_t j) const {
+    return transform(subnet.getCell(i), subnet.getLink(i, j));
+  }
+
+  /// Returns the transformed links of the i-th cell.
+  LinkList getLinks(EntryID i) const {
+    const auto &cell = subnet.getCell(i);
+    LinkList links(cell.link, cell.link + cell.arity);
+    for (auto &link : links) {
+      link = transform(cell, link);
+    }
+    return links;
+  }
+
+  Iterator begin() const { return Iterator(this, 0); }
+  Iterator end() const {
+    return Iterator(this, nInUsed + (subnet.size() - nIn));
+  }
+
+private:
+  Link transform(const Cell &cell, Link link) const {
+    if (link.idx < nIn && ((negationMask >> link.idx) & 1)) {
+      link.inv = !link.inv;
+    }
+    if (cell.isOut() && ((negationMask >> nIn) & 1)) {
+      link.inv = !link.inv;
+    }
+    return link;
+  }
+
+  const Subnet &subnet;
+  const uint32_t negationMask;
+
+  /// Number of the subnet inputs.
+  const uint16_t nIn;
+  /// Number of the view inputs.
+  uint16_t nInUsed;
+  /// Subnet inputs in the view order.
+  std::array<EntryID, MaxIn> inputs;
+};
+
+} // namespace eda::gate::model
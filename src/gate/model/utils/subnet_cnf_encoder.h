@@ -137,14 +137,130 @@ public:
     encode(subnet, context, solver);
   }
 
+  /// Encoding size.
+  struct Stats final {
+    /// Number of the variables added.
+    size_t nVars{0};
+    /// Number of the clauses added.
+    size_t nClauses{0};
+  };
+
   void encode(const Subnet &subnet,
               SubnetEncoderContext &context,
               Solver &solver) const {
+    encodeCells(subnet, nullptr, context, solver);
+  }
+
+  /// Encodes the transitive fanin of the specified outputs only (the inputs
+  /// are always encoded). The variables of the other cells are not defined.
+  Stats encode(const Subnet &subnet,
+               const std::vector<size_t> &outputs,
+               SubnetEncoderContext &context,
+               Solver &solver) const {
+    const auto nVars = solver.getVarNum();
+    const auto nClauses = solver.getClauseNum();
+
+    const auto cone = getCone(subnet, outputs);
+    encodeCells(subnet, &cone, context, solver);
+
+    return Stats{solver.getVarNum() - nVars,
+                 solver.getClauseNum() - nClauses};
+  }
+
+  Variable encodeEqual(SubnetEncoderContext &context,
+                       const Subnet::Link lhs,
+                       const bool rhs)  const {
+    const auto p = context.newVar();
+    Property &prop = context.createNewProp(p);
+
+    const Literal lit1 = context.lit(lhs, rhs);
+    const Literal lit2 = solver::makeLit(p, 1);
+
+    const LitVec clauseToAdd1{  lit1, ~lit2 };
+    const LitVec clauseToAdd2{ ~lit1,  lit2 };
+
+    prop.formula.push_back(clauseToAdd1);
+    prop.formula.push_back(clauseToAdd2);
+
+    return p;
+  }
+
+  Variable encodeEqual(SubnetEncoderContext &context,
+                       const Subnet::Link lhs,
+                       const Subnet::Link rhs) const {
+    const auto p = context.newVar();
+    Property &prop = context.createNewProp(p);
+
+    const Literal lit1 = context.lit(lhs, 1);
+    const Literal lit2 = context.lit(rhs, 1);
+    const Literal lit3 = solver::makeLit(p, 1);
+
+    const LitVec clauseToAdd1{  lit1,  lit2,  lit3 };
+    const LitVec clauseToAdd2{  lit1, ~lit2, ~lit3 };
+    const LitVec clauseToAdd3{ ~lit1,  lit2, ~lit3 };
+    const LitVec clauseToAdd4{ ~lit1, ~lit2,  lit3 };
+
+    prop.formula.insert(prop.formula.end(),
+      {clauseToAdd1, clauseToAdd2, clauseToAdd3, clauseToAdd4}
+    );
+
+    return p;
+  }
+
+private:
+  SubnetEncoder() {}
+
+  /// Marks the transitive fanin of the specified outputs and the inputs.
+  static std::vector<bool> getCone(const Subnet &subnet,
+                                   const std::vector<size_t> &outputs) {
+    const auto &entries = subnet.getEntries();
+
+    std::vector<size_t> cells;
+    cells.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+      cells.push_back(i);
+      i += entries[i].cell.more;
+    }
+
+    std::vector<bool> cone(entries.size(), false);
+    for (const auto i : outputs) {
+      assert(i < subnet.getOutNum());
+      cone[entries.size() - subnet.getOutNum() + i] = true;
+    }
+
+    for (auto i = cells.rbegin(); i != cells.rend(); ++i) {
+      const auto &cell = entries[*i].cell;
+      if (!cone[*i]) {
+        // The variables are allocated in order starting w/ the first entry.
+        cone[*i] = cell.isIn() || (*i == 0);
+        continue;
+      }
+      for (size_t j = 0; j < cell.arity; ++j) {
+        cone[subnet.getLink(*i, j).idx] = true;
+      }
+    }
+
+    return cone;
+  }
+
+  /// Encodes the cells (if the cone is specified, the cells of the cone).
+  void encodeCells(const Subnet &subnet,
+                   const std::vector<bool> *cone,
+                   SubnetEncoderContext &context,
+                   Solver &solver) const {
     const auto &entries = subnet.getEntries();
     for (size_t i = 0; i < entries.size(); ++i) {
       const auto &cell = entries[i].cell;
       assert(!cell.isNull());
 
+      if (cone && !(*cone)[i]) {
+        // No variables are allocated for the cell.
+        context.setVars(i, 0);
+        context.skipNextVars(i, cell.more);
+        i += cell.more;
+        continue;
+      }
+
            if (cell.isIn())   { encodeIn  (subnet, cell, i, context, solver); }
       else if (cell.isOut())  { encodeOut (subnet, cell, i, context, solver); }
       else if (cell.isZero()) { encodeZero(subnet, cell, i, context, solver); }
@@ -190,48 +306,6 @@ public:
     }
   }
 
-  Variable encodeEqual(SubnetEncoderContext &context,
-                       const Subnet::Link lhs,
-                       const bool rhs)  const {
-    const auto p = context.newVar();
-    Property &prop = context.createNewProp(p);
-
-    const Literal lit1 = context.lit(lhs, rhs);
-    const Literal lit2 = solver::makeLit(p, 1);
-
-    const LitVec clauseToAdd1{  lit1, ~lit2 };
-    const LitVec clauseToAdd2{ ~lit1,  lit2 };
-
-    prop.formula.push_back(clauseToAdd1);
-    prop.formula.push_back(clauseToAdd2);
-
-    return p;
-  }
-
-  Variable encodeEqual(SubnetEncoderContext &context,
-                       const Subnet::Link lhs,
-                       const Subnet::Link rhs) const {
-    const auto p = context.newVar();
-    Property &prop = context.createNewProp(p);
-
-    const Literal lit1 = context.lit(lhs, 1);
-    const Literal lit2 = context.lit(rhs, 1);
-    const Literal lit3 = solver::makeLit(p, 1);
-
-    const LitVec clauseToAdd1{  lit1,  lit2,  lit3 };
-    const LitVec clauseToAdd2{  lit1, ~lit2, ~lit3 };
-    const LitVec clauseToAdd3{ ~lit1,  lit2, ~lit3 };
-    const LitVec clauseToAdd4{ ~lit1, ~lit2,  lit3 };
-
-    prop.formula.insert(prop.formula.end(),
-      {clauseToAdd1, clauseToAdd2, clauseToAdd3, clauseToAdd4}
-    );
-
-    return p;
-  }
-
-private:
-  SubnetEncoder() {}
 
   void encodeIn(const Subnet &subnet,
                 const Subnet::Cell &cell,
@@ -346,15 +420,24 @@ private:
     const size_t k = cell.arity;
     auto rhs = context.lit(idx, 0, 1);
 
-    for (size_t j = 0; j < k - 1; ++j) {
-      const auto link1 = subnet.getLink(idx, j);
-      const auto link2 = subnet.getLink(idx, j + 1);
+    // The chain of the 3-input XORs: y = x[0] ^ x[1] ^ t, t = x[2] ^ ...
+    size_t j = 0;
+    for (; k - j > 3; j += 2) {
+      const auto lhs1 = context.lit(subnet.getLink(idx, j), 1);
+      const auto lhs2 = context.lit(subnet.getLink(idx, j + 1), 1);
+      const auto tmp = context.newLit();
 
-      const auto lhs1 = context.lit(link1, 1);
-      const auto lhs2 = (j == k - 2) ? context.lit(link2, 1) : context.newLit();
+      solver.encodeXor(rhs, lhs1, lhs2, tmp);
+      rhs = tmp;
+    }
 
+    const auto lhs1 = context.lit(subnet.getLink(idx, j), 1);
+    const auto lhs2 = context.lit(subnet.getLink(idx, j + 1), 1);
+    if (k - j == 3) {
+      const auto lhs3 = context.lit(subnet.getLink(idx, j + 2), 1);
+      solver.encodeXor(rhs, lhs1, lhs2, lhs3);
+    } else {
       solver.encodeXor(rhs, lhs1, lhs2);
-      rhs = lhs2;
     }
   }
 
@@ -9,6 +9,11 @@
 #include "gate/model/printer/net_printer.h"
 #include "gate/optimizer/npndb.h"
 #include "gate/translator/logdb.h"
+#include "util/npn_canonization.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
 
 namespace eda::gate::optimizer {
 
@@ -17,10 +22,12 @@ using TT = NpnDatabase::TT;
 NpnDatabase::ResultIterator NpnDatabase::get(const TT &tt) {
   const size_t nVars = tt.num_vars();
   const TT ttk = nVars < nInputs ? kitty::extend_to(tt, nInputs) : tt;
-  auto config = kitty::exact_npn_canonization(ttk);
+  auto config = util::npnCanonization(ttk);
   NpnTransformation t = util::getTransformation(config);
   const auto &canonTT = util::getTT(config);
-  return ResultIterator(storage[canonTT], util::inverse(t), nVars);
+  const auto i = storage.find(canonTT);
+  return ResultIterator(i != storage.end() ? i->second : SubnetIDList{},
+                        util::inverse(t), nVars);
 }
 
 NpnDatabase::ResultIterator NpnDatabase::get(const Subnet &subnet) {
@@ -64,10 +71,11 @@ void NpnDatabase::printInfoSub(std::ostream &out, const Subnet &subnet) {
 
 NpnDatabase::NpnTransformation NpnDatabase::push(const SubnetID &id) {
   TT tt = model::evaluate(Subnet::get(id))[0];
-  auto config = kitty::exact_npn_canonization(tt);
+  auto config = util::npnCanonization(tt);
   NpnTransformation t = util::getTransformation(config);
   auto newId = util::npnTransform(Subnet::get(id), t);
   storage[std::get<0>(config)].push_back(newId);
+  addCost(newId);
   return t;
 }
 
@@ -75,6 +83,118 @@ void NpnDatabase::erase(const TT &tt) {
   storage.erase(tt);
 }
 
+NpnImplCost NpnImplCost::make(const model::Subnet &subnet) {
+  const auto nIn = subnet.getInNum();
+  const auto &entries = subnet.getEntries();
+
+  // The longest paths from each input (-1 if there is no path).
+  std::vector<std::vector<int16_t>> paths(entries.size());
+
+  NpnImplCost cost{0, 0, std::vector<int16_t>(nIn, -1)};
+  for (size_t i = 0; i < entries.size(); ++i) {
+    const auto &cell = entries[i].cell;
+    auto &path = paths[i];
+
+    path.assign(nIn, -1);
+    if (cell.isIn()) {
+      path[i] = 0;
+      continue;
+    }
+
+    const int16_t delay = (cell.isOut() || cell.isBuf()) ? 0 : 1;
+    for (const auto &link : subnet.getLinks(i)) {
+      for (size_t j = 0; j < nIn; ++j) {
+        if (paths[link.idx][j] >= 0) {
+          path[j] = std::max<int16_t>(path[j], paths[link.idx][j] + delay);
+        }
+      }
+    }
+
+    if (cell.isOut()) {
+      cost.inDepth = path;
+    } else if (delay) {
+      cost.size++;
+    }
+
+    i += cell.more;
+  }
+
+  for (const auto depth : cost.inDepth) {
+    if (depth > 0) {
+      cost.depth = std::max<model::SubnetDepth>(cost.depth, depth);
+    }
+  }
+  return cost;
+}
+
+float NpnImplCost::getArrival(const float *arrivals) const {
+  float arrival = 0.f;
+  for (size_t i = 0; i < inDepth.size(); ++i) {
+    if (inDepth[i] >= 0) {
+      arrival = std::max(arrival, arrivals[i] + inDepth[i]);
+    }
+  }
+  return arrival;
+}
+
+NpnImplCost NpnDatabase::getCost(const SubnetID &id) const {
+  const auto i = costs.find(id);
+  return i != costs.end() ? i->second : NpnImplCost::make(Subnet::get(id));
+}
+
+void NpnDatabase::addCost(const SubnetID &id) {
+  if (costs.find(id) == costs.end()) {
+    costs.emplace(id, NpnImplCost::make(Subnet::get(id)));
+  }
+}
+
+void NpnDatabase::addCosts() {
+  for (const auto &[tt, ids] : storage) {
+    for (const auto id : ids) {
+      addCost(id);
+    }
+  }
+}
+
+NpnDatabase::ResultIterator NpnDatabase::getBest(
+    const TT &tt, const std::vector<float> &arrivals) {
+  assert(arrivals.size() >= tt.num_vars());
+
+  auto iter = get(tt);
+
+  SubnetID best = model::OBJ_NULL_ID;
+  float bestArrival = 0.f;
+  model::SubnetSz bestSize = 0;
+
+  std::array<float, model::SubnetNpnView::MaxIn> inArrivals;
+  for (; !iter.isEnd(); iter.next()) {
+    const auto id = iter.getStored();
+    const auto cost = getCost(id);
+
+    // Map the arrival times of the function inputs to the subnet inputs.
+    const auto view = iter.getView();
+    inArrivals.fill(0.f);
+    for (size_t i = 0; i < view.getInNum(); ++i) {
+      inArrivals[view.getInIdx(i)] = arrivals[i];
+    }
+
+    const float arrival = cost.getArrival(inArrivals.data());
+    if (best == model::OBJ_NULL_ID || arrival < bestArrival
+        || (arrival == bestArrival && cost.size < bestSize)) {
+      best = id;
+      bestArrival = arrival;
+      bestSize = cost.size;
+    }
+  }
+
+  if (best == model::OBJ_NULL_ID) {
+    return ResultIterator(SubnetIDList{}, iter.getTransformation(),
+                          iter.getInUsedNum());
+  }
+  return ResultIterator(SubnetIDList{best}, iter.getTransformation(),
+                        iter.getInUsedNum());
+}
+
 NpnDatabase NpnDatabase::importFrom(const std::string &filename) {
   translator::LogDbTranslator translator;
   return translator.translate(filename);
@@ -102,6 +222,7 @@ void NpnDatabaseSerializer::serialize(std::ostream &out,
 NpnDatabase NpnDatabaseSerializer::deserialize(std::istream &in) {
   NpnDatabase result;
   result.storage = storageSerializer.deserialize(in);
+  result.addCosts();
   return result;
 }
 
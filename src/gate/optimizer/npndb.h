@@ -10,6 +10,7 @@
 
 #include "gate/function/truth_table.h"
 #include "gate/model/serializer.h"
+#include "gate/model/subnet_npn_view.h"
 #include "gate/model/utils/subnet_truth_table.h"
 #include "gate/optimizer/subnet_info.h"
 #include "util/citerator.h"
@@ -70,6 +71,26 @@ public:
     return eda::util::npnTransform(subnet, transformation, nInUsed);
   }
 
+  /// Returns the transformed subnet as a builder-based object: unlike get(),
+  /// no subnet is allocated in the storage.
+  model::SubnetObject getObject() const {
+    if (isEnd()) {
+      throw std::runtime_error("The iterator has reached end of the list");
+    }
+    const auto &subnet = Subnet::get(list[ind]);
+    return eda::util::npnTransformObject(subnet, transformation, nInUsed);
+  }
+
+  /// Returns the stored subnet w/ the transformation applied on the fly.
+  /// The view can be passed to SubnetBuilder::replace/evaluateReplace.
+  model::SubnetNpnView getView() const {
+    if (isEnd()) {
+      throw std::runtime_error("The iterator has reached end of the list");
+    }
+    return model::SubnetNpnView(Subnet::get(list[ind]), transformation,
+                                nInUsed);
+  }
+
   size_t size() const override {
     return list.size();
   }
@@ -78,6 +99,24 @@ public:
     return !isEnd();
   }
 
+  /// Returns the stored (untransformed) implementation.
+  SubnetID getStored() const {
+    if (isEnd()) {
+      throw std::runtime_error("The iterator has reached end of the list");
+    }
+    return list[ind];
+  }
+
+  /// Returns the transformation applied to the stored implementations.
+  const NpnTransformation &getTransformation() const {
+    return transformation;
+  }
+
+  /// Returns the number of the used inputs.
+  uint8_t getInUsedNum() const {
+    return nInUsed;
+  }
+
   bool hasSubnetInfo() const {
     return hasInfo;
   }
@@ -97,11 +136,28 @@ private:
   uint8_t nInUsed = -1;
 };
 
+/**
+ * \brief Cost profile of a stored implementation: the number of inner cells,
+ * the depth and the per-input depths (the longest path from the i-th input
+ * to the output or -1 if the output does not depend on the input).
+ */
+struct NpnImplCost final {
+  static NpnImplCost make(const model::Subnet &subnet);
+
+  /// Returns the output arrival time given the subnet input arrival times.
+  float getArrival(const float *arrivals) const;
+
+  model::SubnetSz size;
+  model::SubnetDepth depth;
+  std::vector<int16_t> inDepth;
+};
+
 /**
  * \brief Implements rewrite database which uses Npn matching to store nets.
  */
 class NpnDatabase {
 friend class NpnDatabaseSerializer;
+friend class NpnMmapDatabase;
 
 public:
   using ResultIterator = NpnDb2ResultIterator;
@@ -163,6 +219,19 @@ public:
 
   virtual void erase(const TT &tt);
 
+  /// Returns the cost profile of the stored implementation. The profiles are
+  /// computed when the implementations are stored, so the lookups do not
+  /// modify the database (the profile of an unknown subnet is computed).
+  NpnImplCost getCost(const SubnetID &id) const;
+
+  /**
+   * \brief Selects the implementation of *tt* w/ the minimal output arrival
+   * time (then w/ the minimal size) given the arrival times of *tt* inputs.
+   * Uses the cost profiles of the stored implementations: no candidate is
+   * built. Returns the iterator over the selected implementation.
+   */
+  ResultIterator getBest(const TT &tt, const std::vector<float> &arrivals);
+
   static NpnDatabase importFrom(const std::string &filename);
   void exportTo(const std::string &filename) const;
 
@@ -170,9 +239,18 @@ public:
   void setInNum(uint8_t inNum) { nInputs = inNum; }
 
 protected:
+  /// Computes the cost profile of the stored implementation.
+  void addCost(const SubnetID &id);
+  /// Computes the cost profiles of all the stored implementations.
+  void addCosts();
+
   // Storage only contains Npn class representatives.
   std::unordered_map<TT, SubnetIDList> storage;
   uint8_t nInputs = 0;
+
+private:
+  // Cost profiles of the stored implementations.
+  std::unordered_map<uint64_t, NpnImplCost> costs;
 };
 
 // Serializer for NpnStatDatabase class
@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/optimizer/npndb_checkpoint.h"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace eda::gate::optimizer {
+
+static constexpr auto ManifestName = "manifest";
+
+static std::string toHexString(const uint8_t k, const uint64_t tt) {
+  const int width = (k < 2) ? 1 : (1 << k) / 4;
+
+  std::stringstream ss;
+  ss << std::setfill('0') << std::setw(width) << std::hex << tt;
+  return ss.str();
+}
+
+std::filesystem::path NpnDbCheckpoint::getDefaultDir(
+    const std::string &fileName, const Settings &settings) {
+  return fileName + "." + settings.basis + "-k"
+      + std::to_string(settings.k) + ".ckpt";
+}
+
+NpnDbCheckpoint::NpnDbCheckpoint(const std::filesystem::path &dir,
+                                 const Settings &settings):
+    dir(dir), settings(settings) {
+  std::filesystem::create_directories(dir);
+
+  const auto manifestPath = dir / ManifestName;
+  const auto manifest = getManifest();
+
+  if (std::filesystem::exists(manifestPath)) {
+    std::ifstream in(manifestPath);
+    std::stringstream contents;
+    contents << in.rdbuf();
+
+    if (contents.str() != manifest) {
+      throw std::runtime_error("Checkpoint directory " + dir.string()
+          + " has been created w/ other settings");
+    }
+    return;
+  }
+
+  // The checkpoints of unknown settings are not reused.
+  for (const auto &entry : std::filesystem::directory_iterator(dir)) {
+    if (entry.path().extension() == ".logdb") {
+      throw std::runtime_error("Checkpoint directory " + dir.string()
+          + " has no manifest");
+    }
+  }
+
+  std::ofstream out(manifestPath);
+  out << manifest;
+  if (!out) {
+    throw std::runtime_error("Failed to write " + manifestPath.string());
+  }
+}
+
+std::filesystem::path NpnDbCheckpoint::getPath(const size_t i,
+                                               const uint64_t tt) const {
+  return dir / (std::to_string(i) + "-" + toHexString(settings.k, tt)
+      + ".logdb");
+}
+
+bool NpnDbCheckpoint::has(const size_t i, const uint64_t tt) const {
+  return std::filesystem::exists(getPath(i, tt));
+}
+
+std::vector<size_t> NpnDbCheckpoint::getPending(
+    const std::vector<uint64_t> &classes) const {
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < classes.size(); ++i) {
+    if (!has(i, classes[i])) {
+      pending.push_back(i);
+    }
+  }
+  return pending;
+}
+
+std::string NpnDbCheckpoint::getManifest() const {
+  return "basis " + settings.basis + "\n"
+       + "k " + std::to_string(settings.k) + "\n";
+}
+
+} // namespace eda::gate::optimizer
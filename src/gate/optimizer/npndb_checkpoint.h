@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace eda::gate::optimizer {
+
+/**
+ * \brief Checkpoint directory of the NPN database generation (see dbgen).
+ *
+ * Each NPN class is written to its own file, so an interrupted generation
+ * can be resumed. The directory keeps a manifest of the settings the
+ * implementations depend on (the basis and the number of inputs): opening
+ * a directory created w/ other settings fails instead of reusing its files.
+ */
+class NpnDbCheckpoint final {
+public:
+  struct Settings final {
+    /// Basis of the implementations (aig, xag, or mig).
+    std::string basis;
+    /// Number of the inputs.
+    uint8_t k{4};
+  };
+
+  /// Returns the default checkpoint directory of the database file.
+  static std::filesystem::path getDefaultDir(const std::string &fileName,
+                                             const Settings &settings);
+
+  /// Opens or creates the checkpoint directory.
+  /// Throws an exception if the directory has been created w/ other settings.
+  NpnDbCheckpoint(const std::filesystem::path &dir, const Settings &settings);
+
+  /// Returns the checkpoint file of the i-th class: the name includes the
+  /// truth table, so the checkpoints of a changed class list are not reused.
+  std::filesystem::path getPath(size_t i, uint64_t tt) const;
+
+  /// Checks whether the i-th class has been generated.
+  bool has(size_t i, uint64_t tt) const;
+
+  /// Returns the indices of the classes that have not been generated yet.
+  std::vector<size_t> getPending(const std::vector<uint64_t> &classes) const;
+
+private:
+  /// Returns the manifest contents for the settings.
+  std::string getManifest() const;
+
+  const std::filesystem::path dir;
+  const Settings settings;
+};
+
+} // namespace eda::gate::optimizer
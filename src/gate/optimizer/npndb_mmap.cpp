@@ -0,0 +1,367 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/optimizer/npndb_mmap.h"
+#include "util/npn_canonization.h"
+#include "util/serializer.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace eda::gate::optimizer {
+
+using TT = NpnDatabase::TT;
+
+/// Checks that the array of n items of type T at the offset fits the file.
+template <typename T>
+static bool checkRange(uint64_t offset, uint64_t n, size_t size) {
+  return offset <= size
+      && offset % alignof(T) == 0
+      && n <= (size - offset) / sizeof(T);
+}
+
+static bool checkHeader(const NpnMmapHeader &header, size_t size) {
+  if (size < sizeof(NpnMmapHeader)
+      || std::memcmp(header.magic, NpnMmapHeader::Magic, sizeof(header.magic))
+      || header.version != NpnMmapHeader::Version
+      || header.fileSize != size
+      || header.nInputs > 6) {
+    return false;
+  }
+
+  // The entries occupy the rest of the file.
+  return checkRange<NpnMmapType>(header.typeOffset, header.nTypes, size)
+      && checkRange<NpnMmapClass>(header.classOffset, header.nClasses, size)
+      && checkRange<NpnMmapSubnet>(header.subnetOffset, header.nSubnets, size)
+      && checkRange<model::Subnet::Entry>(header.entryOffset, 0, size)
+      && (size - header.entryOffset) % sizeof(model::Subnet::Entry) == 0;
+}
+
+/// Checks the subnet ranges of the classes and the entry ranges of the
+/// subnets (incl. the link entries and the links of the cells).
+static bool checkSubnets(const NpnMmapHeader &header,
+                         const NpnMmapClass *classes,
+                         const NpnMmapSubnet *subnets,
+                         const model::Subnet::Entry *entries,
+                         size_t size) {
+
+  for (size_t i = 0; i < header.nClasses; ++i) {
+    const auto &c = classes[i];
+    if (c.subnetBegin > c.subnetEnd || c.subnetEnd > header.nSubnets) {
+      return false;
+    }
+  }
+
+  const uint64_t nEntries =
+      (size - header.entryOffset) / sizeof(model::Subnet::Entry);
+
+  for (size_t i = 0; i < header.nSubnets; ++i) {
+    const auto &s = subnets[i];
+    if (s.entryBegin > nEntries || s.nEntry > nEntries - s.entryBegin
+        || uint64_t{s.nIn} + s.nOut > s.nEntry) {
+      return false;
+    }
+
+    const auto *array = entries + s.entryBegin;
+    for (uint64_t k = 0; k < s.nEntry; ++k) {
+      const auto &cell = array[k].cell;
+      if (cell.more >= s.nEntry - k) {
+        return false;
+      }
+      for (uint16_t j = 0; j < cell.arity; ++j) {
+        const auto [e, m] = model::Subnet::getLinkIndices(k, j);
+        const auto &link = (e == k) ? cell.link[m] : array[e].link[m];
+        if (link.idx >= k) {
+          return false;
+        }
+      }
+      k += cell.more;
+    }
+  }
+
+  return true;
+}
+
+static bool checkTypes(const NpnMmapType *types, size_t nTypes) {
+  for (size_t i = 0; i < nTypes; ++i) {
+    const auto symbol = static_cast<model::CellSymbol>(types[i].symbol);
+    if (model::getCellTypeSID(symbol) != types[i].sid) {
+      return false;
+    }
+  }
+  return true;
+}
+
+NpnMmapDatabase::NpnMmapDatabase(const std::string &filename) {
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("Failed to open NPN database image " + filename);
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size == 0) {
+    close(fd);
+    throw std::runtime_error("Failed to stat NPN database image " + filename);
+  }
+  size = st.st_size;
+
+  void *ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (ptr == MAP_FAILED) {
+    throw std::runtime_error("Failed to map NPN database image " + filename);
+  }
+  data = static_cast<const char*>(ptr);
+
+  header = at<NpnMmapHeader>(0);
+  bool isValid = size >= sizeof(NpnMmapHeader) && checkHeader(*header, size)
+      && checkTypes(at<NpnMmapType>(header->typeOffset), header->nTypes);
+
+  if (isValid) {
+    classes = at<NpnMmapClass>(header->classOffset);
+    subnets = at<NpnMmapSubnet>(header->subnetOffset);
+    entries = at<Entry>(header->entryOffset);
+    isValid = checkSubnets(*header, classes, subnets, entries, size);
+  }
+
+  if (!isValid) {
+    munmap(const_cast<char*>(data), size);
+    data = nullptr;
+    throw std::runtime_error("Invalid NPN database image " + filename);
+  }
+
+  nInputs = header->nInputs;
+  cache.resize(header->nClasses);
+  isCached.resize(header->nClasses, false);
+}
+
+NpnMmapDatabase::~NpnMmapDatabase() {
+  if (data) {
+    munmap(const_cast<char*>(data), size);
+  }
+}
+
+NpnMmapDatabase::ResultIterator NpnMmapDatabase::get(const TT &tt) {
+  const size_t nVars = tt.num_vars();
+  if (nVars > 6) {
+    return ResultIterator(SubnetIDList{}, NpnTransformation{}, nVars);
+  }
+
+  const TT ttk = nVars < nInputs ? kitty::extend_to(tt, nInputs) : tt;
+  const auto config = util::npnCanonization(ttk);
+  const NpnTransformation t = util::getTransformation(config);
+  const auto &canonTT = util::getTT(config);
+
+  const auto i = findClass(canonTT.num_vars(), *canonTT.cbegin());
+  if (i < 0) {
+    return ResultIterator(SubnetIDList{}, util::inverse(t), nVars);
+  }
+  return ResultIterator(materialize(i), util::inverse(t), nVars);
+}
+
+NpnMmapDatabase::NpnTransformation NpnMmapDatabase::push(const SubnetID &) {
+  throw std::runtime_error("NPN database image is read-only");
+}
+
+void NpnMmapDatabase::erase(const TT &) {
+  throw std::runtime_error("NPN database image is read-only");
+}
+
+int64_t NpnMmapDatabase::findClass(uint32_t nVars, uint64_t tt) const {
+  const NpnMmapClass key{tt, nVars, 0, 0, 0};
+  const auto *begin = classes;
+  const auto *end = classes + header->nClasses;
+  const auto *it = std::lower_bound(begin, end, key);
+  return (it != end && it->nVars == nVars && it->tt == tt) ? (it - begin) : -1;
+}
+
+const NpnMmapDatabase::SubnetIDList &NpnMmapDatabase::materialize(size_t i) {
+  if (isCached[i]) {
+    return cache[i];
+  }
+
+  const auto &c = classes[i];
+  auto &ids = cache[i];
+  ids.reserve(c.subnetEnd - c.subnetBegin);
+
+  for (uint32_t j = c.subnetBegin; j < c.subnetEnd; ++j) {
+    const auto &s = subnets[j];
+    const Entry *begin = entries + s.entryBegin;
+    // The entries are copied as is: no rebuilding via SubnetBuilder.
+    const std::vector<Entry> array(begin, begin + s.nEntry);
+    ids.push_back(model::allocateObject<model::Subnet>(
+        s.nIn, s.nOut, s.nCell, s.nBuf, array));
+    addCost(ids.back());
+  }
+
+  isCached[i] = true;
+  nMaterialized++;
+  return ids;
+}
+
+template <typename T>
+static void pushArray(std::ostream &out, const std::vector<T> &array) {
+  out.write(reinterpret_cast<const char*>(array.data()),
+            array.size() * sizeof(T));
+  if (out.fail()) {
+    throw std::runtime_error("Serialization: Failed to push data into stream");
+  }
+}
+
+void NpnMmapDatabase::write(const NpnDatabase &db,
+                            const std::string &filename) {
+  // Sort the classes to enable binary search.
+  std::map<std::pair<uint32_t, uint64_t>, const SubnetIDList*> sorted;
+  for (const auto &[tt, ids] : db.storage) {
+    if (tt.num_vars() > 6) {
+      throw std::runtime_error("NPN database image supports up to 6 inputs");
+    }
+    sorted.emplace(std::make_pair(tt.num_vars(), *tt.cbegin()), &ids);
+  }
+
+  std::vector<NpnMmapClass> classArray;
+  std::vector<NpnMmapSubnet> subnetArray;
+  std::vector<Entry> entryArray;
+  std::map<uint32_t, uint32_t> typeMap;
+
+  for (const auto &[key, ids] : sorted) {
+    NpnMmapClass c{key.second, key.first,
+                   static_cast<uint32_t>(subnetArray.size()), 0, 0};
+
+    for (const auto id : *ids) {
+      const auto &subnet = model::Subnet::get(id);
+      const auto &array = subnet.getEntries();
+
+      NpnMmapSubnet s;
+      s.entryBegin = entryArray.size();
+      s.nEntry = subnet.size();
+      s.nIn = subnet.getInNum();
+      s.nOut = subnet.getOutNum();
+      s.nCell = subnet.getCellNum();
+      s.nBuf = subnet.getBufNum();
+      s.reserved = 0;
+
+      for (size_t k = 0; k < subnet.size(); ++k) {
+        const auto &cell = array[k].cell;
+        entryArray.push_back(array[k]);
+        if (cell.arity > model::Subnet::Cell::InPlaceLinks) {
+          // Link entries do not contain cell types.
+          for (size_t m = 0; m < cell.more; ++m) {
+            entryArray.push_back(array[++k]);
+          }
+        }
+        if (!cell.getType().isGate()) {
+          throw std::runtime_error("NPN database image supports gates only");
+        }
+        typeMap[cell.type] = static_cast<uint32_t>(cell.getSymbol());
+      }
+      subnetArray.push_back(s);
+    }
+
+    c.subnetEnd = subnetArray.size();
+    classArray.push_back(c);
+  }
+
+  std::vector<NpnMmapType> typeArray;
+  for (const auto &[sid, symbol] : typeMap) {
+    typeArray.push_back(NpnMmapType{sid, symbol});
+  }
+
+  NpnMmapHeader header;
+  std::memcpy(header.magic, NpnMmapHeader::Magic, sizeof(header.magic));
+  header.version = NpnMmapHeader::Version;
+  header.nInputs = db.nInputs;
+  header.nTypes = typeArray.size();
+  header.nClasses = classArray.size();
+  header.nSubnets = subnetArray.size();
+  header.reserved = 0;
+  header.typeOffset = sizeof(NpnMmapHeader);
+  header.classOffset =
+      header.typeOffset + typeArray.size() * sizeof(NpnMmapType);
+  header.subnetOffset =
+      header.classOffset + classArray.size() * sizeof(NpnMmapClass);
+  header.entryOffset =
+      header.subnetOffset + subnetArray.size() * sizeof(NpnMmapSubnet);
+  header.fileSize =
+      header.entryOffset + entryArray.size() * sizeof(Entry);
+
+  // Write to a temporary file and rename it to make the update atomic.
+  const std::string tmpname = filename + ".tmp";
+  {
+    std::ofstream out(tmpname, std::ios::binary);
+    if (!out.is_open()) {
+      throw std::runtime_error("Error of opening file to export\n");
+    }
+    util::pushIntoStream(out, header);
+    pushArray(out, typeArray);
+    pushArray(out, classArray);
+    pushArray(out, subnetArray);
+    pushArray(out, entryArray);
+  }
+  std::filesystem::rename(tmpname, filename);
+}
+
+bool NpnMmapDatabase::isValid(const std::string &filename) {
+  std::ifstream in(filename, std::ios::binary);
+  if (!in.is_open()) {
+    return false;
+  }
+
+  NpnMmapHeader header;
+  in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (in.fail()) {
+    return false;
+  }
+
+  std::error_code error;
+  const auto size = std::filesystem::file_size(filename, error);
+  return !error && checkHeader(header, size);
+}
+
+std::unique_ptr<NpnDatabase> loadNpnDatabase(const std::string &filename,
+                                             uint8_t nInputs) {
+  namespace fs = std::filesystem;
+
+  const std::string image = filename + ".npndb";
+
+  std::error_code error;
+  const bool isFresh = fs::exists(image, error) && (!fs::exists(filename)
+      || fs::last_write_time(image) >= fs::last_write_time(filename));
+
+  if (isFresh && NpnMmapDatabase::isValid(image)) {
+    try {
+      auto db = std::make_unique<NpnMmapDatabase>(image);
+      if (db->getClassNum() != 0) {
+        return db;
+      }
+    } catch (const std::runtime_error &) {
+      // Fall back to the text format (e.g., cell type SIDs have changed).
+    }
+  }
+
+  auto db = std::make_unique<NpnDatabase>(NpnDatabase::importFrom(filename));
+  db->setInNum(nInputs);
+
+  try {
+    NpnMmapDatabase::write(*db, image);
+  } catch (const std::exception &) {
+    // The image is just a cache: the directory may be read-only.
+  }
+
+  return db;
+}
+
+} // namespace eda::gate::optimizer
@@ -0,0 +1,157 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "gate/optimizer/npndb.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace eda::gate::optimizer {
+
+/**
+ * \brief Binary image of an NPN database (all offsets are from the file start).
+ *
+ * | Header | Types[nTypes] | Classes[nClasses] | Subnets[nSubnets] | Entries |
+ *
+ * Classes are sorted by the number of variables and the canonical truth table
+ * (up to 6 inputs, so a table fits into one 64-bit word). Each class refers
+ * to a range of subnets; each subnet refers to a range of raw subnet entries
+ * laid out as in `Subnet`.
+ * Types map the cell type SIDs used in the entries to the cell symbols:
+ * the image is rejected if the SIDs differ in the running program.
+ */
+struct NpnMmapHeader final {
+  static constexpr char Magic[8] = {'U', 'T', 'N', 'P', 'N', 'D', 'B', '\0'};
+  static constexpr uint32_t Version = 1;
+
+  char magic[8];
+  uint32_t version;
+  uint32_t nInputs;
+  uint32_t nTypes;
+  uint32_t nClasses;
+  uint32_t nSubnets;
+  uint32_t reserved;
+  uint64_t typeOffset;
+  uint64_t classOffset;
+  uint64_t subnetOffset;
+  uint64_t entryOffset;
+  uint64_t fileSize;
+};
+static_assert(sizeof(NpnMmapHeader) == 72);
+
+/// Cell type SID to cell symbol correspondence.
+struct NpnMmapType final {
+  uint32_t sid;
+  uint32_t symbol;
+};
+static_assert(sizeof(NpnMmapType) == 8);
+
+/// NPN class: canonical truth table and the range of its subnets.
+struct NpnMmapClass final {
+  bool operator<(const NpnMmapClass &other) const {
+    return nVars != other.nVars ? nVars < other.nVars : tt < other.tt;
+  }
+
+  uint64_t tt;
+  uint32_t nVars;
+  uint32_t subnetBegin;
+  uint32_t subnetEnd;
+  uint32_t reserved;
+};
+static_assert(sizeof(NpnMmapClass) == 24);
+
+/// Subnet: the range of its entries and the subnet counters.
+struct NpnMmapSubnet final {
+  uint64_t entryBegin;
+  uint32_t nEntry;
+  uint32_t nIn;
+  uint32_t nOut;
+  uint32_t nCell;
+  uint32_t nBuf;
+  uint32_t reserved;
+};
+static_assert(sizeof(NpnMmapSubnet) == 32);
+
+/**
+ * \brief Implements read-only NPN database over a memory-mapped binary image.
+ *
+ * Lookups are done directly in the mapped file (binary search over the
+ * sorted classes); subnets of a class are allocated in `Storage<Subnet>`
+ * only when the class is requested for the first time.
+ */
+class NpnMmapDatabase final : public NpnDatabase {
+public:
+  using Entry = model::Subnet::Entry;
+
+  /// Maps the given image file; throws if the file is missing or invalid.
+  explicit NpnMmapDatabase(const std::string &filename);
+  ~NpnMmapDatabase() override;
+
+  NpnMmapDatabase(const NpnMmapDatabase &) = delete;
+  NpnMmapDatabase &operator=(const NpnMmapDatabase &) = delete;
+
+  ResultIterator get(const TT &tt) override;
+  using NpnDatabase::get;
+
+  /// The database is read-only: throws.
+  NpnTransformation push(const SubnetID &id) override;
+  /// The database is read-only: throws.
+  void erase(const TT &tt) override;
+
+  /// Returns the number of NPN classes in the image.
+  size_t getClassNum() const { return header->nClasses; }
+  /// Returns the number of classes whose subnets have been materialized.
+  size_t getMaterializedNum() const { return nMaterialized; }
+
+  /// Writes the binary image of the given database.
+  static void write(const NpnDatabase &db, const std::string &filename);
+  /// Checks whether the file is a valid image of the current version.
+  static bool isValid(const std::string &filename);
+
+private:
+  /// Returns the index of the class w/ the given key or -1 (if not found).
+  int64_t findClass(uint32_t nVars, uint64_t tt) const;
+  /// Allocates the subnets of the i-th class in the storage and computes
+  /// their cost profiles.
+  const SubnetIDList &materialize(size_t i);
+
+  template <typename T>
+  const T *at(uint64_t offset) const {
+    return reinterpret_cast<const T*>(data + offset);
+  }
+
+  const char *data{nullptr};
+  size_t size{0};
+
+  const NpnMmapHeader *header{nullptr};
+  const NpnMmapClass *classes{nullptr};
+  const NpnMmapSubnet *subnets{nullptr};
+  const Entry *entries{nullptr};
+
+  /// Materialized subnets (lazily filled per class).
+  std::vector<SubnetIDList> cache;
+  std::vector<bool> isCached;
+  size_t nMaterialized{0};
+};
+
+/**
+ * \brief Loads the NPN database stored in the LOGDB text format.
+ *
+ * The binary image `<filename>.npndb` is used as a cache: it is mapped if it
+ * is valid and not older than the text file; otherwise, the text file is
+ * parsed and the image is (re)written (if the directory is writable).
+ */
+std::unique_ptr<NpnDatabase> loadNpnDatabase(const std::string &filename,
+                                             uint8_t nInputs);
+
+} // namespace eda::gate::optimizer
@@ -8,11 +8,12 @@
 
 #include "gate/model/printer/net_printer.h"
 #include "gate/optimizer/npnstatdb.h"
+#include "util/npn_canonization.h"
 
 namespace eda::gate::optimizer {
 
 NpnStatDatabase::ResultIterator NpnStatDatabase::get(const TT &tt, bool quiet) {
-  auto config = kitty::exact_npn_canonization(tt);
+  auto config = util::npnCanonization(tt);
   NpnTransformation t = util::getTransformation(config);
   auto canonTT = util::getTT(config);
   if (!quiet) {
@@ -44,12 +45,13 @@ NpnStatDatabase::NpnTransformation
 NpnStatDatabase::push(const SubnetID &id,
                       const SubnetInfo &subnetInfo) {
   TT tt = model::evaluate(Subnet::get(id))[0];
-  auto config = kitty::exact_npn_canonization(tt);
+  auto config = util::npnCanonization(tt);
   NpnTransformation t = util::getTransformation(config);
   TT canonTT = util::getTT(config);
   auto newId = util::npnTransform(Subnet::get(id), t);
   storage[canonTT].push_back(newId);
   info[canonTT].push_back(subnetInfo);
+  addCost(newId);
   return t;
 }
 
@@ -90,6 +92,7 @@ NpnStatDatabase NpnStatDatabaseSerializer::deserialize(std::istream &in) {
   result.storage = storageSerializer.deserialize(in);
   result.info = infoSerializer.deserialize(in);
   result.accessCounter = acSerializer.deserialize(in);
+  result.addCosts();
   return result;
 }
 
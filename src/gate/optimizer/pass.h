@@ -111,6 +111,17 @@ inline SubnetPass rwzxag4() {
   return rwxag4(true);
 }
 
+/// Delay-aware rewriting: the XAG implementations are selected by the depths
+/// of the cut leaves; the depth is minimized first, then the size.
+inline SubnetPass rwdxag4() {
+  const uint16_t k = 4;
+  static Resynthesizer resynthesizer(synthesis::DbXag4Synthesizer::get());
+  return std::make_shared<Rewriter>(
+      "rwdxag4", resynthesizer, k, [](const SubnetEffect &effect) -> float {
+        return effect.depth < 0 ? -1.f : effect.depth * 1024.f + effect.size;
+      }, false, true);
+}
+
 //===----------------------------------------------------------------------===//
 // Refactor (rf)
 //===----------------------------------------------------------------------===//
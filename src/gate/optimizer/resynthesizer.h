@@ -16,6 +16,8 @@
 
 #include <cassert>
 #include <cstdint>
+#include <optional>
+#include <vector>
 
 namespace eda::gate::optimizer {
 
@@ -34,6 +36,34 @@ public:
   virtual model::SubnetObject resynthesize(
       const model::SubnetView &window,
       const uint16_t maxArity = -1) const = 0;
+
+  /**
+   * @brief Resynthesizes the subnet view minimizing the output arrival time
+   * given the arrival times of the view inputs (by default, ignores them).
+   * @return The identifier of the newly constructed subnet or OBJ_NULL_ID.
+   */
+  virtual model::SubnetObject resynthesizeBest(
+      const model::SubnetView &window,
+      const std::vector<float> &arrivals,
+      const uint16_t maxArity = -1) const {
+    return resynthesize(window, maxArity);
+  }
+
+  /// Checks whether the resynthesizer provides the views of the precomputed
+  /// implementations (see resynthesizeView()).
+  virtual bool hasViews() const { return false; }
+
+  /**
+   * @brief Returns the view of the precomputed implementation of the subnet
+   * view (w/ the minimal output arrival time if the input arrival times are
+   * given). Unlike resynthesize(), no subnet is built.
+   * @return The view or nullopt if there is no implementation.
+   */
+  virtual std::optional<model::SubnetNpnView> resynthesizeView(
+      const model::SubnetView &window,
+      const std::vector<float> *arrivals = nullptr) const {
+    return std::nullopt;
+  }
 };
 
 /**
@@ -58,6 +88,25 @@ public:
     return synthesizer.synthesize(ir, window.getCare(), maxArity);
   }
 
+  model::SubnetObject resynthesizeBest(
+      const model::SubnetView &window,
+      const std::vector<float> &arrivals,
+      const uint16_t maxArity = -1) const override {
+    const auto ir = construct<IR>(window);
+    return synthesizer.synthesizeBest(ir, window.getCare(), arrivals, maxArity);
+  }
+
+  bool hasViews() const override {
+    return synthesizer.hasViews();
+  }
+
+  std::optional<model::SubnetNpnView> resynthesizeView(
+      const model::SubnetView &window,
+      const std::vector<float> *arrivals = nullptr) const override {
+    const auto ir = construct<IR>(window);
+    return synthesizer.synthesizeView(ir, arrivals);
+  }
+
 private:
   const Synthesizer<IR> &synthesizer;
 };
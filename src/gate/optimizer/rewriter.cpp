@@ -8,7 +8,10 @@
 
 #include "rewriter.h"
 
+#include <cmath>
 #include <limits>
+#include <optional>
+#include <vector>
 
 namespace eda::gate::optimizer {
 
@@ -43,26 +46,63 @@ void Rewriter::rewriteOnNode(
   const auto &cuts = cutExtractor.getCuts(entryID);
   float bestMetricValue = std::numeric_limits<float>::lowest();
   SubnetObject bestRhs{};
+  std::optional<SubnetNpnView> bestView{};
   InOutMapping bestMap{};
+  std::vector<float> arrivals;
+
+  // The precomputed implementations are evaluated w/o building them.
+  const bool useViews = resynthesizer.hasViews();
 
   for (const auto &cut : cuts) {
     SubnetView cone(builder, cut);
-    SubnetObject rhs = resynthesizer.resynthesize(cone);
-    if (rhs.isNull()) {
-      continue;
+    if (delayAware) {
+      const auto &inputs = cone.getInOutMapping().inputs;
+      arrivals.resize(inputs.size());
+      for (size_t i = 0; i < inputs.size(); ++i) {
+        arrivals[i] = builder->getDepth(inputs[i].idx);
+      }
+    }
+
+    const auto view = useViews
+        ? resynthesizer.resynthesizeView(cone, delayAware ? &arrivals : nullptr)
+        : std::optional<SubnetNpnView>{};
+    SubnetObject rhs{};
+    if (useViews) {
+      if (!view) {
+        continue;
+      }
+    } else {
+      rhs = delayAware
+          ? resynthesizer.resynthesizeBest(cone, arrivals)
+          : resynthesizer.resynthesize(cone);
+      if (rhs.isNull()) {
+        continue;
+      }
     }
+
     const auto rhsToLhs = cone.getInOutMapping();
-    float curMetricValue = cost(builder->evaluateReplace(rhs, rhsToLhs));
+    float curMetricValue = cost(view
+        ? builder->evaluateReplace(*view, rhsToLhs)
+        : builder->evaluateReplace(rhs, rhsToLhs));
     if (curMetricValue - bestMetricValue > metricEps) {
       bestMetricValue = curMetricValue;
-      bestRhs = std::move(rhs);
+      if (view) {
+        bestView.emplace(*view);
+      } else {
+        bestRhs = std::move(rhs);
+      }
       bestMap = rhsToLhs;
     }
   }
   if (bestMetricValue > metricEps ||
       (zeroCost && std::fabs(bestMetricValue) <= metricEps)) {
-    iter.replace(bestRhs, bestMap, cutRecompute, cutRecompute, cutRecompute,
-                 cutRecomputeDepthCond);
+    if (bestView) {
+      iter.replace(*bestView, bestMap, cutRecompute, cutRecompute,
+                   cutRecompute, cutRecomputeDepthCond);
+    } else {
+      iter.replace(bestRhs, bestMap, cutRecompute, cutRecompute, cutRecompute,
+                   cutRecomputeDepthCond);
+    }
   }
 }
 
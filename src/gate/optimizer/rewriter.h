@@ -32,6 +32,7 @@ public:
   using SubnetBuilder = model::SubnetBuilder;
   using SubnetObject = model::SubnetObject;
   using SubnetView = model::SubnetView;
+  using SubnetNpnView = model::SubnetNpnView;
   using LinkList = Subnet::LinkList;
   using Effect = SubnetBuilder::Effect;
   using CellActionCallback = SubnetBuilder::CellActionCallback;
@@ -47,15 +48,19 @@ public:
    * @param cost Function that calculates the overall metric after replacement.
    * A greater returned value is a better result of the replacement.
    * @param zeroCost Enables zero-cost replacements if set.
+   * @param delayAware Passes the depths of the cut leaves to the resynthesizer
+   * as the input arrival times if set (see resynthesizeBest()).
    */
   Rewriter(
       const std::string &name,
       const ResynthesizerBase &resynthesizer,
       const uint16_t k,
       const std::function<float(const Effect &)> cost,
-      const bool zeroCost = false):
+      const bool zeroCost = false,
+      const bool delayAware = false):
     SubnetInPlaceTransformer(name),
-    resynthesizer(resynthesizer), k(k), cost(cost), zeroCost(zeroCost) {}
+    resynthesizer(resynthesizer), k(k), cost(cost), zeroCost(zeroCost),
+    delayAware(delayAware) {}
 
   /**
    * @brief Rewrites the subnet stored in the builder by applying the
@@ -77,6 +82,7 @@ private:
   const uint16_t k;
   const std::function<float(const Effect &)> cost;
   const bool zeroCost;
+  const bool delayAware;
 
   constexpr static float metricEps = 1e-6;
 };
@@ -208,6 +208,44 @@ void SafePasser::replace(
   recomputeNext(oldRootDepth, rootLastDepth);
 }
 
+void SafePasser::replace(
+    const model::SubnetNpnView &rhs,
+    const InOutMapping &rhsToLhsMapping,
+    const CellActionCallback *onNewCell,
+    const CellActionCallback *onEqualDepth,
+    const CellActionCallback *onGreaterDepth,
+    const CellCallbackCondition *onRecomputedDepth) {
+
+  const auto oldRootDepth = builder->getDepth(entry);
+  const bool rootLastDepth = builder->getLastWithDepth(oldRootDepth) == entry;
+  prepareForReplace(rhs.getMaxIdx(), rhsToLhsMapping);
+  auto &_isNewEntry = this->isNewEntry;
+  std::function addNewCell = [&_isNewEntry, &onNewCell](const EntryID entryID) {
+    if (_isNewEntry.size() <= entryID) {
+      _isNewEntry.resize(entryID + 1, false);
+    }
+    _isNewEntry[entryID] = true;
+
+    // Callback passed by user
+    if (onNewCell) {
+      (*onNewCell)(entryID);
+    }
+  };
+
+  const auto &_builder = builder;
+  std::function onRecompDepthWrap =
+      [&onRecomputedDepth, oldRootDepth, &_builder] (const EntryID entryID) {
+    if (onRecomputedDepth) {
+      (*onRecomputedDepth)(entryID, oldRootDepth, _builder->getDepth(entryID));
+    }
+  };
+
+  builderToTransform->replace(rhs, rhsToLhsMapping,
+                              &addNewCell, onEqualDepth, onGreaterDepth,
+                              &onRecompDepthWrap);
+  recomputeNext(oldRootDepth, rootLastDepth);
+}
+
 void SafePasser::finalizePass() {
   isNewEntry.clear();
   saveNext = SubnetBuilder::invalidID;
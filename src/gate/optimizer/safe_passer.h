@@ -9,6 +9,7 @@
 #pragma once
 
 #include "gate/model/subnet.h"
+#include "gate/model/subnet_npn_view.h"
 
 namespace eda::gate::optimizer {
 
@@ -102,6 +103,18 @@ public:
       const CellActionCallback *onGreaterDepth = nullptr,
       const CellCallbackCondition *onRecomputedDepth = nullptr);
 
+  /**
+   * @brief SubnetBuilder::replace(...) wrapper that allows to maintain next
+   * passer iterations safe. Version with SubnetNpnView rhs.
+   */
+  void replace(
+      const model::SubnetNpnView &rhs,
+      const InOutMapping &rhsToLhsMapping,
+      const CellActionCallback *onNewCell = nullptr,
+      const CellActionCallback *onEqualDepth = nullptr,
+      const CellActionCallback *onGreaterDepth = nullptr,
+      const CellCallbackCondition *onRecomputedDepth = nullptr);
+
   /// Clears information about unsafe entries in subnet builder.
   void finalizePass();
 
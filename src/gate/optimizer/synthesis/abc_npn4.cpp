@@ -10,6 +10,7 @@
   #include "gate/optimizer/npn.h"
 #endif // NPN4_USAGE_STATS
 #include "gate/optimizer/synthesis/abc_npn4.h"
+#include "util/npn_canonization.h"
 
 #include "kitty/kitty.hpp"
 
@@ -189,7 +190,7 @@ model::SubnetID Database::find(const model::TruthTable &tt) const {
   const model::TruthTable ttk =
       tt.num_vars() < k ? kitty::extend_to(tt, k) : tt;
 
-  const auto npnCanon = kitty::exact_npn_canonization(ttk);
+  const auto npnCanon = util::npnCanonization(ttk);
   const auto npnTable = static_cast<uint16_t>(*std::get<0>(npnCanon).begin());
 
   const auto iterator = map.find(npnTable);
@@ -294,7 +295,7 @@ model::SubnetObject AbcNpn4Synthesizer::synthesize(
   const model::TruthTable
       ttk = tt.num_vars() < k ? kitty::extend_to(tt, k) : tt;
 
-  const auto npnCanon = kitty::exact_npn_canonization(ttk);
+  const auto npnCanon = util::npnCanonization(ttk);
   const auto npnTable = static_cast<uint16_t>(*std::get<0>(npnCanon).begin());
 
   count[npnTable]++;
@@ -6,17 +6,19 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "gate/optimizer/npndb_mmap.h"
 #include "gate/optimizer/synthesis/db_synthesizer.h"
 #include "util/env.h"
 
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
 
 #pragma once
 
 namespace eda::gate::optimizer::synthesis {
 
-static optimizer::NpnDatabase dbAig4;
-
 /**
  * \brief Implements synthesis based on NPN4 database precomputed in AIG basis.
  */
@@ -29,16 +31,30 @@ public:
                                  const model::TTn &,
                                  uint16_t) const override {
 
-    return DbSynthesizer::synthesize(func, dbAig4);
+    return DbSynthesizer::synthesize(func, *dbAig4);
+  }
+
+  model::SubnetObject synthesizeBest(const model::TTn &func,
+                                     const model::TTn &,
+                                     const std::vector<float> &arrivals,
+                                     uint16_t) const override {
+    return DbSynthesizer::synthesize(func, arrivals, *dbAig4);
+  }
+
+  std::optional<model::SubnetNpnView> synthesizeView(
+      const model::TTn &func,
+      const std::vector<float> *arrivals) const override {
+    return DbSynthesizer::synthesizeView(func, arrivals, *dbAig4);
   }
 
 private:
   DbAig4Synthesizer() {
     const size_t k = 4;
     const auto aig4 = env::getHomePath() / "logdb" / "aig4";
-    dbAig4 = optimizer::NpnDatabase::importFrom(aig4);
-    dbAig4.setInNum(k);
+    dbAig4 = optimizer::loadNpnDatabase(aig4, k);
   }
+
+  std::unique_ptr<optimizer::NpnDatabase> dbAig4;
 };
 
 } // namespace eda::gate::optimizer::synthesis
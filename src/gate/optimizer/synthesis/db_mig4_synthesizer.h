@@ -6,17 +6,19 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "gate/optimizer/npndb_mmap.h"
 #include "gate/optimizer/synthesis/db_synthesizer.h"
 #include "util/env.h"
 
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
 
 #pragma once
 
 namespace eda::gate::optimizer::synthesis {
 
-static optimizer::NpnDatabase dbMig4;
-
 /**
  * \brief Implements synthesis based on NPN4 database precomputed in MIG basis.
  */
@@ -29,16 +31,30 @@ public:
                                  const model::TTn &,
                                  uint16_t) const override {
 
-    return DbSynthesizer::synthesize(func, dbMig4);
+    return DbSynthesizer::synthesize(func, *dbMig4);
+  }
+
+  model::SubnetObject synthesizeBest(const model::TTn &func,
+                                     const model::TTn &,
+                                     const std::vector<float> &arrivals,
+                                     uint16_t) const override {
+    return DbSynthesizer::synthesize(func, arrivals, *dbMig4);
+  }
+
+  std::optional<model::SubnetNpnView> synthesizeView(
+      const model::TTn &func,
+      const std::vector<float> *arrivals) const override {
+    return DbSynthesizer::synthesizeView(func, arrivals, *dbMig4);
   }
 
 private:
   DbMig4Synthesizer() {
     const size_t k = 4;
     const auto mig4 = env::getHomePath() / "logdb" / "percy_akers_mig4";
-    dbMig4 = optimizer::NpnDatabase::importFrom(mig4);
-    dbMig4.setInNum(k);
+    dbMig4 = optimizer::loadNpnDatabase(mig4, k);
   }
+
+  std::unique_ptr<optimizer::NpnDatabase> dbMig4;
 };
 
 } // namespace eda::gate::optimizer::synthesis
@@ -12,7 +12,9 @@
 #include "gate/optimizer/synthesizer.h"
 
 #include <filesystem>
+#include <optional>
 #include <string>
+#include <vector>
 
 #pragma once
 
@@ -34,8 +36,36 @@ public:
     if (iter.isEnd()) {
       return SubnetObject();
     }
-    SubnetObject object(iter.get());
-    return object;
+    // The result is not allocated in the storage: the candidates are usually
+    // evaluated and discarded.
+    return iter.getObject();
+  }
+
+  bool hasViews() const override { return true; }
+
+  /// Returns the view of the stored implementation (w/ the minimal output
+  /// arrival time if the arrival times of the function inputs are given).
+  std::optional<model::SubnetNpnView> synthesizeView(
+      const model::TTn &func,
+      const std::vector<float> *arrivals,
+      NpnDatabase &db) const {
+    const auto &iter = arrivals ? db.getBest(func, *arrivals) : db.get(func);
+    if (iter.isEnd()) {
+      return std::nullopt;
+    }
+    return iter.getView();
+  }
+
+  /// Synthesizes the implementation w/ the minimal output arrival time given
+  /// the arrival times of the function inputs.
+  SubnetObject synthesize(const model::TTn &func,
+                          const std::vector<float> &arrivals,
+                          NpnDatabase &db) const {
+    const auto &iter = db.getBest(func, arrivals);
+    if (iter.isEnd()) {
+      return SubnetObject();
+    }
+    return iter.getObject();
   }
 
 };
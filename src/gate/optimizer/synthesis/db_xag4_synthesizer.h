@@ -6,17 +6,19 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "gate/optimizer/npndb_mmap.h"
 #include "gate/optimizer/synthesis/db_synthesizer.h"
 #include "util/env.h"
 
 #include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
 
 #pragma once
 
 namespace eda::gate::optimizer::synthesis {
 
-static optimizer::NpnDatabase dbXag4;
-
 /**
  * \brief Implements synthesis based on NPN4 database precomputed in XAG basis.
  */
@@ -29,16 +31,30 @@ public:
                                  const model::TTn &,
                                  uint16_t) const override {
 
-    return DbSynthesizer::synthesize(func, dbXag4);
+    return DbSynthesizer::synthesize(func, *dbXag4);
+  }
+
+  model::SubnetObject synthesizeBest(const model::TTn &func,
+                                     const model::TTn &,
+                                     const std::vector<float> &arrivals,
+                                     uint16_t) const override {
+    return DbSynthesizer::synthesize(func, arrivals, *dbXag4);
+  }
+
+  std::optional<model::SubnetNpnView> synthesizeView(
+      const model::TTn &func,
+      const std::vector<float> *arrivals) const override {
+    return DbSynthesizer::synthesizeView(func, arrivals, *dbXag4);
   }
 
 private:
   DbXag4Synthesizer() {
     const size_t k = 4;
     const auto xag4 = env::getHomePath() / "logdb" / "area_delay_xag4";
-    dbXag4 = optimizer::NpnDatabase::importFrom(xag4);
-    dbXag4.setInNum(k);
+    dbXag4 = optimizer::loadNpnDatabase(xag4, k);
   }
+
+  std::unique_ptr<optimizer::NpnDatabase> dbXag4;
 };
 
 } // namespace eda::gate::optimizer::synthesis
@@ -11,9 +11,12 @@
 #include "gate/function/bdd.h"
 #include "gate/function/truth_table.h"
 #include "gate/model/subnet.h"
+#include "gate/model/subnet_npn_view.h"
 
 #include <cassert>
 #include <cstdint>
+#include <optional>
+#include <vector>
 
 namespace eda::gate::optimizer {
 
@@ -46,6 +49,35 @@ public:
       const uint16_t maxArity = -1) const {
     return synthesize(ir, model::TruthTable{}, maxArity);
   }
+
+  /**
+   * @brief Synthesizes a subnet w/ the minimal output arrival time given
+   * the arrival times of the IR inputs (by default, ignores the arrivals).
+   * @return The identifier of the newly constructed subnet or OBJ_NULL_ID.
+   */
+  virtual model::SubnetObject synthesizeBest(
+      const IR &ir,
+      const model::TruthTable &care,
+      const std::vector<float> &arrivals,
+      const uint16_t maxArity = -1) const {
+    return synthesize(ir, care, maxArity);
+  }
+
+  /// Checks whether the synthesizer provides the views of the precomputed
+  /// implementations (see synthesizeView()).
+  virtual bool hasViews() const { return false; }
+
+  /**
+   * @brief Returns the view of the precomputed implementation of the IR
+   * (w/ the minimal output arrival time if the input arrival times are
+   * given). Unlike synthesize(), no subnet is built.
+   * @return The view or nullopt if there is no implementation.
+   */
+  virtual std::optional<model::SubnetNpnView> synthesizeView(
+      const IR &ir,
+      const std::vector<float> *arrivals = nullptr) const {
+    return std::nullopt;
+  }
 };
 
 /// BDD-based synthesizer.
@@ -36,20 +36,39 @@ public:
     return makeLit(newVar(), sign);
   }
 
+  /// Returns the number of variables.
+  size_t getVarNum() const {
+    return formula.nVars();
+  }
+
+  /// Returns the number of clauses added.
+  size_t getClauseNum() const {
+    return nClauses;
+  }
+
+  /// Specifies whether the variable is used for decisions.
+  void setDecision(Variable var, bool isDecision) {
+    formula.setDecisionVar(var, isDecision);
+  }
+
   void addClause(const Clause &clause) {
     formula.addClause(clause);
+    nClauses++;
   }
 
   void addClause(Literal l) {
     formula.addClause(l);
+    nClauses++;
   }
 
   void addClause(Literal l1, Literal l2) {
     formula.addClause(l1, l2);
+    nClauses++;
   }
 
   void addClause(Literal l1, Literal l2, Literal l3) {
     formula.addClause(l1, l2, l3);
+    nClauses++;
   }
 
   void addClause(Literal l1, Literal l2, Literal l3, Literal l4) {
@@ -95,21 +114,28 @@ public:
     addClause( rhs,  lhs1, ~lhs2);
   }
 
-  void encodeMaj(Literal rhs, Literal lhs1, Literal lhs2, Literal lhs3) {
-    auto tmp1 = newLit();
-    auto tmp2 = newLit();
-    auto tmp3 = newLit();
-
-    // t1 = (x1 & x2), t2 = (x1 & x3), t3 = (x2 & x3).
-    encodeAnd(tmp1, lhs1, lhs2);
-    encodeAnd(tmp2, lhs1, lhs3);
-    encodeAnd(tmp3, lhs2, lhs3);
+  /// Encodes y = (x1 ^ x2 ^ x3) w/o auxiliary variables (8 clauses).
+  void encodeXor(Literal rhs, Literal lhs1, Literal lhs2, Literal lhs3) {
+    // Each clause prohibits the wrong output for an input combination.
+    for (unsigned values = 0; values < 8; ++values) {
+      const bool v1 = values & 1, v2 = values & 2, v3 = values & 4;
+      addClause(v1 ? ~lhs1 : lhs1,
+                v2 ? ~lhs2 : lhs2,
+                v3 ? ~lhs3 : lhs3,
+                (v1 ^ v2 ^ v3) ? rhs : ~rhs);
+    }
+  }
 
-    // y = maj(x1, x2, x3) = (t1 | t2 | t3).
-    addClause(~rhs, tmp1, tmp2, tmp3);
-    addClause(rhs, ~tmp1);
-    addClause(rhs, ~tmp2);
-    addClause(rhs, ~tmp3);
+  /// Encodes y = maj(x1, x2, x3) w/o auxiliary variables (6 clauses).
+  void encodeMaj(Literal rhs, Literal lhs1, Literal lhs2, Literal lhs3) {
+    // Any two ones imply one.
+    addClause( rhs, ~lhs1, ~lhs2);
+    addClause( rhs, ~lhs1, ~lhs3);
+    addClause( rhs, ~lhs2, ~lhs3);
+    // Any two zeros imply zero.
+    addClause(~rhs,  lhs1,  lhs2);
+    addClause(~rhs,  lhs1,  lhs3);
+    addClause(~rhs,  lhs2,  lhs3);
   }
 
   bool solve() {
@@ -122,6 +148,20 @@ public:
     return formula.solve();
   }
 
+  /// Solves the formula under the assumptions.
+  bool solve(const Clause &assumptions) {
+    formula.budgetOff();
+    return formula.solve(assumptions);
+  }
+
+  /// Solves the formula under the assumptions w/ the conflict budget
+  /// (returns l_Undef if the budget is exhausted).
+  Minisat::lbool solveLimited(const Clause &assumptions, uint64_t confBudget) {
+    formula.budgetOff();
+    formula.setConfBudget(confBudget);
+    return formula.solveLimited(assumptions);
+  }
+
   /// Returns the variable value (if the formula is SAT).
   bool value(Variable var) {
     return formula.modelValue(var) == Minisat::l_True;
@@ -134,6 +174,7 @@ public:
 
 private:
   Formula formula;
+  size_t nClauses{0};
 };
 
 } // namespace eda::gate::solver
@@ -0,0 +1,309 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/function/truth_table.h"
+#include "gate/model/utils/subnet_truth_table.h"
+#include "gate/techmapper/gate_sizer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <unordered_set>
+
+namespace eda::gate::techmapper {
+
+using CellTypeID = model::CellTypeID;
+using EntryID = model::EntryID;
+using Link = model::Subnet::Link;
+
+/// Minimal delay improvement of a move.
+static constexpr double Epsilon = 1e-6;
+
+static double getArea(const CellTypeID typeID) {
+  return model::CellType::get(typeID).getAttr().getPhysProps().area;
+}
+
+static double getArea(const model::SubnetBuilder &builder,
+                      const library::SCLibrary &library) {
+  double area = 0.;
+  for (auto it = builder.begin(); it != builder.end(); it.nextCell()) {
+    const auto typeID = builder.getCell(*it).getTypeID();
+    if (library.getCellPtr(typeID)) {
+      area += getArea(typeID);
+    }
+  }
+  return area;
+}
+
+GateSizer::GateSizer(const library::SCLibrary &library,
+                     const Settings &settings):
+    library(library), settings(settings) {
+  std::unordered_map<model::TruthTable, size_t> groupByFunction;
+
+  for (const auto &cell : library.getCombCells()) {
+    const auto &type = model::CellType::get(cell.cellTypeID);
+
+    // Composite cells (supercells, etc.) are inlined by the mapper.
+    if (!type.isSubnet() || type.getSubnet().isTechMapped()) {
+      continue;
+    }
+    if (type.getInNum() == 0 || type.getOutNum() != 1) {
+      continue;
+    }
+    if (cell.outputPins.empty() || cell.outputPins[0].timingArcs.empty()) {
+      continue;
+    }
+
+    // The same function implies the same pin order.
+    const auto function = model::evaluateSingleOut(type.getSubnet());
+    const auto [i, isNew] =
+        groupByFunction.emplace(function, groups.size());
+    if (isNew) {
+      groups.emplace_back();
+    }
+    groups[i->second].push_back(cell.cellTypeID);
+    groupOf[cell.cellTypeID] = i->second;
+  }
+
+  for (auto &group : groups) {
+    std::stable_sort(group.begin(), group.end(),
+        [](CellTypeID lhs, CellTypeID rhs) {
+          return getArea(lhs) < getArea(rhs);
+        });
+  }
+
+  model::TruthTable identity(1);
+  kitty::create_nth_var(identity, 0);
+  if (const auto i = groupByFunction.find(identity);
+      i != groupByFunction.end()) {
+    bufferGroup = i->second;
+  }
+}
+
+const std::vector<CellTypeID> &GateSizer::getVariants(
+    CellTypeID typeID) const {
+  static const std::vector<CellTypeID> empty{};
+  const auto i = groupOf.find(typeID);
+  return i != groupOf.end() ? groups[i->second] : empty;
+}
+
+void GateSizer::resize(SubnetBuilder &builder,
+                       Analyzer &analyzer,
+                       EntryID entryID,
+                       CellTypeID typeID) const {
+  const auto callback = analyzer.getChangeCallback();
+  const auto links = builder.getLinks(entryID);
+  builder.replaceCell(entryID, typeID, links, true, &callback, &callback);
+  analyzer.update();
+}
+
+void GateSizer::relink(SubnetBuilder &builder,
+                       Analyzer &analyzer,
+                       EntryID fanoutID,
+                       EntryID sourceID,
+                       EntryID targetID) const {
+  const auto callback = analyzer.getChangeCallback();
+  auto links = builder.getLinks(fanoutID);
+  for (auto &link : links) {
+    if (link.idx == sourceID) {
+      link.idx = targetID;
+    }
+  }
+  builder.replaceCell(fanoutID, builder.getCell(fanoutID).getTypeID(), links,
+                      true, &callback, &callback);
+}
+
+std::vector<EntryID> GateSizer::getNonCriticalFanouts(
+    const SubnetBuilder &builder,
+    const Analyzer &analyzer,
+    EntryID entryID) const {
+  auto fanouts = builder.getFanouts(entryID);
+  std::sort(fanouts.begin(), fanouts.end());
+  fanouts.erase(std::unique(fanouts.begin(), fanouts.end()), fanouts.end());
+
+  if (fanouts.size() <= settings.maxFanout) {
+    return {};
+  }
+
+  // The most critical fanouts are left at the driver.
+  std::stable_sort(fanouts.begin(), fanouts.end(),
+      [&analyzer](EntryID lhs, EntryID rhs) {
+        return analyzer.getSlack(lhs) < analyzer.getSlack(rhs);
+      });
+
+  const auto worstSlack = analyzer.getSlack(fanouts.front());
+  size_t nCritical = 1;
+  while (nCritical < fanouts.size() &&
+         analyzer.getSlack(fanouts[nCritical]) <= worstSlack + Epsilon) {
+    nCritical++;
+  }
+  nCritical = std::max(nCritical, fanouts.size() - settings.maxFanout);
+
+  if (fanouts.size() - nCritical < 2) {
+    return {};
+  }
+  return std::vector<EntryID>(fanouts.begin() + nCritical, fanouts.end());
+}
+
+GateSizer::Buffering GateSizer::buffer(SubnetBuilder &builder,
+                                       Analyzer &analyzer,
+                                       EntryID entryID,
+                                       CellTypeID typeID) const {
+  const auto fanouts = getNonCriticalFanouts(builder, analyzer, entryID);
+  assert(!fanouts.empty());
+
+  // Strashing may return the buffer inserted by a previous move.
+  Buffering buffering;
+  buffering.bufferID = builder.addCell(typeID, {Link{entryID}}).idx;
+  buffering.isNew = builder.getFanouts(buffering.bufferID).empty();
+  analyzer.markChanged(buffering.bufferID);
+
+  for (const auto fanoutID : fanouts) {
+    if (fanoutID != buffering.bufferID) {
+      relink(builder, analyzer, fanoutID, entryID, buffering.bufferID);
+      buffering.fanouts.push_back(fanoutID);
+    }
+  }
+  analyzer.update();
+  return buffering;
+}
+
+void GateSizer::unbuffer(SubnetBuilder &builder,
+                         Analyzer &analyzer,
+                         EntryID entryID,
+                         const Buffering &buffering) const {
+  // Only the moved fanouts are restored (the reused buffer keeps the others).
+  // The new buffer is deleted when its last fanout is relinked.
+  for (const auto fanoutID : buffering.fanouts) {
+    relink(builder, analyzer, fanoutID, buffering.bufferID, entryID);
+  }
+  analyzer.update();
+}
+
+void GateSizer::tryResize(SubnetBuilder &builder,
+                          Analyzer &analyzer,
+                          EntryID entryID,
+                          Move &best) const {
+  const auto oldTypeID = builder.getCell(entryID).getTypeID();
+  const auto oldArea = getArea(oldTypeID);
+
+  for (const auto typeID : getVariants(oldTypeID)) {
+    if (typeID == oldTypeID) {
+      continue;
+    }
+
+    resize(builder, analyzer, entryID, typeID);
+    const Move move{Move::RESIZE, entryID, typeID, analyzer.getDelay(),
+                    getArea(typeID) - oldArea};
+    resize(builder, analyzer, entryID, oldTypeID);
+
+    if (move.delay < best.delay - Epsilon ||
+        (move.delay < best.delay + Epsilon && move.area < best.area)) {
+      best = move;
+    }
+  }
+}
+
+void GateSizer::tryBuffer(SubnetBuilder &builder,
+                          Analyzer &analyzer,
+                          EntryID entryID,
+                          Move &best) const {
+  if (bufferGroup >= groups.size() ||
+      builder.getCell(entryID).getOutNum() != 1 ||
+      getNonCriticalFanouts(builder, analyzer, entryID).empty()) {
+    return;
+  }
+
+  for (const auto typeID : groups[bufferGroup]) {
+    const auto buffering = buffer(builder, analyzer, entryID, typeID);
+    const Move move{Move::BUFFER, entryID, typeID, analyzer.getDelay(),
+                    buffering.isNew ? getArea(typeID) : 0.};
+    unbuffer(builder, analyzer, entryID, buffering);
+
+    if (buffering.fanouts.empty()) {
+      continue;
+    }
+
+    if (move.delay < best.delay - Epsilon ||
+        (move.delay < best.delay + Epsilon && move.area < best.area)) {
+      best = move;
+    }
+  }
+}
+
+GateSizer::Result GateSizer::size(SubnetBuilder &builder) const {
+  const bool fanoutsEnabled = builder.areFanoutsEnabled();
+
+  Analyzer::Settings analyzerSettings;
+  analyzerSettings.requiredTime = settings.maxDelay;
+  Analyzer analyzer(builder, library, analyzerSettings);
+
+  Result result;
+  result.oldDelay = analyzer.getDelay();
+  result.oldArea = getArea(builder, library);
+
+  // Upsizing and buffering the critical paths.
+  std::unordered_set<EntryID> resized;
+  for (size_t i = 0; i < settings.maxMoves; ++i) {
+    if (analyzer.getDelay() <= settings.maxDelay) {
+      break;
+    }
+
+    Move best;
+    best.delay = analyzer.getDelay();
+    best.area = 0.;
+
+    for (const auto &point : analyzer.getCriticalPath()) {
+      const auto &cell = builder.getCell(point.entryID);
+      if (cell.isIn() || cell.isOut()) {
+        continue;
+      }
+      tryResize(builder, analyzer, point.entryID, best);
+      if (settings.buffering) {
+        tryBuffer(builder, analyzer, point.entryID, best);
+      }
+    }
+
+    if (best.kind == Move::RESIZE) {
+      resize(builder, analyzer, best.entryID, best.typeID);
+      resized.insert(best.entryID);
+    } else if (best.kind == Move::BUFFER) {
+      const auto buffering =
+          buffer(builder, analyzer, best.entryID, best.typeID);
+      result.nBuffers += buffering.isNew ? 1 : 0;
+    } else {
+      break;
+    }
+  }
+
+  // Area recovery: downsizing the upsized cells w/o violating the constraint.
+  const auto maxDelay = std::max(settings.maxDelay, analyzer.getDelay());
+  for (const auto entryID : resized) {
+    const auto oldTypeID = builder.getCell(entryID).getTypeID();
+    for (const auto typeID : getVariants(oldTypeID)) {
+      if (getArea(typeID) >= getArea(oldTypeID)) {
+        break;
+      }
+      resize(builder, analyzer, entryID, typeID);
+      if (analyzer.getDelay() <= maxDelay) {
+        break;
+      }
+      resize(builder, analyzer, entryID, oldTypeID);
+    }
+  }
+
+  result.nResized = resized.size();
+  result.newDelay = analyzer.getDelay();
+  result.newArea = getArea(builder, library);
+
+  if (!fanoutsEnabled) {
+    builder.disableFanouts();
+  }
+  return result;
+}
+
+} // namespace eda::gate::techmapper
@@ -0,0 +1,146 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "gate/estimator/timing_analyzer.h"
+#include "gate/library/library.h"
+#include "gate/model/subnet.h"
+
+#include <cstddef>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace eda::gate::techmapper {
+
+/**
+ * \brief Timing-driven gate sizing and buffering of tech-mapped subnets.
+ *
+ * The cells implementing the same function w/ the same pin order (drive
+ * strength variants) are grouped on construction. The sizer greedily
+ * applies the best move on the critical path (resizing a cell or buffering
+ * the non-critical fanouts of a high-fanout net) until the delay constraint
+ * is met or there is no improving move. Then, the upsized cells are tried
+ * to be downsized back w/o violating the constraint. Each move is evaluated
+ * by the incremental timing analyzer.
+ *
+ * The sizer does not modify the library and can be shared between threads.
+ */
+class GateSizer final {
+public:
+  using SubnetBuilder = model::SubnetBuilder;
+
+  struct Settings final {
+    /// Delay constraint (the delay is minimized if not reachable).
+    double maxDelay{std::numeric_limits<double>::max()};
+    /// Maximum number of the applied moves.
+    size_t maxMoves{256};
+    /// Nets w/ a greater fanout are considered for buffering.
+    size_t maxFanout{8};
+    /// Enables buffer insertion.
+    bool buffering{true};
+  };
+
+  struct Result final {
+    double oldDelay{0.};
+    double newDelay{0.};
+    double oldArea{0.};
+    double newArea{0.};
+    /// Number of the resized cells.
+    size_t nResized{0};
+    /// Number of the inserted buffers.
+    size_t nBuffers{0};
+  };
+
+  GateSizer(const library::SCLibrary &library, const Settings &settings);
+
+  GateSizer(const library::SCLibrary &library):
+      GateSizer(library, Settings{}) {}
+
+  /// Sizes the cells of the tech-mapped subnet (in place).
+  Result size(SubnetBuilder &builder) const;
+
+  /// Returns the cell variants of the given cell type (sorted by area).
+  const std::vector<model::CellTypeID> &getVariants(
+      model::CellTypeID typeID) const;
+
+private:
+  using EntryID = model::EntryID;
+  using Analyzer = estimator::TimingAnalyzer;
+
+  struct Move final {
+    enum Kind { NONE, RESIZE, BUFFER } kind{NONE};
+    EntryID entryID{0};
+    model::CellTypeID typeID{model::OBJ_NULL_ID};
+    double delay{0.};
+    double area{0.};
+  };
+
+  /// Finds the best resizing of the cell.
+  void tryResize(SubnetBuilder &builder,
+                 Analyzer &analyzer,
+                 EntryID entryID,
+                 Move &best) const;
+
+  /// Finds the best buffering of the non-critical fanouts of the cell.
+  void tryBuffer(SubnetBuilder &builder,
+                 Analyzer &analyzer,
+                 EntryID entryID,
+                 Move &best) const;
+
+  /// Replaces the cell type keeping the links.
+  void resize(SubnetBuilder &builder,
+              Analyzer &analyzer,
+              EntryID entryID,
+              model::CellTypeID typeID) const;
+
+  /// Buffer insertion: the buffer and the fanouts moved to it.
+  struct Buffering final {
+    EntryID bufferID;
+    /// Set if the buffer has been created (not reused by strashing).
+    bool isNew;
+    std::vector<EntryID> fanouts;
+  };
+
+  /// Moves the non-critical fanouts of the cell to a buffer.
+  Buffering buffer(SubnetBuilder &builder,
+                   Analyzer &analyzer,
+                   EntryID entryID,
+                   model::CellTypeID typeID) const;
+
+  /// Moves the fanouts moved by the buffering back to the driver.
+  void unbuffer(SubnetBuilder &builder,
+                Analyzer &analyzer,
+                EntryID entryID,
+                const Buffering &buffering) const;
+
+  /// Returns the fanouts to be moved to a buffer.
+  std::vector<EntryID> getNonCriticalFanouts(const SubnetBuilder &builder,
+                                             const Analyzer &analyzer,
+                                             EntryID entryID) const;
+
+  /// Relinks the fanout from the source to the target.
+  void relink(SubnetBuilder &builder,
+              Analyzer &analyzer,
+              EntryID fanoutID,
+              EntryID sourceID,
+              EntryID targetID) const;
+
+  const library::SCLibrary &library;
+  const Settings settings;
+
+  /// Variant groups sorted by area.
+  std::vector<std::vector<model::CellTypeID>> groups;
+  /// Cell type to its variant group.
+  std::unordered_map<model::CellTypeID, size_t> groupOf;
+  /// Buffer group index (if any).
+  size_t bufferGroup{static_cast<size_t>(-1)};
+};
+
+} // namespace eda::gate::techmapper
@@ -22,9 +22,16 @@ namespace eda::gate::techmapper {
 
 template<typename BaseType, typename KeyType>
 class Matcher {
-  using StandardCell = library::StandardCell;
-
 public:
+  using StandardCell = library::StandardCell;
+  /// Library cell and its output.
+  using CellRef = std::pair<const StandardCell*, uint16_t>;
+  using CellList = std::vector<CellRef>;
+
+  /// Builds the matcher index once per library.
+  /// The cells are referenced by pointers, so they must outlive the matcher.
+  /// The built matcher is not modified by match(), so it can be shared by
+  /// the threads mapping different subnets.
   static std::unique_ptr<BaseType> create(
         const std::vector<StandardCell> &cells) {
 
@@ -35,7 +42,7 @@ public:
 
   virtual std::vector<SubnetTechMapperBase::Match> match(
       const std::shared_ptr<model::SubnetBuilder> &builder,
-      const optimizer::Cut &cut) = 0;
+      const optimizer::Cut &cut) const = 0;
 
   virtual ~Matcher() = default;
 
@@ -43,14 +50,13 @@ public:
     for (const auto& cell : cells) {
       uint16_t output = 0;
       for (const auto& ctt : cell.ctt) {
-        this->cells[ctt].push_back(std::pair{cell, output++});
+        static_cast<BaseType*>(this)->insert(ctt, CellRef{&cell, output++});
       }
     }
   }
 
 protected:
-  std::unordered_map<KeyType,
-    std::vector<std::pair<StandardCell, uint16_t>>> cells;
+  std::unordered_map<KeyType, CellList> cells;
 };
 
 } // namespace eda::gate::techmapper
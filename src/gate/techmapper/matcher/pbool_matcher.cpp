@@ -13,41 +13,72 @@
 #include "gate/debugger/sat_checker.h"
 #include "gate/model/utils/subnet_checking.h"
 #include "gate/optimizer/synthesis/isop.h"
+#include "util/npn_canonization.h"
 
 namespace eda::gate::techmapper {
-using StandardCell = library::StandardCell;
+
+void PBoolMatcher::insert(const model::TruthTable &ctt, const CellRef &cell) {
+  const size_t nVars = ctt.num_vars();
+  if (nVars <= MaxVars) {
+    cells[makeKey(nVars, *ctt.cbegin())].push_back(cell);
+  } else {
+    wideCells[ctt].push_back(cell);
+  }
+}
+
+const PBoolMatcher::CellList *PBoolMatcher::find(
+    size_t nVars, model::TT6 ctt) const {
+  const auto i = cells.find(makeKey(nVars, ctt));
+  return i != cells.end() ? &i->second : nullptr;
+}
+
+const PBoolMatcher::CellList *PBoolMatcher::find(
+    const model::TruthTable &ctt) const {
+  const size_t nVars = ctt.num_vars();
+  if (nVars <= MaxVars) {
+    return find(nVars, *ctt.cbegin());
+  }
+  const auto i = wideCells.find(ctt);
+  return i != wideCells.end() ? &i->second : nullptr;
+}
 
 std::vector<SubnetTechMapperBase::Match> PBoolMatcher::match(
     const model::TruthTable &truthTable,
-    const std::vector<model::EntryID> &entryIdxs) {
+    const std::vector<model::EntryID> &entryIdxs) const {
   std::vector<SubnetTechMapperBase::Match> matches;
 
-  auto config = kitty::exact_p_canonization(truthTable);
+  const size_t nVars = truthTable.num_vars();
+  if (nVars <= util::CanonizationTable::MaxVars) {
+    // Precomputed canonization: no canonized table is constructed.
+    const auto &table = util::CanonizationTable::getP(nVars);
+    const auto tt =
+        *truthTable.cbegin() & model::getMaskTruthTable<model::TT6>(nVars);
+    const auto &item = table.get(tt);
+    if (const auto *cellList = find(nVars, table.getClass(item.classIdx))) {
+      match(matches, *cellList, nVars, table.getPerm(item.permIdx), entryIdxs);
+    }
+  } else {
+    const auto config = util::pCanonization(truthTable);
+    if (const auto *cellList = find(util::getTT(config))) {
+      match(matches, *cellList, nVars, std::get<2>(config), entryIdxs);
+    }
+  }
+
+#ifdef DEBUG_MOUTS
+  const auto config = util::pCanonization(truthTable);
   const auto &ctt = util::getTT(config); // canonized TT
   util::NpnTransformation t = util::getTransformation(config);
-  std::vector<std::pair<StandardCell, uint16_t>> scs;
-
-  match(scs, ctt);
-
-  for (const auto &cell : scs) {
-    const auto output = cell.second;
-    const auto& techCell = cell.first;
 
-    assert(techCell.ctt[output] == ctt);
+  for (const auto &match : matches) {
+    const auto output = match.output;
+    const auto &linkList = match.links;
+    const auto &cellList = *find(ctt);
+    const auto &techCell = *std::find_if(cellList.begin(), cellList.end(),
+        [&match](const CellRef &cell) {
+          return cell.first->cellTypeID == match.typeID &&
+                 cell.second == match.output;
+        })->first;
 
-    model::Subnet::LinkList linkList(
-        techCell.transform[output].permutation.size());
-    uint i = 0;
-    for (const auto &index : t.permutation) {
-      linkList[techCell.transform[output].permutation.at(i++)] =
-        model::Subnet::Link{(uint32_t)entryIdxs.at(index)};
-    }
-
-    const auto match = SubnetTechMapperBase::Match{
-      techCell.cellTypeID, linkList, output};
-    matches.push_back(match);
-
-#ifdef DEBUG_MOUTS
     const auto synthesizer = optimizer::synthesis::MMSynthesizer();
     auto subnetObject = synthesizer.synthesize(truthTable);
     const auto beforeID = subnetObject.make();
@@ -61,7 +92,7 @@ std::vector<SubnetTechMapperBase::Match> PBoolMatcher::match(
 
     model::Subnet::LinkList inputsToCheck(
       techCell.transform[output].permutation.size());
-    i = 0;
+    size_t i = 0;
     for (const auto &index : t.permutation) {
       inputsToCheck[techCell.transform[output].permutation.at(i++)] =
         model::Subnet::Link{inputs.at(index)};
@@ -109,14 +140,42 @@ std::vector<SubnetTechMapperBase::Match> PBoolMatcher::match(
       std::cout << "counter example: " << std::endl; for (const auto c : ce) std::cout << (int) c; std::cout << std::endl;
       assert(false);
     }
-#endif
   }
+#endif
+
   return matches;
 }
 
+void PBoolMatcher::match(
+    std::vector<SubnetTechMapperBase::Match> &matches,
+    const CellList &cellList,
+    size_t nVars,
+    const std::vector<uint8_t> &permutation,
+    const std::vector<model::EntryID> &entryIdxs) const {
+  matches.reserve(cellList.size());
+
+  for (const auto &[cell, output] : cellList) {
+    const auto &techCell = *cell;
+    // Packed keys of different arities may coincide.
+    if (techCell.ctt[output].num_vars() != nVars) {
+      continue;
+    }
+
+    const auto &cellPermutation = techCell.transform[output].permutation;
+    model::Subnet::LinkList linkList(cellPermutation.size());
+    for (size_t i = 0; i < permutation.size(); ++i) {
+      linkList[cellPermutation[i]] =
+          model::Subnet::Link{(uint32_t)entryIdxs[permutation[i]]};
+    }
+
+    matches.push_back(SubnetTechMapperBase::Match{
+        techCell.cellTypeID, std::move(linkList), output});
+  }
+}
+
 std::vector<SubnetTechMapperBase::Match> PBoolMatcher::match(
     const std::shared_ptr<model::SubnetBuilder> &builder,
-    const optimizer::Cut &cut) {
+    const optimizer::Cut &cut) const {
   if (cut.isTrivial()) {
     const auto truthTable = model::getZeroTruthTable<model::TruthTable>(0);
     const auto isZero = builder->getCell(cut.rootID).isZero();
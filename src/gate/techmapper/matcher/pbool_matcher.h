@@ -11,30 +11,58 @@
 #include "gate/function/truth_table.h"
 #include "gate/techmapper/matcher/matcher.h"
 
-namespace eda::gate::techmapper {
+#include <cassert>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
 
-class PBoolMatcher final : public Matcher<PBoolMatcher, model::TruthTable> {
-  using StandardCell = library::StandardCell;
+namespace eda::gate::techmapper {
 
+/**
+ * \brief Matches cuts w/ library cells by P-canonized truth tables.
+ *
+ * The index is keyed by the packed canonized table (see makeKey()); the
+ * functions of up to 4 variables are canonized w/ the precomputed tables,
+ * so matching such a cut is a table lookup and a hash probe.
+ */
+class PBoolMatcher final : public Matcher<PBoolMatcher, model::TT6> {
 public:
-  inline void match(
-      std::vector<std::pair<StandardCell, uint16_t>> &scs,
-      const model::TruthTable &ctt) {
-
-    if (auto it = cells.find(ctt); it != cells.end()) {
-      for (const auto &cell : it->second) {
-        scs.push_back(cell);
-      }
-    }
+  /// Maximum number of variables of the packed key.
+  static constexpr size_t MaxVars = 6;
+
+  /// Packs the table of up to 6 variables: for n < 6 variables, the bit 2^n
+  /// marks the number of variables.
+  static model::TT6 makeKey(size_t nVars, model::TT6 tt) {
+    assert(nVars <= MaxVars);
+    tt &= model::getMaskTruthTable<model::TT6>(nVars);
+    return nVars < MaxVars ? (tt | (1ull << (1u << nVars))) : tt;
   }
 
+  /// Adds the cell output w/ the given canonized truth table to the index.
+  void insert(const model::TruthTable &ctt, const CellRef &cell);
+
+  /// Returns the cells w/ the given canonized truth table (or nullptr).
+  const CellList *find(const model::TruthTable &ctt) const;
+
   std::vector<SubnetTechMapperBase::Match> match(
       const model::TruthTable &truthTable,
-      const std::vector<model::EntryID> &entryIdxs);
+      const std::vector<model::EntryID> &entryIdxs) const;
 
   std::vector<SubnetTechMapperBase::Match> match(
       const std::shared_ptr<model::SubnetBuilder> &builder,
-      const optimizer::Cut &cut) override;
+      const optimizer::Cut &cut) const override;
+
+private:
+  const CellList *find(size_t nVars, model::TT6 ctt) const;
+
+  void match(std::vector<SubnetTechMapperBase::Match> &matches,
+             const CellList &cellList,
+             size_t nVars,
+             const std::vector<uint8_t> &permutation,
+             const std::vector<model::EntryID> &entryIdxs) const;
+
+  /// Cells w/ more than 6 inputs.
+  std::unordered_map<model::TruthTable, CellList> wideCells;
 };
 
 } // namespace eda::gate::techmapper
@@ -10,7 +10,9 @@
 #include "gate/model/subnetview.h"
 #include "gate/techmapper/subnet_techmapper_base.h"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 #include <memory>
 #include <queue>
 #include <unordered_set>
@@ -127,48 +129,11 @@ SubnetTechMapperBase::SubnetTechMapperBase(
 /// Maps a entry ID to the best match (null stands for no match).
 using MatchSelection = std::vector<const SubnetTechMapperBase::Match*>;
 
-/// Find best coverage by traversing the subnet in reverse order.
-static void findBestCoverage(
-    const SubnetTechMapperBase::SubnetBuilderPtr &oldBuilder,
-    const SubnetTechMapperBase::SubnetSpace &space,
-    MatchSelection &matches) {
-  model::SubnetView view(oldBuilder);
-  model::SubnetViewWalker walker(view,
-      [&matches](model::SubnetBuilder &,
-                 const uint32_t entryID) -> uint16_t {
-        // Returns the cell arity.
-        assert(matches[entryID]);
-        return matches[entryID]->links.size();
-      },
-      [&matches](model::SubnetBuilder &,
-                 const uint32_t entryID,
-                 const uint16_t linkIdx) -> model::Subnet::Link {
-        // Returns the corresponding link (cut boundary).
-        assert(matches[entryID]);
-        return matches[entryID]->links[linkIdx];
-      }
-  );
-
-  walker.runForward(
-      nullptr /* forward visitor */,
-      [&space, &matches](model::SubnetBuilder &,
-                         bool, bool,
-                         const uint32_t entryID) -> bool {
-        assert(!matches[entryID] && space[entryID]->hasSolution());
-        matches[entryID] = &space[entryID]->getBest().solution;
-        return true;
-      }, false);
-}
-
 static SubnetTechMapperBase::SubnetBuilderPtr makeMappedSubnet(
-    const SubnetTechMapperBase::SubnetSpace &space,
+    const MatchSelection &matches,
     const SubnetTechMapperBase::SubnetBuilderPtr oldBuilder) {
-  // Maps old entry indices to matches.
   const uint32_t oldSize = oldBuilder->getMaxIdx() + 1;
-  MatchSelection matches(oldSize);
-
-  // Find best coverage by traversing the subnet in reverse order.
-  findBestCoverage(oldBuilder, space, matches);
+  assert(matches.size() == oldSize);
 
   auto newBuilder = std::make_shared<model::SubnetBuilder>();
 
@@ -352,6 +317,9 @@ SubnetTechMapperBase::Status SubnetTechMapperBase::techMap(
   std::unordered_set<model::EntryID> outputs;
   outputs.reserve(builder->getOutNum());
 
+  order.clear();
+  outputIDs.clear();
+
   for (auto it = builder->begin(); it != builder->end(); it.nextCell()) {
     const auto entryID = *it;
     const auto &cell = builder->getCell(entryID);
@@ -360,6 +328,10 @@ SubnetTechMapperBase::Status SubnetTechMapperBase::techMap(
     const auto cuts = cutProvider(builder, entryID);
     assert(!cuts.empty());
 
+    order.push_back(entryID);
+    // Cuts are not assignable.
+    optimizer::CutsList(cuts).swap(entryCuts[entryID]);
+
     // Handle the input and constant cells.
     if (cell.isIn() ||
         (!enableConstMapping && (cell.isZero() || cell.isOne()))) {
@@ -371,6 +343,7 @@ SubnetTechMapperBase::Status SubnetTechMapperBase::techMap(
     // Handle the output cells.
     if (cell.isOut()) {
       outputs.insert(entryID);
+      outputIDs.push_back(entryID);
 
 #if !UTOPIA_TECHMAP_MATCH_OUTPUTS
       const auto link = builder->getLink(entryID, 0);
@@ -404,6 +377,327 @@ SubnetTechMapperBase::Status SubnetTechMapperBase::techMap(
   return Status{Status::FOUND, isFeasible, subnetAggregation, subnetTension};
 }
 
+/// Maximum arrival/required time.
+static constexpr criterion::Cost maxTime =
+    std::numeric_limits<criterion::Cost>::max();
+
+/// Checks whether the arrival time exceeds the required one (w/ tolerance).
+static bool isLate(const criterion::Cost arrival,
+                   const criterion::Cost required) {
+  constexpr criterion::Cost eps = 1e-5;
+  return arrival - required > eps * std::max<criterion::Cost>(1., required);
+}
+
+/// Checks whether the cell match is fixed (not selected by the mapper).
+static bool isFixed(const model::Subnet::Cell &cell) {
+  if (cell.isIn()) {
+    return true;
+  }
+  if (!SubnetTechMapperBase::enableConstMapping
+      && (cell.isZero() || cell.isOne())) {
+    return true;
+  }
+#if !UTOPIA_TECHMAP_MATCH_OUTPUTS
+  if (cell.isOut()) {
+    return true;
+  }
+#endif // !UTOPIA_TECHMAP_MATCH_OUTPUTS
+  return false;
+}
+
+/// Checks whether the cut is used for matching the cell.
+static bool isMatchable(const model::Subnet::Cell &cell,
+                        const optimizer::Cut &cut) {
+  // Trivial cuts are treated as constants.
+  return !cut.isTrivial() || cell.isZero() || cell.isOne();
+}
+
+criterion::CostVector SubnetTechMapperBase::estimateMatch(
+    const model::SubnetBuilder &builder,
+    const model::EntryID entryID,
+    const Match &match) const {
+  const auto cellContext = getCellContext(builder, entryID, match);
+  return cellEstimator(match.typeID, cellContext, context.techMapContext);
+}
+
+bool SubnetTechMapperBase::isSelectable(const Match &match) const {
+  for (const auto &link : match.links) {
+    if (!choices[link.idx].match) {
+      return false;
+    }
+  }
+  return true;
+}
+
+criterion::Cost SubnetTechMapperBase::getArrival(
+    const Match &match, const criterion::CostVector &vector) const {
+  criterion::Cost arrival = 0;
+  for (const auto &link : match.links) {
+    arrival = std::max(arrival, choices[link.idx].arrival);
+  }
+  return arrival + vector[criterion::DELAY];
+}
+
+criterion::Cost SubnetTechMapperBase::getAreaFlow(
+    const Match &match, const criterion::CostVector &vector) const {
+  criterion::Cost flow = vector[recovered];
+  for (const auto &link : match.links) {
+    const auto &leaf = choices[link.idx];
+    flow += leaf.flow / leaf.estRefs;
+  }
+  return flow;
+}
+
+void SubnetTechMapperBase::setChoice(const model::EntryID entryID,
+                                     const Match &match,
+                                     const criterion::CostVector &vector) {
+  auto &choice = choices[entryID];
+  choice.match = &match;
+  choice.vector = vector;
+  choice.arrival = getArrival(match, vector);
+  choice.flow = getAreaFlow(match, vector);
+}
+
+criterion::Cost SubnetTechMapperBase::refCone(const model::EntryID entryID) {
+  auto &choice = choices[entryID];
+  assert(choice.match);
+
+  criterion::Cost area = choice.vector[recovered];
+  for (const auto &link : choice.match->links) {
+    if (choices[link.idx].refs++ == 0) {
+      area += refCone(link.idx);
+    }
+  }
+
+  // The leaves might have been changed since the last update.
+  choice.arrival = getArrival(*choice.match, choice.vector);
+  return area;
+}
+
+criterion::Cost SubnetTechMapperBase::derefCone(const model::EntryID entryID) {
+  const auto &choice = choices[entryID];
+  assert(choice.match);
+
+  criterion::Cost area = choice.vector[recovered];
+  for (const auto &link : choice.match->links) {
+    assert(choices[link.idx].refs);
+    if (--choices[link.idx].refs == 0) {
+      area += derefCone(link.idx);
+    }
+  }
+  return area;
+}
+
+void SubnetTechMapperBase::initChoices(const SubnetBuilderPtr &builder) {
+  choices.clear();
+  choices.resize(builder->getMaxIdx() + 1);
+
+  for (const auto entryID : order) {
+    if (!space[entryID]->hasSolution()) {
+      continue;
+    }
+
+    const auto &cell = builder->getCell(entryID);
+    const auto &match = space[entryID]->getBest().solution;
+
+    // Same estimation as in the forward pass.
+    choices[entryID].estRefs = std::max<criterion::Cost>(1., cell.refcount);
+
+    setChoice(entryID, match, isFixed(cell)
+        ? criterion::CostVector::Zero
+        : estimateMatch(*builder, entryID, match));
+  }
+}
+
+void SubnetTechMapperBase::computeCover() {
+  for (const auto entryID : order) {
+    auto &choice = choices[entryID];
+    if (choice.match) {
+      choice.arrival = getArrival(*choice.match, choice.vector);
+    }
+    choice.refs = 0;
+    choice.required = maxTime;
+  }
+
+  criterion::Cost maxArrival = 0;
+  for (const auto outputID : outputIDs) {
+    maxArrival = std::max(maxArrival, choices[outputID].arrival);
+  }
+
+  // Delay is relaxed up to the constraint unless it is the objective.
+  auto required = maxArrival;
+  if (context.criterion->objective.indicator != criterion::DELAY) {
+    const auto &maxVector = context.criterion->maxVector;
+    required = std::max(required, maxVector[criterion::DELAY]);
+  }
+
+  for (const auto outputID : outputIDs) {
+    choices[outputID].refs++;
+    choices[outputID].required = required;
+  }
+
+  for (auto i = order.rbegin(); i != order.rend(); ++i) {
+    const auto &choice = choices[*i];
+    if (!choice.refs) {
+      continue;
+    }
+
+    assert(choice.match);
+    const auto leafRequired = choice.required - choice.vector[criterion::DELAY];
+
+    for (const auto &link : choice.match->links) {
+      auto &leaf = choices[link.idx];
+      leaf.refs++;
+      leaf.required = std::min(leaf.required, leafRequired);
+    }
+  }
+}
+
+void SubnetTechMapperBase::recoverAreaFlow(const SubnetBuilderPtr &builder) {
+  // Blend the estimated references w/ the actual ones (as in ABC).
+  for (const auto entryID : order) {
+    auto &choice = choices[entryID];
+    const auto refs = std::max<criterion::Cost>(1., choice.refs);
+    choice.estRefs = (2. * choice.estRefs + refs) / 3.;
+  }
+
+  for (const auto entryID : order) {
+    const auto &cell = builder->getCell(entryID);
+    const auto &choice = choices[entryID];
+    if (!choice.match || isFixed(cell)) {
+      continue;
+    }
+
+    const Match *bestMatch = choice.match;
+    criterion::CostVector bestVector = choice.vector;
+    criterion::Cost bestFlow = maxTime;
+    criterion::Cost bestArrival = maxTime;
+
+    for (const auto &cut : entryCuts[entryID]) {
+      if (!isMatchable(cell, cut)) {
+        continue;
+      }
+
+      for (const auto &match : getMatches(builder, cut)) {
+        if (!isSelectable(match)) {
+          continue;
+        }
+
+        const auto vector = estimateMatch(*builder, entryID, match);
+        const auto arrival = getArrival(match, vector);
+        if (isLate(arrival, choice.required)) {
+          continue;
+        }
+
+        const auto flow = getAreaFlow(match, vector);
+        if (flow < bestFlow || (flow == bestFlow && arrival < bestArrival)) {
+          bestMatch = &match;
+          bestVector = vector;
+          bestFlow = flow;
+          bestArrival = arrival;
+        }
+      } // for matches
+    } // for cuts
+
+    // If nothing is found, the arrival time and the flow are updated.
+    setChoice(entryID, *bestMatch, bestVector);
+  }
+}
+
+void SubnetTechMapperBase::recoverExactArea(const SubnetBuilderPtr &builder) {
+  for (const auto entryID : order) {
+    const auto &cell = builder->getCell(entryID);
+    auto &choice = choices[entryID];
+    if (!choice.refs || isFixed(cell)) {
+      continue;
+    }
+
+    // Free the cone to estimate the area of each alternative.
+    derefCone(entryID);
+
+    const Match *bestMatch = choice.match;
+    criterion::CostVector bestVector = choice.vector;
+    criterion::Cost bestArea = maxTime;
+    criterion::Cost bestArrival = maxTime;
+
+    for (const auto &cut : entryCuts[entryID]) {
+      if (!isMatchable(cell, cut)) {
+        continue;
+      }
+
+      for (const auto &match : getMatches(builder, cut)) {
+        if (!isSelectable(match)) {
+          continue;
+        }
+
+        // Select the match temporarily to compute its exact area.
+        choice.match = &match;
+        choice.vector = estimateMatch(*builder, entryID, match);
+
+        const auto area = refCone(entryID);
+        const auto arrival = choice.arrival;
+        derefCone(entryID);
+
+        if (isLate(arrival, choice.required)) {
+          continue;
+        }
+
+        if (area < bestArea || (area == bestArea && arrival < bestArrival)) {
+          bestMatch = &match;
+          bestVector = choice.vector;
+          bestArea = area;
+          bestArrival = arrival;
+        }
+      } // for matches
+    } // for cuts
+
+    // If nothing is found, the previous match is restored.
+    choice.match = bestMatch;
+    choice.vector = bestVector;
+    refCone(entryID);
+    choice.flow = getAreaFlow(*choice.match, choice.vector);
+  }
+}
+
+SubnetTechMapperBase::Status SubnetTechMapperBase::getCoverStatus() const {
+  criterion::CostVector vector = criterion::CostVector::Zero;
+
+  for (const auto entryID : order) {
+    const auto &choice = choices[entryID];
+    if (choice.refs) {
+      vector[criterion::AREA] += choice.vector[criterion::AREA];
+      vector[criterion::POWER] += choice.vector[criterion::POWER];
+    }
+  }
+  for (const auto outputID : outputIDs) {
+    vector[criterion::DELAY] =
+        std::max(vector[criterion::DELAY], choices[outputID].arrival);
+  }
+
+  const auto isFeasible = context.criterion->check(vector);
+  const auto tension = context.criterion->getTension(vector);
+
+  return Status{Status::FOUND, isFeasible, vector, tension};
+}
+
+SubnetTechMapperBase::Status SubnetTechMapperBase::recoverArea(
+    const SubnetBuilderPtr &builder) {
+  initChoices(builder);
+  computeCover();
+
+  for (uint16_t i = 0; i < areaFlowPasses; ++i) {
+    recoverAreaFlow(builder);
+    computeCover();
+  }
+
+  for (uint16_t i = 0; i < exactAreaPasses; ++i) {
+    recoverExactArea(builder);
+    computeCover();
+  }
+
+  return getCoverStatus();
+}
+
 SubnetTechMapperBase::SubnetBuilderPtr SubnetTechMapperBase::map(
     const SubnetBuilderPtr &builder) const {
   auto *thisPtr = const_cast<SubnetTechMapperBase *>(this);
@@ -415,7 +709,12 @@ SubnetTechMapperBase::SubnetBuilderPtr SubnetTechMapperBase::map(
     const auto finalTry = (tryCount == maxTries - 1);
 
     // Do technology mapping for the given criterion and tension.
-    const auto status = thisPtr->techMap(builder);
+    auto status = thisPtr->techMap(builder);
+
+    if (status.verdict == Status::FOUND) {
+      // Recovery may make the solution feasible w/o another try.
+      status = thisPtr->recoverArea(builder);
+    }
 
     if (status.verdict == Status::FOUND && (status.isFeasible || finalTry)) {
       UTOPIA_LOG_COST_AND_TENSION_VECTORS(
@@ -423,7 +722,15 @@ SubnetTechMapperBase::SubnetBuilderPtr SubnetTechMapperBase::map(
               ? "Solution satisfies the constraints"
               : "Solution does not satisfy the constraints"),
            status.vector, status.tension);
-      result = makeMappedSubnet(space, builder);
+
+      // Maps old entry indices to matches.
+      MatchSelection matches(builder->getMaxIdx() + 1);
+      for (const auto entryID : order) {
+        const auto &choice = choices[entryID];
+        matches[entryID] = choice.refs ? choice.match : nullptr;
+      }
+
+      result = makeMappedSubnet(matches, builder);
       break;
     }
 
@@ -450,6 +757,10 @@ SubnetTechMapperBase::SubnetBuilderPtr SubnetTechMapperBase::map(
 void SubnetTechMapperBase::onBegin(const SubnetBuilderPtr &oldBuilder) {
   tryCount = 0;
 
+  // Matches depend on the subnet, not on the tension: they are kept for all
+  // the recovery tries but must not be reused for another subnet.
+  cutMatches.clear();
+
   // No penalties at the beginning.
   tension = criterion::CostVector::Zero;
 
@@ -457,6 +768,13 @@ void SubnetTechMapperBase::onBegin(const SubnetBuilderPtr &oldBuilder) {
   for (auto i = oldBuilder->begin(); i != oldBuilder->end(); i.nextCell()) {
     space[*i] = std::make_unique<CellSpace>(*context.criterion, tension);
   }
+
+  entryCuts.clear();
+  entryCuts.resize(oldBuilder->getMaxIdx() + 1);
+
+  // Power is recovered instead of area if it is the objective.
+  const auto indicator = context.criterion->objective.indicator;
+  recovered = (indicator == criterion::POWER) ? indicator : criterion::AREA;
 }
 
 bool SubnetTechMapperBase::onRecovery(const SubnetBuilderPtr &oldBuilder,
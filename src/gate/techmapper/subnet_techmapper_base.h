@@ -104,6 +104,13 @@ public:
 
   SubnetBuilderPtr map(const SubnetBuilderPtr &builder) const override;
 
+  /// Sets the numbers of the area recovery passes (zeros disable recovery).
+  void setRecoveryPasses(const uint16_t areaFlowPasses,
+                         const uint16_t exactAreaPasses) {
+    this->areaFlowPasses = areaFlowPasses;
+    this->exactAreaPasses = exactAreaPasses;
+  }
+
   virtual ~SubnetTechMapperBase() {}
 
 protected:
@@ -169,6 +176,63 @@ protected:
 
   Status techMap(const SubnetBuilderPtr &builder);
 
+  /// Match selected for an entry and the related mapping information.
+  struct Choice final {
+    /// Selected match (null stands for no match).
+    const Match *match{nullptr};
+    /// Cost vector of the cell implementing the match.
+    criterion::CostVector vector;
+    /// Arrival time of the cell output.
+    criterion::Cost arrival{0};
+    /// Required time (valid for the cells of the current cover).
+    criterion::Cost required{0};
+    /// Area flow of the cone rooted at the cell.
+    criterion::Cost flow{0};
+    /// Estimated number of references (for the area flow).
+    criterion::Cost estRefs{1};
+    /// Number of references in the current cover.
+    uint32_t refs{0};
+  };
+
+  /**
+   * \brief Recovers area on the non-critical paths (ABC-style).
+   *
+   * Starts from the best solutions found by techMap() and refines them by
+   * the area-flow and exact-local-area passes over the same cuts/matches.
+   * A match is replaced only if the cell arrival time does not exceed the
+   * required time of the current cover. Returns the status of the cover.
+   */
+  Status recoverArea(const SubnetBuilderPtr &builder);
+
+  void initChoices(const SubnetBuilderPtr &builder);
+  void computeCover();
+  void recoverAreaFlow(const SubnetBuilderPtr &builder);
+  void recoverExactArea(const SubnetBuilderPtr &builder);
+
+  /// Sets the choice of the entry and updates its arrival time/area flow.
+  void setChoice(const model::EntryID entryID,
+                 const Match &match,
+                 const criterion::CostVector &vector);
+
+  /// Checks whether the match can be selected (all the leaves are mapped).
+  bool isSelectable(const Match &match) const;
+
+  criterion::CostVector estimateMatch(const model::SubnetBuilder &builder,
+                                      const model::EntryID entryID,
+                                      const Match &match) const;
+
+  criterion::Cost getArrival(const Match &match,
+                             const criterion::CostVector &vector) const;
+  criterion::Cost getAreaFlow(const Match &match,
+                              const criterion::CostVector &vector) const;
+
+  /// References the cone of the cover; returns the area of new cells.
+  criterion::Cost refCone(const model::EntryID entryID);
+  /// Dereferences the cone of the cover; returns the area of freed cells.
+  criterion::Cost derefCone(const model::EntryID entryID);
+
+  Status getCoverStatus() const;
+
   void findCellSolutions(const SubnetBuilderPtr &builder,
                          const model::EntryID entryID,
                          const optimizer::CutsList &cuts);
@@ -215,6 +279,10 @@ protected:
 
   // Maximum number of tries for recovery.
   const uint16_t maxTries{3};
+  // Number of area-flow recovery passes.
+  uint16_t areaFlowPasses{1};
+  // Number of exact-area recovery passes.
+  uint16_t exactAreaPasses{2};
 
   const context::UtopiaContext &context;
 
@@ -232,8 +300,20 @@ protected:
   criterion::CostVector vector;
   criterion::CostVector tension;
 
-  // Cache of matches (to speed up multiple tries).
+  // Cache of matches (to speed up multiple tries): filled both for the cuts
+  // being ranked and for the selected ones; cleared for each new subnet.
   std::unordered_map<optimizer::Cut, std::vector<Match>> cutMatches;
+
+  // Cuts considered for the entries (reused by the area recovery).
+  std::vector<optimizer::CutsList> entryCuts;
+  // Entries in topological order.
+  std::vector<model::EntryID> order;
+  // Outputs of the subnet.
+  std::vector<model::EntryID> outputIDs;
+  // Current selection of matches (area recovery).
+  std::vector<Choice> choices;
+  // Indicator recovered by the area recovery (area or power).
+  criterion::Indicator recovered{criterion::AREA};
 };
 
 criterion::CostVector defaultCutEstimator(
@@ -0,0 +1,897 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "diag/logger.h"
+#include "gate/optimizer/synthesis/isop.h"
+#include "gate/techmapper/subnet_techmapper_lut.h"
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <vector>
+
+namespace eda::gate::techmapper {
+
+using EntryID = model::EntryID;
+using Link = model::Subnet::Link;
+using LinkList = model::Subnet::LinkList;
+using TT6 = model::TT6;
+
+static constexpr uint16_t MaxK = SubnetTechMapperLut::MaxK;
+
+/// Projections of the variables (the functions are over MaxK variables).
+static constexpr TT6 Vars[MaxK] = {
+  0xaaaaaaaaaaaaaaaaull,
+  0xccccccccccccccccull,
+  0xf0f0f0f0f0f0f0f0ull,
+  0xff00ff00ff00ff00ull,
+  0xffff0000ffff0000ull,
+  0xffffffff00000000ull
+};
+
+/// Swaps the variables i < j.
+static TT6 swapVars(const TT6 tt, const uint16_t i, const uint16_t j) {
+  assert(i < j);
+  const uint32_t shift = (1u << j) - (1u << i);
+  const TT6 mask = Vars[i] & ~Vars[j];
+  return (tt & ~(mask | (mask << shift)))
+       | ((tt & mask) << shift)
+       | ((tt >> shift) & mask);
+}
+
+/// Checks whether the function depends on the variable.
+static bool dependsOn(const TT6 tt, const uint16_t var) {
+  return ((tt & Vars[var]) >> (1u << var)) != (tt & ~Vars[var]);
+}
+
+/// Returns the minimal function obtained by permuting the k variables:
+/// order[i] is the original variable that becomes the i-th one.
+static TT6 canonize(const TT6 tt, const uint16_t k,
+                    std::array<uint8_t, MaxK> &order) {
+  std::array<uint8_t, MaxK> current;
+  std::array<uint16_t, MaxK> counters{};
+  for (uint16_t i = 0; i < k; ++i) {
+    current[i] = order[i] = i;
+  }
+
+  auto best = tt & model::getMaskTruthTable<TT6>(k);
+  auto next = best;
+
+  // Heap's algorithm: each permutation differs from the previous by a swap.
+  for (uint16_t i = 1; i < k;) {
+    if (counters[i] < i) {
+      const uint16_t j = (i & 1) ? counters[i] : 0;
+      next = swapVars(next, j, i);
+      std::swap(current[j], current[i]);
+      if (next < best) {
+        best = next;
+        order = current;
+      }
+      counters[i]++;
+      i = 1;
+    } else {
+      counters[i] = 0;
+      i++;
+    }
+  }
+
+  return best;
+}
+
+//===----------------------------------------------------------------------===//
+// LUT Types
+//===----------------------------------------------------------------------===//
+
+namespace {
+
+/// LUT types are shared by all the mappers. The mapper creates the types for
+/// the P-canonical functions only, so the number of types for k <= 4 does not
+/// exceed the number of the P-classes (3984 for k = 4).
+struct LutRegistry final {
+  struct Shard final {
+    std::mutex mutex;
+    /// LUT types indexed by the function.
+    std::unordered_map<TT6, model::CellTypeID> types;
+  };
+
+  /// Shards indexed by the number of inputs (creating a k-LUT type does not
+  /// block the lookups of the other sizes).
+  Shard shards[MaxK + 1];
+
+  std::mutex mutex;
+  /// Functions of the LUT types.
+  std::unordered_map<model::CellTypeID, TT6> functions;
+};
+
+} // namespace
+
+static LutRegistry &getLutRegistry() {
+  static LutRegistry registry;
+  return registry;
+}
+
+static model::CellTypeID makeLutType(const uint16_t k, const TT6 tt) {
+  model::SubnetID subnetID;
+  std::string function;
+
+  if (k == 0) {
+    model::SubnetBuilder builder;
+    builder.addOutput(builder.addCell(tt ? model::ONE : model::ZERO));
+    subnetID = builder.make();
+    function = tt ? "1" : "0";
+  } else {
+    model::TruthTable table(k);
+    kitty::create_from_words(table, &tt, &tt + 1);
+    subnetID = optimizer::synthesis::MMSynthesizer{}.synthesize(table).make();
+    function = kitty::to_hex(table);
+  }
+
+  model::CellType::PortVector ports;
+  size_t index{0};
+  for (uint16_t i = 0; i < k; ++i) {
+    ports.emplace_back("I" + std::to_string(i), 1, true, index++);
+  }
+  ports.emplace_back("O", 1, false, index++);
+
+  model::PhysicalProperties props;
+  props.area = (k != 0) ? 1. : 0.;
+  props.delay = (k != 0) ? 1. : 0.;
+  props.power = 0.;
+
+  const auto attrID = model::makeCellTypeAttr(ports);
+  model::CellTypeAttr::get(attrID).setPhysProps(props);
+
+  return model::makeCellType(
+      model::CellSymbol::UNDEF,
+      "LUT" + std::to_string(k) + "_" + function,
+      subnetID,
+      attrID,
+      model::CellProperties{1, 0, 1, 0, 0, 0, 0, 0, 0},
+      k,
+      1);
+}
+
+model::CellTypeID SubnetTechMapperLut::getLutType(const uint16_t k,
+                                                  const TT6 tt) {
+  assert(k <= MaxK);
+  const auto function = tt & model::getMaskTruthTable<TT6>(k);
+
+  auto &registry = getLutRegistry();
+  auto &shard = registry.shards[k];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+
+  const auto i = shard.types.find(function);
+  if (i != shard.types.end()) {
+    return i->second;
+  }
+
+  const auto typeID = makeLutType(k, function);
+  shard.types.emplace(function, typeID);
+
+  std::lock_guard<std::mutex> functionsLock(registry.mutex);
+  registry.functions.emplace(typeID, function);
+  return typeID;
+}
+
+std::optional<TT6> SubnetTechMapperLut::getLutTruthTable(
+    const model::CellTypeID typeID) {
+  auto &registry = getLutRegistry();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+
+  const auto i = registry.functions.find(typeID);
+  if (i == registry.functions.end()) {
+    return std::nullopt;
+  }
+  return i->second;
+}
+
+//===----------------------------------------------------------------------===//
+// Mapping
+//===----------------------------------------------------------------------===//
+
+class SubnetTechMapperLut::Mapping final {
+public:
+  Mapping(const model::SubnetBuilder &builder, const Settings &settings);
+
+  /// Maps the subnet (returns false if there are unsupported cells).
+  bool run();
+
+  /// Builds the LUT subnet for the selected cover.
+  SubnetBuilderPtr build(Result &result) const;
+
+private:
+  using LeafID = uint32_t;
+
+  struct Cut final {
+    std::array<LeafID, MaxK> leaves;
+    /// Function of the leaves (the variables are ordered as the leaves).
+    TT6 tt;
+    uint64_t sign;
+    float arrival;
+    /// Area flow or exact area (depending on the pass).
+    float area;
+    uint8_t size;
+  };
+
+  struct Node final {
+    Cut best;
+    float arrival{0};
+    float required{0};
+    float flow{0};
+    float estRefs{1};
+    uint32_t refs{0};
+    bool isMapped{false};
+  };
+
+  enum Pass { DELAY, AREA_FLOW, EXACT_AREA };
+
+  static Cut makeCut(const TT6 tt) {
+    Cut cut;
+    cut.tt = tt;
+    cut.sign = 0;
+    cut.arrival = 0;
+    cut.area = 0;
+    cut.size = 0;
+    return cut;
+  }
+
+  static Cut makeTrivialCut(const EntryID entryID) {
+    auto cut = makeCut(Vars[0]);
+    cut.leaves[0] = static_cast<LeafID>(entryID);
+    cut.sign = getSign(cut.leaves[0]);
+    cut.size = 1;
+    return cut;
+  }
+
+  static uint64_t getSign(const LeafID leafID) {
+    return 1ull << (leafID & 63);
+  }
+
+  static bool isWire(const Cut &cut) {
+    return cut.size == 1 && cut.tt == Vars[0];
+  }
+
+  /// Constants and wires are not implemented by LUTs.
+  static float getCost(const Cut &cut) {
+    return (cut.size == 0 || isWire(cut)) ? 0. : 1.;
+  }
+
+  static bool dominates(const Cut &lhs, const Cut &rhs);
+
+  static bool mergeLeaves(const Cut &lhs, const Cut &rhs, Cut &result,
+                          uint16_t k);
+
+  /// Expresses the cut function in terms of the superset of the leaves.
+  static TT6 stretch(const Cut &cut, const Cut &super);
+
+  /// Removes the leaves the function does not depend on.
+  static void minimize(Cut &cut);
+
+  TT6 apply(const model::Subnet::Cell &cell, const TT6 *args) const;
+
+  void runPass(Pass pass);
+  void computeCuts(EntryID entryID, Pass pass);
+  void enumerate(EntryID entryID, uint16_t j, const Cut &partial);
+  void addCandidate(const Cut &cut);
+  void evaluate(Cut &cut) const;
+  void selectBest(EntryID entryID, Pass pass);
+  void computeCover();
+
+  float ref(const Cut &cut);
+  float deref(const Cut &cut);
+
+  const model::SubnetBuilder &builder;
+  const Settings &settings;
+
+  std::vector<EntryID> inputs;
+  std::vector<EntryID> outputs;
+  /// Logic cells in topological order.
+  std::vector<EntryID> order;
+
+  std::vector<Node> nodes;
+  std::vector<std::vector<Cut>> cutSets;
+  /// Number of the logic fanouts (to release the cuts).
+  std::vector<uint32_t> fanouts;
+  std::vector<uint32_t> remaining;
+
+  // Enumeration state.
+  LinkList links;
+  std::array<const Cut*, MaxK> chosen;
+  std::vector<Cut> candidates;
+};
+
+SubnetTechMapperLut::Mapping::Mapping(const model::SubnetBuilder &builder,
+                                      const Settings &settings):
+    builder(builder), settings(settings) {}
+
+bool SubnetTechMapperLut::Mapping::dominates(const Cut &lhs, const Cut &rhs) {
+  if (lhs.size > rhs.size || (lhs.sign & rhs.sign) != lhs.sign) {
+    return false;
+  }
+  // The leaves are sorted.
+  uint16_t j = 0;
+  for (uint16_t i = 0; i < lhs.size; ++i) {
+    while (j < rhs.size && rhs.leaves[j] < lhs.leaves[i]) {
+      j++;
+    }
+    if (j == rhs.size || rhs.leaves[j] != lhs.leaves[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool SubnetTechMapperLut::Mapping::mergeLeaves(const Cut &lhs,
+                                               const Cut &rhs,
+                                               Cut &result,
+                                               const uint16_t k) {
+  if (std::bitset<64>(lhs.sign | rhs.sign).count() > k) {
+    return false;
+  }
+
+  std::array<LeafID, MaxK> leaves;
+  uint16_t i = 0, j = 0, n = 0;
+  while (i < lhs.size || j < rhs.size) {
+    if (n == k) {
+      return false;
+    }
+    if (j == rhs.size || (i < lhs.size && lhs.leaves[i] < rhs.leaves[j])) {
+      leaves[n++] = lhs.leaves[i++];
+    } else if (i == lhs.size || rhs.leaves[j] < lhs.leaves[i]) {
+      leaves[n++] = rhs.leaves[j++];
+    } else {
+      leaves[n++] = lhs.leaves[i++];
+      j++;
+    }
+  }
+
+  result.leaves = leaves;
+  result.size = n;
+  result.sign = lhs.sign | rhs.sign;
+  return true;
+}
+
+TT6 SubnetTechMapperLut::Mapping::stretch(const Cut &cut, const Cut &super) {
+  std::array<uint16_t, MaxK> positions;
+  uint16_t j = 0;
+  for (uint16_t i = 0; i < cut.size; ++i) {
+    while (super.leaves[j] != cut.leaves[i]) {
+      j++;
+    }
+    positions[i] = j;
+  }
+
+  // The positions are increasing: the higher variables are moved first.
+  auto tt = cut.tt;
+  for (int i = cut.size - 1; i >= 0; --i) {
+    if (positions[i] != i) {
+      tt = swapVars(tt, i, positions[i]);
+    }
+  }
+  return tt;
+}
+
+void SubnetTechMapperLut::Mapping::minimize(Cut &cut) {
+  for (int i = cut.size - 1; i >= 0; --i) {
+    if (dependsOn(cut.tt, i)) {
+      continue;
+    }
+    // Move the redundant variable to the end and remove it.
+    for (uint16_t j = i; j + 1 < cut.size; ++j) {
+      cut.tt = swapVars(cut.tt, j, j + 1);
+      cut.leaves[j] = cut.leaves[j + 1];
+    }
+    cut.size--;
+  }
+
+  cut.sign = 0;
+  for (uint16_t i = 0; i < cut.size; ++i) {
+    cut.sign |= getSign(cut.leaves[i]);
+  }
+}
+
+TT6 SubnetTechMapperLut::Mapping::apply(const model::Subnet::Cell &cell,
+                                        const TT6 *args) const {
+  const auto arity = cell.arity;
+  auto tt = args[0];
+
+  if (cell.isAnd()) {
+    for (uint16_t j = 1; j < arity; ++j) tt &= args[j];
+  } else if (cell.isOr()) {
+    for (uint16_t j = 1; j < arity; ++j) tt |= args[j];
+  } else if (cell.isXor()) {
+    for (uint16_t j = 1; j < arity; ++j) tt ^= args[j];
+  } else if (cell.isMaj()) {
+    if (arity == 3) {
+      tt = (args[0] & args[1]) | (args[0] & args[2]) | (args[1] & args[2]);
+    } else {
+      tt = 0;
+      for (uint16_t bit = 0; bit < 64; ++bit) {
+        uint16_t count = 0;
+        for (uint16_t j = 0; j < arity; ++j) {
+          count += (args[j] >> bit) & 1;
+        }
+        if (count > (arity >> 1)) {
+          tt |= 1ull << bit;
+        }
+      }
+    }
+  } else {
+    assert(cell.isBuf());
+  }
+
+  return tt;
+}
+
+void SubnetTechMapperLut::Mapping::evaluate(Cut &cut) const {
+  float arrival = 0;
+  float area = getCost(cut);
+  for (uint16_t i = 0; i < cut.size; ++i) {
+    const auto &leaf = nodes[cut.leaves[i]];
+    arrival = std::max(arrival, leaf.arrival);
+    area += leaf.flow / leaf.estRefs;
+  }
+  cut.arrival = arrival + getCost(cut);
+  cut.area = area;
+}
+
+void SubnetTechMapperLut::Mapping::addCandidate(const Cut &cut) {
+  for (const auto &other : candidates) {
+    if (dominates(other, cut)) {
+      return;
+    }
+  }
+
+  candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+      [&cut](const Cut &other) { return dominates(cut, other); }),
+      candidates.end());
+
+  candidates.push_back(cut);
+}
+
+void SubnetTechMapperLut::Mapping::enumerate(const EntryID entryID,
+                                             const uint16_t j,
+                                             const Cut &partial) {
+  const auto &cell = builder.getCell(entryID);
+
+  if (j == cell.arity) {
+    std::array<TT6, MaxK> args;
+    for (uint16_t i = 0; i < cell.arity; ++i) {
+      args[i] = stretch(*chosen[i], partial);
+      if (links[i].inv) {
+        args[i] = ~args[i];
+      }
+    }
+
+    auto cut = partial;
+    cut.tt = apply(cell, args.data());
+    minimize(cut);
+    addCandidate(cut);
+    return;
+  }
+
+  for (const auto &faninCut : cutSets[links[j].idx]) {
+    Cut merged = partial;
+    if (!mergeLeaves(partial, faninCut, merged, settings.k)) {
+      continue;
+    }
+    chosen[j] = &faninCut;
+    enumerate(entryID, j + 1, merged);
+  }
+}
+
+void SubnetTechMapperLut::Mapping::computeCuts(const EntryID entryID,
+                                               const Pass pass) {
+  const auto &cell = builder.getCell(entryID);
+  auto &node = nodes[entryID];
+
+  if (cell.isZero() || cell.isOne()) {
+    node.best = makeCut(cell.isZero() ? 0ull : ~0ull);
+    node.isMapped = true;
+    cutSets[entryID] = {node.best};
+    return;
+  }
+
+  links = builder.getLinks(entryID);
+  candidates.clear();
+  enumerate(entryID, 0, makeCut(0));
+
+  // The best cut of the previous pass is kept.
+  if (node.isMapped) {
+    addCandidate(node.best);
+  }
+
+  for (auto &cut : candidates) {
+    evaluate(cut);
+  }
+
+  selectBest(entryID, pass);
+
+  // The first cuts are the best ones (the trivial cut is for the fanouts).
+  const auto nCuts = std::min<size_t>(candidates.size(), settings.cutsPerCell);
+  auto &cuts = cutSets[entryID];
+  cuts.assign(candidates.begin(), candidates.begin() + nCuts);
+  cuts.push_back(makeTrivialCut(entryID));
+
+  for (const auto &link : links) {
+    if (--remaining[link.idx] == 0) {
+      std::vector<Cut>().swap(cutSets[link.idx]);
+    }
+  }
+}
+
+void SubnetTechMapperLut::Mapping::selectBest(const EntryID entryID,
+                                              const Pass pass) {
+  auto &node = nodes[entryID];
+  assert(!candidates.empty());
+
+  const auto byDelay = [](const Cut &lhs, const Cut &rhs) {
+    if (lhs.arrival != rhs.arrival) return lhs.arrival < rhs.arrival;
+    if (lhs.area != rhs.area) return lhs.area < rhs.area;
+    return lhs.size < rhs.size;
+  };
+  const auto byArea = [](const Cut &lhs, const Cut &rhs) {
+    if (lhs.area != rhs.area) return lhs.area < rhs.area;
+    if (lhs.arrival != rhs.arrival) return lhs.arrival < rhs.arrival;
+    return lhs.size < rhs.size;
+  };
+
+  size_t best = 0;
+  if (pass == DELAY) {
+    std::sort(candidates.begin(), candidates.end(), byDelay);
+  } else {
+    std::sort(candidates.begin(), candidates.end(), byArea);
+
+    // The best cut of the previous pass meets the required time.
+    const auto isLate = [&node](const Cut &cut) {
+      return cut.arrival > node.required;
+    };
+
+    if (pass == EXACT_AREA && node.refs) {
+      deref(node.best);
+
+      float bestArea = std::numeric_limits<float>::max();
+      for (size_t i = 0; i < candidates.size(); ++i) {
+        const auto &cut = candidates[i];
+        if (isLate(cut)) {
+          continue;
+        }
+        const auto area = ref(cut);
+        deref(cut);
+        if (area < bestArea) {
+          bestArea = area;
+          best = i;
+        }
+      }
+    } else {
+      while (best < candidates.size() && isLate(candidates[best])) {
+        best++;
+      }
+    }
+
+    if (best == candidates.size() || isLate(candidates[best])) {
+      best = std::min_element(candidates.begin(), candidates.end(), byDelay)
+          - candidates.begin();
+    }
+  }
+
+  // The selected cut is kept among the priority cuts.
+  const auto last = std::min<size_t>(candidates.size(), settings.cutsPerCell);
+  if (best >= last) {
+    std::swap(candidates[best], candidates[last - 1]);
+    best = last - 1;
+  }
+
+  node.best = candidates[best];
+  node.arrival = node.best.arrival;
+  node.flow = node.best.area;
+  node.isMapped = true;
+
+  if (pass == EXACT_AREA && node.refs) {
+    ref(node.best);
+  }
+}
+
+float SubnetTechMapperLut::Mapping::ref(const Cut &cut) {
+  float area = getCost(cut);
+  for (uint16_t i = 0; i < cut.size; ++i) {
+    auto &leaf = nodes[cut.leaves[i]];
+    if (leaf.refs++ == 0 && leaf.isMapped) {
+      area += ref(leaf.best);
+    }
+  }
+  return area;
+}
+
+float SubnetTechMapperLut::Mapping::deref(const Cut &cut) {
+  float area = getCost(cut);
+  for (uint16_t i = 0; i < cut.size; ++i) {
+    auto &leaf = nodes[cut.leaves[i]];
+    assert(leaf.refs);
+    if (--leaf.refs == 0 && leaf.isMapped) {
+      area += deref(leaf.best);
+    }
+  }
+  return area;
+}
+
+void SubnetTechMapperLut::Mapping::computeCover() {
+  constexpr auto maxTime = std::numeric_limits<float>::max();
+
+  for (auto &node : nodes) {
+    node.refs = 0;
+    node.required = maxTime;
+  }
+
+  float maxArrival = 0;
+  for (const auto outputID : outputs) {
+    const auto driverID = builder.getLink(outputID, 0).idx;
+    maxArrival = std::max(maxArrival, nodes[driverID].arrival);
+  }
+
+  // The depth is not increased by the area recovery.
+  for (const auto outputID : outputs) {
+    auto &driver = nodes[builder.getLink(outputID, 0).idx];
+    driver.refs++;
+    driver.required = maxArrival;
+  }
+
+  for (auto i = order.rbegin(); i != order.rend(); ++i) {
+    const auto &node = nodes[*i];
+    if (!node.refs) {
+      continue;
+    }
+
+    const auto &cut = node.best;
+    const auto required = node.required - getCost(cut);
+    for (uint16_t j = 0; j < cut.size; ++j) {
+      auto &leaf = nodes[cut.leaves[j]];
+      leaf.refs++;
+      leaf.required = std::min(leaf.required, required);
+    }
+  }
+}
+
+void SubnetTechMapperLut::Mapping::runPass(const Pass pass) {
+  remaining = fanouts;
+  for (const auto inputID : inputs) {
+    cutSets[inputID] = {makeTrivialCut(inputID)};
+  }
+  for (const auto entryID : order) {
+    computeCuts(entryID, pass);
+  }
+  for (auto &cuts : cutSets) {
+    std::vector<Cut>().swap(cuts);
+  }
+  computeCover();
+}
+
+bool SubnetTechMapperLut::Mapping::run() {
+  const auto size = builder.getMaxIdx() + 1;
+
+  nodes.resize(size);
+  cutSets.resize(size);
+  fanouts.resize(size);
+
+  for (auto it = builder.begin(); it != builder.end(); it.nextCell()) {
+    const auto entryID = *it;
+    const auto &cell = builder.getCell(entryID);
+
+    if (cell.isIn()) {
+      inputs.push_back(entryID);
+      continue;
+    }
+    if (cell.isOut()) {
+      outputs.push_back(entryID);
+      continue;
+    }
+
+    const auto isSupported = cell.isZero() || cell.isOne() || cell.isBuf()
+        || cell.isAnd() || cell.isOr() || cell.isXor() || cell.isMaj();
+    if (!isSupported || cell.arity > settings.k) {
+      UTOPIA_ERROR("Unsupported cell for LUT mapping: "
+          << fmt::format("cell#{}:{}", entryID, cell.getType().getName()));
+      return false;
+    }
+
+    order.push_back(entryID);
+    nodes[entryID].estRefs = std::max(1u, static_cast<uint32_t>(cell.refcount));
+    for (uint16_t j = 0; j < cell.arity; ++j) {
+      fanouts[builder.getLink(entryID, j).idx]++;
+    }
+  }
+
+  runPass(DELAY);
+
+  for (uint16_t i = 0; i < settings.areaFlowPasses; ++i) {
+    // Blend the estimated references w/ the actual ones (as in ABC).
+    for (const auto entryID : order) {
+      auto &node = nodes[entryID];
+      const auto refs = std::max<float>(1., node.refs);
+      node.estRefs = (2. * node.estRefs + refs) / 3.;
+    }
+    runPass(AREA_FLOW);
+  }
+
+  for (uint16_t i = 0; i < settings.exactAreaPasses; ++i) {
+    runPass(EXACT_AREA);
+  }
+
+  return true;
+}
+
+SubnetTechMapperLut::SubnetBuilderPtr SubnetTechMapperLut::Mapping::build(
+    Result &result) const {
+  auto newBuilder = std::make_shared<model::SubnetBuilder>();
+
+  // Maps old entry indices to new links.
+  std::vector<Link> newLinks(nodes.size());
+  for (const auto inputID : inputs) {
+    newLinks[inputID] = newBuilder->addInput();
+  }
+
+  // Phases of the uses: 1 - positive, 2 - negative (only outputs).
+  std::vector<uint8_t> uses(nodes.size(), 0);
+  for (const auto entryID : order) {
+    const auto &node = nodes[entryID];
+    if (node.refs) {
+      for (uint16_t j = 0; j < node.best.size; ++j) {
+        uses[node.best.leaves[j]] |= 1;
+      }
+    }
+  }
+  for (const auto outputID : outputs) {
+    const auto link = builder.getLink(outputID, 0);
+    uses[link.idx] |= link.inv ? 2 : 1;
+  }
+
+  // Types of the P-canonical LUTs: function -> (type, order of the inputs).
+  // The local cache keeps the shared registry out of the per-LUT path.
+  struct LutInfo final {
+    model::CellTypeID typeID;
+    std::array<uint8_t, MaxK> order;
+  };
+  std::unordered_map<TT6, LutInfo> lutInfos[MaxK + 1];
+
+  const auto addLut = [&](const uint16_t k, const TT6 tt,
+                          const LinkList &leafLinks) {
+    auto i = lutInfos[k].find(tt);
+    if (i == lutInfos[k].end()) {
+      LutInfo info;
+      const auto function = canonize(tt, k, info.order);
+      info.typeID = getLutType(k, function);
+      i = lutInfos[k].emplace(tt, info).first;
+    }
+
+    const auto &info = i->second;
+    LinkList canonLinks(k);
+    for (uint16_t j = 0; j < k; ++j) {
+      canonLinks[j] = leafLinks[info.order[j]];
+    }
+    return newBuilder->addCell(info.typeID, canonLinks);
+  };
+
+  const auto getLeafLinks = [&](const Cut &cut) {
+    LinkList leafLinks(cut.size);
+    for (uint16_t j = 0; j < cut.size; ++j) {
+      leafLinks[j] = newLinks[cut.leaves[j]];
+    }
+    return leafLinks;
+  };
+
+  // The LUTs used only w/ negation implement the negated functions.
+  std::vector<bool> isNegated(nodes.size(), false);
+
+  size_t nLuts = 0;
+  for (const auto entryID : order) {
+    const auto &node = nodes[entryID];
+    if (!node.refs) {
+      continue;
+    }
+
+    const auto &cut = node.best;
+    if (isWire(cut)) {
+      newLinks[entryID] = newLinks[cut.leaves[0]];
+      continue;
+    }
+
+    isNegated[entryID] = (uses[entryID] == 2);
+    const auto tt = isNegated[entryID] ? ~cut.tt : cut.tt;
+
+    newLinks[entryID] = addLut(cut.size, tt, getLeafLinks(cut));
+    nLuts++;
+  }
+
+  // The depth includes the LUTs added for the outputs.
+  float depth = 0;
+  std::unordered_map<EntryID, Link> negations;
+  for (const auto outputID : outputs) {
+    const auto link = builder.getLink(outputID, 0);
+
+    // Wires are skipped: the output is driven by a LUT or an input.
+    auto sourceID = link.idx;
+    while (!builder.getCell(sourceID).isIn() && isWire(nodes[sourceID].best)) {
+      sourceID = nodes[sourceID].best.leaves[0];
+    }
+
+    auto newLink = newLinks[sourceID];
+    auto arrival = nodes[sourceID].arrival;
+
+    if (link.inv != isNegated[sourceID]) {
+      const auto isInput = builder.getCell(sourceID).isIn();
+      const auto i = negations.find(sourceID);
+      if (i != negations.end()) {
+        newLink = i->second;
+      } else if (isInput) {
+        newLink = addLut(1, ~Vars[0], {newLink});
+        negations.emplace(sourceID, newLink);
+        nLuts++;
+      } else {
+        // The LUT is duplicated w/ the opposite phase instead of adding
+        // an inverter: this takes the same area but no extra level.
+        const auto &cut = nodes[sourceID].best;
+        const auto tt = isNegated[sourceID] ? cut.tt : ~cut.tt;
+        newLink = addLut(cut.size, tt, getLeafLinks(cut));
+        negations.emplace(sourceID, newLink);
+        nLuts++;
+      }
+      if (isInput) {
+        arrival += 1;
+      }
+    }
+
+    newBuilder->addOutput(newLink);
+    depth = std::max(depth, arrival);
+  }
+
+  result.nLuts = nLuts;
+  result.depth = static_cast<size_t>(depth);
+  return newBuilder;
+}
+
+//===----------------------------------------------------------------------===//
+// Mapper
+//===----------------------------------------------------------------------===//
+
+SubnetTechMapperLut::SubnetTechMapperLut(const std::string &name,
+                                         const Settings &settings):
+    optimizer::SubnetTransformer(name), settings(settings) {
+  if (settings.k < 2 || settings.k > MaxK) {
+    throw std::runtime_error("LUT size must be from 2 to "
+        + std::to_string(MaxK));
+  }
+  if (settings.cutsPerCell == 0) {
+    throw std::runtime_error("Number of priority cuts must be positive");
+  }
+}
+
+SubnetTechMapperLut::SubnetBuilderPtr SubnetTechMapperLut::map(
+    const SubnetBuilderPtr &builder, Result &result) const {
+  Mapping mapping(*builder, settings);
+  if (!mapping.run()) {
+    return nullptr;
+  }
+
+  auto newBuilder = mapping.build(result);
+  UTOPIA_LOG_INFO("LUT" << settings.k << " mapping: "
+      << result.nLuts << " LUTs, depth " << result.depth);
+  return newBuilder;
+}
+
+SubnetTechMapperLut::SubnetBuilderPtr SubnetTechMapperLut::map(
+    const SubnetBuilderPtr &builder) const {
+  Result result;
+  return map(builder, result);
+}
+
+} // namespace eda::gate::techmapper
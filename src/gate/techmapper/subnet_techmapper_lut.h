@@ -0,0 +1,94 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "gate/function/truth_table.h"
+#include "gate/model/subnet.h"
+#include "gate/optimizer/transformer.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace eda::gate::techmapper {
+
+/**
+ * @brief Subnet mapper to k-input LUTs (FPGA target).
+ *
+ * Each k-feasible cut matches the LUT implementing the cut function, so the
+ * matching is implicit: the cuts are enumerated w/ their truth tables (the
+ * priority cuts are kept per cell) and the LUT types are created only for
+ * the selected cover. The mapping flow is the same as in
+ * SubnetTechMapperBase: the depth-optimal mapping is followed by the area-flow
+ * and exact-area recovery passes that do not increase the depth. Each pass
+ * recomputes the cuts keeping the best cut of the previous pass.
+ *
+ * The mapper does not use the generic cut/match/cost callbacks: a LUT has the
+ * unit delay and the unit area, and the state is kept in flat arrays to map
+ * large subnets (millions of cells) in seconds. The supported cells are the
+ * ones produced by the premapper (BUF, AND, OR, XOR, MAJ, and constants).
+ *
+ * The resulting subnet consists of the LUT cell types (see getLutType());
+ * their truth tables are available via getLutTruthTable(). The LUT functions
+ * are permutation-canonized (the inputs are reordered), so that the number of
+ * the created types is bounded by the number of the P-classes rather than by
+ * the number of the functions. An output that needs the opposite phase of a
+ * LUT is driven by a copy of the LUT w/ the negated function (not by an
+ * inverter), so the output negations do not increase the depth.
+ */
+class SubnetTechMapperLut final : public optimizer::SubnetTransformer {
+public:
+  using SubnetBuilderPtr = std::shared_ptr<model::SubnetBuilder>;
+
+  /// Maximum number of the LUT inputs.
+  static constexpr uint16_t MaxK = 6;
+
+  struct Settings final {
+    /// Number of the LUT inputs (from 2 to MaxK).
+    uint16_t k{MaxK};
+    /// Number of the priority cuts per cell.
+    uint16_t cutsPerCell{8};
+    /// Number of the area-flow recovery passes.
+    uint16_t areaFlowPasses{1};
+    /// Number of the exact-area recovery passes.
+    uint16_t exactAreaPasses{2};
+  };
+
+  struct Result final {
+    /// Number of the LUTs (including the ones added for the outputs).
+    size_t nLuts{0};
+    /// Number of the LUT levels (including the output inverters of inputs).
+    size_t depth{0};
+  };
+
+  SubnetTechMapperLut(const std::string &name, const Settings &settings);
+
+  SubnetTechMapperLut(const std::string &name):
+      SubnetTechMapperLut(name, Settings{}) {}
+
+  SubnetBuilderPtr map(const SubnetBuilderPtr &builder) const override;
+
+  /// Maps the subnet and returns the statistics of the mapping.
+  SubnetBuilderPtr map(const SubnetBuilderPtr &builder, Result &result) const;
+
+  /// Returns the LUT cell type for the function of k variables.
+  /// The types are created on demand and shared (the method is thread-safe).
+  static model::CellTypeID getLutType(uint16_t k, model::TT6 tt);
+
+  /// Returns the truth table of the LUT cell type (if it is a LUT).
+  static std::optional<model::TT6> getLutTruthTable(model::CellTypeID typeID);
+
+private:
+  class Mapping;
+
+  const Settings settings;
+};
+
+} // namespace eda::gate::techmapper
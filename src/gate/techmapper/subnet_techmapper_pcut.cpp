@@ -99,7 +99,8 @@ void SubnetTechMapperPCut::computePCuts(const SubnetBuilderPtr &builder,
   if (cutExtractor->getCutNum(entryID) <= n) return;
 
   auto cuts = cutExtractor->getCuts(entryID);
-  std::vector<std::vector<Match>> matches(cuts.size());
+  // Matches are taken from the cache (they do not depend on the tension).
+  std::vector<size_t> matchNums(cuts.size());
   std::vector<std::tuple<size_t, criterion::Cost, bool>> sorted(cuts.size());
 
   for (size_t i = 0; i < cuts.size(); ++i) {
@@ -110,10 +111,10 @@ void SubnetTechMapperPCut::computePCuts(const SubnetBuilderPtr &builder,
        : estimateCutCost(builder, cut, true /* penalize */);
 
     // No matches => large cost.
-    matches[i] = matchFinder(builder, cut);
-    cost /= (std::log2(matches[i].size() + 1.) + .1);
+    matchNums[i] = getMatches(builder, cut).size();
+    cost /= (std::log2(matchNums[i] + 1.) + .1);
 
-    sorted[i] = {i, cost, !matches[i].empty()};
+    sorted[i] = {i, cost, matchNums[i] != 0};
     goodOldCuts.erase(cut);
   }
 
@@ -121,8 +122,8 @@ void SubnetTechMapperPCut::computePCuts(const SubnetBuilderPtr &builder,
   for (const auto &oldCut : goodOldCuts) {
     assert(!oldCut.isTrivial());
     cuts.push_back(oldCut);
-    matches.push_back(matchFinder(builder, oldCut));
-    sorted.emplace_back(sorted.size(), 0. /* good */, !matches.back().empty());
+    matchNums.push_back(getMatches(builder, oldCut).size());
+    sorted.emplace_back(sorted.size(), 0. /* good */, matchNums.back() != 0);
   }
 
   std::sort(sorted.begin(), sorted.end(), [](const auto &lhs, const auto &rhs) {
@@ -142,10 +143,7 @@ void SubnetTechMapperPCut::computePCuts(const SubnetBuilderPtr &builder,
 
     // Store priority cuts.
     pcuts.push_back(pcut);
-    // Cache the cut matches.
-    cutMatches.emplace(pcut, matches[index]);
-
-    matchCount += matches[index].size();
+    matchCount += matchNums[index];
   }
 
   if (matchCount <= 1 /* trivial cut */) {
@@ -15,6 +15,12 @@
 #include "gate/translator/graphml.h"
 #include "util/env.h"
 
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <thread>
+
 namespace eda::gate::techmapper {
 
 using Subnet           = model::Subnet;
@@ -24,43 +30,103 @@ using SubnetID         = model::SubnetID;
 using CutExtractor     = optimizer::CutExtractor;
 
 techMapperWrapper::techMapResult techMapperWrapper::techMap() {
-    
-  for (size_t i = 0, size = design_.getSubnetNum(); i < size; ++i) {
-    const auto &subnetBuilder = design_.getSubnetBuilder(i);
-    const auto techmapBuilder = generateTechSubnet(subnetBuilder);
+  //TODO: should be const ref
+  auto &techLibrary = *context_.techMapContext.library;
+
+  // Find cheapest cells and calculate super cells over them.
+  // The library is not modified after that (the cells are shared).
+  techLibrary.prepareLib();
+
+  // Set matcher type (hardcoded to boolMatcher).
+  const auto pBoolMatcher{PBoolMatcher::create(techLibrary.getCombCells())};
+
+  // Subnet builders are created lazily by the design: do it sequentially.
+  const size_t size = design_.getSubnetNum();
+  std::vector<SubnetBuilderPtr> builders(size);
+  for (size_t i = 0; i < size; ++i) {
+    builders[i] = design_.getSubnetBuilder(i);
+  }
+
+  // The sizer is applied if the delay constraint is set.
+  std::unique_ptr<GateSizer> sizer;
+  if (sizing_ && context_.criterion) {
+    const auto maxDelay = context_.criterion->maxVector[criterion::DELAY];
+    if (maxDelay < std::numeric_limits<criterion::Cost>::max()) {
+      GateSizer::Settings settings;
+      settings.maxDelay = maxDelay;
+      sizer = std::make_unique<GateSizer>(techLibrary, settings);
+    }
+  }
+
+  std::vector<SubnetBuilderPtr> results(size);
+  generateTechSubnets(builders, results, *pBoolMatcher, sizer.get());
+
+  // Subnets are stored (and allocated) in the subnet order.
+  for (size_t i = 0; i < size; ++i) {
+    const auto &techmapBuilder = results[i];
     if (!techmapBuilder) {
       return techMapResult{false, i};
     }
+
+    const auto mappedSubnetID = techmapBuilder->make();
+    printStatistics(mappedSubnetID, techLibrary);
+
     design_.setSubnetBuilder(i, techmapBuilder);
   }
   return techMapResult{true};
 }
 
-//TODO: a lot of same objects created inside for each function call,
-//until threads are implemented they should be moved to techMap()
-//function and passed as parameters here
-std::shared_ptr<model::SubnetBuilder>
-techMapperWrapper::generateTechSubnet(
-  const SubnetTechMapperBase::SubnetBuilderPtr &builder) {
+void techMapperWrapper::generateTechSubnets(
+    const std::vector<SubnetBuilderPtr> &builders,
+    std::vector<SubnetBuilderPtr> &results,
+    const PBoolMatcher &matcher,
+    const GateSizer *sizer) const {
+  const size_t size = builders.size();
+  const size_t nThreads = std::min<size_t>(size, nThreads_ != 0
+      ? nThreads_ : std::max(1u, std::thread::hardware_concurrency()));
 
-  //TODO: should be const ref
-  auto &techLibrary = *context_.techMapContext.library;
+  if (nThreads <= 1) {
+    for (size_t i = 0; i < size; ++i) {
+      results[i] = generateTechSubnet(builders[i], matcher, sizer);
+    }
+    return;
+  }
 
-  // Find cheapest cells and calculate super cells over them.
-  techLibrary.prepareLib();
+  // Each thread takes the next unmapped subnet; the i-th result is written
+  // to the i-th slot only. The mappers log the messages and diagnostics,
+  // which are serialized by the logger (see diag/logger.h).
+  std::atomic<size_t> next{0};
+  auto worker = [&]() {
+    for (size_t i = next++; i < size; i = next++) {
+      results[i] = generateTechSubnet(builders[i], matcher, sizer);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(nThreads);
+  for (size_t i = 0; i < nThreads; ++i) {
+    threads.emplace_back(worker);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+SubnetBuilderPtr techMapperWrapper::generateTechSubnet(
+    const SubnetBuilderPtr &builder,
+    const PBoolMatcher &matcher,
+    const GateSizer *sizer) const {
+  const auto &techLibrary = *context_.techMapContext.library;
 
   // Maximum number of cuts per cell
   constexpr uint16_t maxCutNum = 4;
 
-  // Set matcher type (hardcoded to boolMatcher)
-  auto pBoolMatcher {Matcher<PBoolMatcher, std::size_t>::create(
-                      techLibrary.getCombCells())};
-
-  auto matchFinder = [&](const SubnetBuilderPtr &builder,
-                         const optimizer::Cut &cut){
-      return pBoolMatcher->match(builder, cut);};
+  auto matchFinder = [&matcher](const SubnetBuilderPtr &builder,
+                                const optimizer::Cut &cut) {
+    return matcher.match(builder, cut);
+  };
 
-  // Techmapping
+  // Techmapping (the mapper state is local to the thread)
   SubnetTechMapperPCut techmapper(
       "SubnetTechMapper",
       context_,
@@ -69,13 +135,11 @@ techMapperWrapper::generateTechSubnet(
       matchFinder,
       estimator::getPPA);
 
-  auto builderTechmap = techmapper.map(builder);
-
-  if (builderTechmap != nullptr) {
-    const auto mappedSubnetID = builderTechmap->make();
-    printStatistics(mappedSubnetID, techLibrary);
+  auto result = techmapper.map(builder);
+  if (result && sizer) {
+    sizer->size(*result);
   }
-
-  return builderTechmap;
+  return result;
 }
+
 } // namespace eda::gate::techmapper
@@ -11,6 +11,11 @@
 #include "context/utopia_context.h"
 #include "gate/criterion/criterion.h"
 #include "gate/model/subnet.h"
+#include "gate/techmapper/gate_sizer.h"
+#include "gate/techmapper/matcher/pbool_matcher.h"
+
+#include <memory>
+#include <vector>
 
 namespace eda::gate::techmapper {
 
@@ -32,18 +37,43 @@ public:
   techMapperWrapper (const techMapperWrapper &) = delete;
   techMapperWrapper & operator= (const techMapperWrapper &) = delete;
 
+  /// Creates the wrapper; nThreads = 0 means the hardware concurrency.
+  /// If sizing is set, the mapped subnets violating the delay constraint
+  /// are resized and buffered (see GateSizer).
   techMapperWrapper(context::UtopiaContext &context,
-                    model::DesignBuilder &design)
-                    : context_(context), design_(design) {}
+                    model::DesignBuilder &design,
+                    unsigned nThreads = 0,
+                    bool sizing = true)
+                    : context_(context), design_(design), nThreads_(nThreads),
+                      sizing_(sizing) {}
 
+  /**
+   * \brief Maps all the subnets of the design.
+   *
+   * The library is prepared and the matcher is built once; then the subnets
+   * are mapped by the thread pool sharing them (read-only). The results are
+   * stored to the design in the subnet order, so the outcome does not depend
+   * on the number of threads. If the delay constraint is set, each mapped
+   * subnet is post-processed by the gate sizer.
+   */
   techMapResult techMap();
 
 private:
-  std::shared_ptr<model::SubnetBuilder> generateTechSubnet(
-    const SubnetTechMapperBase::SubnetBuilderPtr &builder);
+  using SubnetBuilderPtr = SubnetTechMapperBase::SubnetBuilderPtr;
+
+  SubnetBuilderPtr generateTechSubnet(const SubnetBuilderPtr &builder,
+                                      const PBoolMatcher &matcher,
+                                      const GateSizer *sizer) const;
+
+  void generateTechSubnets(const std::vector<SubnetBuilderPtr> &builders,
+                           std::vector<SubnetBuilderPtr> &results,
+                           const PBoolMatcher &matcher,
+                           const GateSizer *sizer) const;
 
   context::UtopiaContext &context_;
   model::DesignBuilder &design_;
+  const unsigned nThreads_;
+  const bool sizing_;
 };
 
 } // namespace eda::gate::techmapper
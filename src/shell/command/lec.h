@@ -9,26 +9,40 @@
 #pragma once
 
 #include "gate/debugger/base_checker.h"
+#include "gate/debugger/lec_preprocessor.h"
+#include "gate/debugger/output_checker.h"
+#include "gate/debugger/portfolio_checker.h"
 #include "shell/shell.h"
 
 namespace eda::shell {
 
 struct LecCommand final : public UtopiaCommand {
   using BaseChecker = eda::gate::debugger::BaseChecker;
+  using LecPreprocessor = eda::gate::debugger::LecPreprocessor;
+  using OutputChecker = eda::gate::debugger::OutputChecker;
+  using PortfolioChecker = eda::gate::debugger::PortfolioChecker;
   using LecType = eda::gate::debugger::options::LecType;
 
   LecCommand(): UtopiaCommand(
       "lec", "Checks logical equivalence") {
     const std::map<std::string, LecType> lecMethodMap {
-      { "bdd", LecType::BDD   },
-      { "fra", LecType::FRAIG },
-      { "rnd", LecType::RND   },
-      { "sat", LecType::SAT   }
+      { "bdd", LecType::BDD       },
+      { "fra", LecType::FRAIG     },
+      { "rnd", LecType::RND       },
+      { "sat", LecType::SAT       },
+      { "por", LecType::PORTFOLIO }
     };
 
     app.add_option("--method", method, "Method for checking equivalence")
         ->expected(1)
         ->transform(CLI::CheckedTransformer(lecMethodMap, CLI::ignore_case));
+    app.add_flag("--no-strash", noStrash,
+                 "Disable the structural preprocessing of the miters");
+    app.add_flag("--per-output", perOutput,
+                 "Check the outputs one-by-one (stops on the first mismatch)");
+    app.add_option("--threads", nThreads,
+                   "Number of threads for --per-output (0 for auto)")
+        ->expected(1);
     app.allow_extras();
   }
 
@@ -54,8 +68,40 @@ struct LecCommand final : public UtopiaCommand {
     }
 
     const auto &checker = BaseChecker::getChecker(method);
-    const bool verdict = checker.areEquivalent(
-        *getDesign(), point1, point2).equal();
+    if (method == LecType::PORTFOLIO) {
+      PortfolioChecker::get().resetStats();
+    }
+
+    bool verdict;
+    if (perOutput) {
+      const OutputChecker outputChecker({method, nThreads, true});
+      const auto result = outputChecker.areEquivalent(
+          *getDesign(), point1, point2);
+      verdict = result.result.equal();
+
+      size_t nProven = 0;
+      for (const auto &output : result.outputs) {
+        nProven += output.equal() ? 1 : 0;
+      }
+      UTOPIA_SHELL_OUT << "Proven: "
+                       << nProven << " of " << result.outputs.size()
+                       << " outputs" << std::endl;
+    } else if (noStrash) {
+      verdict = checker.areEquivalent(*getDesign(), point1, point2).equal();
+    } else {
+      LecPreprocessor preprocessor;
+      verdict = preprocessor.areEquivalent(
+          checker, *getDesign(), point1, point2).equal();
+
+      const auto &stats = preprocessor.getStats();
+      UTOPIA_SHELL_OUT << "Structurally proven: "
+                       << stats.nProven << " of " << stats.nOut
+                       << " outputs" << std::endl;
+    }
+
+    if (method == LecType::PORTFOLIO) {
+      printPortfolioStats();
+    }
 
     UTOPIA_SHELL_OUT << (verdict ? "Passed: " : "Failed: ")
                      << point1
@@ -70,7 +116,31 @@ struct LecCommand final : public UtopiaCommand {
     return TCL_OK;
   }
 
+  void printPortfolioStats() const {
+    static const std::map<LecType, std::string> lecNames {
+      { LecType::BDD,   "BDD"   },
+      { LecType::FRAIG, "FRAIG" },
+      { LecType::RND,   "RND"   },
+      { LecType::SAT,   "SAT"   }
+    };
+
+    for (const auto &stats : PortfolioChecker::get().getStats()) {
+      if (stats.nRuns == 0) {
+        continue;
+      }
+      UTOPIA_SHELL_OUT << fmt::format("{:<6}runs: {}, wins: {}, time: {:.3f}s",
+                                      lecNames.at(stats.lec),
+                                      stats.nRuns,
+                                      stats.nWins,
+                                      stats.time)
+                       << std::endl;
+    }
+  }
+
   LecType method = LecType::SAT;
+  bool noStrash = false;
+  bool perOutput = false;
+  size_t nThreads = 0;
 };
 
 } // namespace eda::shell
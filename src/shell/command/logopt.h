@@ -62,6 +62,8 @@ struct LogOptCommand final : public UtopiaCommand {
     passRw->add_flag("-z", rwZ);
 
     ADD_CMD(app, pass::rwz, "rwz", "Rewriting w/ zero-cost replacements");
+    ADD_CMD(app, pass::rwdxag4, "rwdxag4",
+            "Delay-aware rewriting w/ the XAG database");
 
     // Refactoring.
     ADD_CMD(app, pass::rf,  "rf",  "Refactoring");
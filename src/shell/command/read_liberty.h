@@ -10,6 +10,7 @@
 
 #include "gate/library/library.h"
 #include "gate/library/library_factory.h"
+#include "gate/library/library_snapshot.h"
 #include "gate/library/readcells_srcfile_parser.h"
 #include "shell/shell.h"
 
@@ -18,6 +19,18 @@ namespace eda::shell {
 struct ReadLibertyCommand final : public UtopiaCommand {
   ReadLibertyCommand(): UtopiaCommand(
       "read_liberty", "Reads a library from a Liberty files") {
+    app.add_option("--snapshot", snapshotFile,
+                   "Prepared library snapshot used as a cache (if specified)")
+        ->expected(1);
+    app.add_option("--supergate-inputs", superGateSettings.maxInputs,
+                   "Max number of the supergate inputs")
+        ->expected(1);
+    app.add_option("--supergate-depth", superGateSettings.maxDepth,
+                   "Max number of the supergate levels (1 = no supergates)")
+        ->expected(1);
+    app.add_option("--supergate-num", superGateSettings.maxNum,
+                   "Max number of the generated supergates")
+        ->expected(1);
     app.allow_extras();
   }
 
@@ -29,12 +42,24 @@ struct ReadLibertyCommand final : public UtopiaCommand {
 
     auto &libraryUptr = context->techMapContext.library;
 
+    const auto fileNames = app.remaining();
+    for (const std::string &fileName : fileNames) {
+      UTOPIA_SHELL_ERROR_IF_FILE_NOT_EXIST(interp, fileName);
+    }
+
     try {
       if (libraryUptr == nullptr) {
-        libraryUptr = SCLibraryFactory::newLibraryUPtr();
+        // The library is loaded and prepared (or restored from the snapshot).
+        libraryUptr = eda::gate::library::loadLibrary(
+            fileNames, snapshotFile, superGateSettings);
+        return TCL_OK;
       }
-      for (const std::string &fileName : app.remaining()) {
-        UTOPIA_SHELL_ERROR_IF_FILE_NOT_EXIST(interp, fileName);
+
+      UTOPIA_SHELL_ERROR_IF(interp, libraryUptr->isPrepared(),
+          "library has been already prepared: read all files at once");
+      libraryUptr->setSuperGateSettings(superGateSettings);
+
+      for (const std::string &fileName : fileNames) {
         eda::gate::library::ReadCellsParser parser(fileName);
         //TODO: search map will be recalculated after each file is added
         if (!SCLibraryFactory::fillLibrary(*libraryUptr, parser)) {
@@ -46,6 +71,9 @@ struct ReadLibertyCommand final : public UtopiaCommand {
     }
     return TCL_OK;
   }
+
+  std::string snapshotFile;
+  eda::gate::library::SuperGateGenerator::Settings superGateSettings;
 };
 
 } // namespace eda::shell
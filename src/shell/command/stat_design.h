@@ -10,6 +10,7 @@
 
 #include "gate/estimator/ppa_estimator.h"
 #include "gate/estimator/probabilistic_estimate.h"
+#include "gate/estimator/timing_analyzer.h"
 #include "shell/shell.h"
 
 namespace eda::shell {
@@ -27,6 +28,11 @@ static inline void printNameValue(const std::string &name,
 struct StatDesignCommand final : public UtopiaCommand {
   StatDesignCommand(): UtopiaCommand(
       "stat_design", "Prints the design characteristics") {
+    app.add_flag("--critical-path", printPath,
+                 "Print the critical path (tech-mapped designs)");
+    app.add_option("--required-time", requiredTime,
+                   "Required time in ns for the slack computation")
+        ->expected(1);
     app.allow_extras();
   }
 
@@ -40,6 +46,10 @@ struct StatDesignCommand final : public UtopiaCommand {
 
     size_t nIn{0}, nOut{0}, nInt{0}, depth{0};
     float area{0}, delay{0}, power{0}, activ{0};
+    float slack{std::numeric_limits<float>::max()};
+
+    std::unique_ptr<estimator::TimingAnalyzer> criticalAnalyzer;
+    std::shared_ptr<gate::model::SubnetBuilder> criticalBuilder;
 
     std::tie(nIn, nOut, nInt) = getDesign()->getCellNum(false);
     const size_t nCell = nIn + nOut + nInt;
@@ -62,8 +72,19 @@ struct StatDesignCommand final : public UtopiaCommand {
         UTOPIA_SHELL_ERROR_IF(interp, !library, "cannot access library");
         area += estimator::getArea(subnetID);
         power += estimator::getLeakagePower(subnetID, *library);
-        delay = std::max<float>(estimator::getArrivalTime(subnetID, *library),
-                                delay);
+
+        estimator::TimingAnalyzer::Settings settings;
+        settings.requiredTime = requiredTime;
+
+        auto analyzer = std::make_unique<estimator::TimingAnalyzer>(
+            *builder, *library, settings);
+        slack = std::min<float>(analyzer->getWorstSlack(), slack);
+
+        if (!criticalAnalyzer || analyzer->getDelay() > delay) {
+          delay = analyzer->getDelay();
+          criticalAnalyzer = std::move(analyzer);
+          criticalBuilder = builder;
+        }
       }
     } // for subnet
 
@@ -80,11 +101,21 @@ struct StatDesignCommand final : public UtopiaCommand {
       printNameValue("Area", area, " um^2");
       printNameValue("Delay", delay, " ns");
       printNameValue("Power", power, " uW");
+      if (requiredTime >= 0) {
+        printNameValue("Slack", slack, " ns");
+      }
+      if (printPath && criticalAnalyzer) {
+        UTOPIA_SHELL_OUT << "Critical path:" << std::endl;
+        criticalAnalyzer->printCriticalPath(UTOPIA_SHELL_OUT);
+      }
     }
 
     UTOPIA_SHELL_OUT << std::flush;
     return TCL_OK;
   }
+
+  bool printPath = false;
+  double requiredTime = -1.;
 };
 
 } // namespace eda::shell
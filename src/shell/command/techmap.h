@@ -40,6 +40,11 @@ struct TechMapCommand final : public UtopiaCommand {
     app.add_option("--power-constraint", powerConstraint,
                    "Max power in uW (overrides SDC)")
         ->expected(1);
+    app.add_option("--threads", nThreads,
+                   "Number of mapping threads (0 = number of cores)")
+        ->expected(1);
+    app.add_flag("--no-sizing", noSizing,
+                 "Disable gate sizing and buffering w/ the delay constraint");
     app.allow_extras();
   }
 
@@ -82,7 +87,7 @@ struct TechMapCommand final : public UtopiaCommand {
           Objective(indicator), constraints);
     }
 
-    techMapperWrapper tmw(*context, design);
+    techMapperWrapper tmw(*context, design, nThreads, !noSizing);
     auto result = tmw.techMap();
     
     UTOPIA_SHELL_ERROR_IF(interp, !result.success,
@@ -98,6 +103,8 @@ struct TechMapCommand final : public UtopiaCommand {
   gate::criterion::Cost areaConstraint = NAN;
   gate::criterion::Cost delayConstraint = NAN;
   gate::criterion::Cost powerConstraint = NAN;
+  unsigned nThreads = 0;
+  bool noSizing = false;
 };
 
 } // namespace eda::shell
@@ -18,9 +18,9 @@ TT toTT(uint64_t x) {
   return tt;
 }
 
-gate::model::SubnetID npnTransform(const gate::model::Subnet &subnet,
-                                   const NpnTransformation &t,
-                                   uint8_t nInUsed) {
+gate::model::SubnetObject npnTransformObject(const gate::model::Subnet &subnet,
+                                             const NpnTransformation &t,
+                                             uint8_t nInUsed) {
 
   using Cell = gate::model::Subnet::Cell;
   using Subnet = gate::model::Subnet;
@@ -84,7 +84,13 @@ gate::model::SubnetID npnTransform(const gate::model::Subnet &subnet,
     builder.addCell(cell.getTypeID(), links);
   }
 
-  return object.make();
+  return object;
+}
+
+gate::model::SubnetID npnTransform(const gate::model::Subnet &subnet,
+                                   const NpnTransformation &t,
+                                   uint8_t nInUsed) {
+  return npnTransformObject(subnet, t, nInUsed).make();
 }
 
 SOP findAnyLevel0Kernel(const SOP &sop) {
@@ -46,7 +46,12 @@ template<typename TT> TT getTT(const std::tuple<TT, uint32_t,
   return std::get<0>(t);
 }
 
-// FIXME: Return SubnetObject.
+/// Returns the transformed subnet as a builder (not allocated in the storage).
+/// See also gate::model::SubnetNpnView that does not build the subnet at all.
+gate::model::SubnetObject npnTransformObject(const gate::model::Subnet &subnet,
+                                             const NpnTransformation &t,
+                                             uint8_t nInUsed = -1);
+
 gate::model::SubnetID npnTransform(const gate::model::Subnet &subnet,
                                    const NpnTransformation &t,
                                    uint8_t nInUsed = -1);
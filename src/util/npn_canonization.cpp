@@ -0,0 +1,174 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "util/npn_canonization.h"
+
+#include <algorithm>
+#include <cassert>
+#include <memory>
+#include <numeric>
+
+namespace eda::util {
+
+using TT = kitty::dynamic_truth_table;
+
+static TT makeTT(uint8_t nVars, uint64_t word) {
+  TT tt(nVars);
+  *tt.begin() = word;
+  return tt;
+}
+
+static uint64_t getWord(const TT &tt) {
+  return *tt.cbegin();
+}
+
+CanonizationTable::CanonizationTable(uint8_t nVars, bool withNegations):
+    nVars(nVars) {
+  assert(nVars <= MaxVars);
+
+  std::vector<uint8_t> perm(nVars);
+  std::iota(perm.begin(), perm.end(), 0);
+  do {
+    perms.push_back(perm);
+  } while (std::next_permutation(perm.begin(), perm.end()));
+
+  const uint64_t nFuncs = 1ull << (1u << nVars);
+  const uint32_t nPhases = withNegations ? (1u << (nVars + 1)) : 1u;
+
+  items.resize(nFuncs);
+  std::vector<bool> isFilled(nFuncs, false);
+
+  for (uint64_t func = 0; func < nFuncs; ++func) {
+    if (isFilled[func]) {
+      continue;
+    }
+
+    const auto tt = makeTT(nVars, func);
+    const auto config = withNegations
+        ? kitty::exact_npn_canonization(tt)
+        : kitty::exact_p_canonization(tt);
+    const auto &canon = std::get<0>(config);
+
+    const auto classIdx = static_cast<uint16_t>(classes.size());
+    classes.push_back(getWord(canon));
+
+    // Enumerate the class members w/ the transformations restoring them.
+    for (uint32_t phase = 0; phase < nPhases; ++phase) {
+      for (size_t i = 0; i < perms.size(); ++i) {
+        const auto member = getWord(kitty::create_from_npn_config(
+            NpnConfig{canon, phase, perms[i]}));
+        if (!isFilled[member]) {
+          items[member] = Item{classIdx, static_cast<uint8_t>(phase),
+                               static_cast<uint8_t>(i)};
+          isFilled[member] = true;
+        }
+      }
+    }
+
+    assert(isFilled[func]);
+  }
+}
+
+NpnConfig CanonizationTable::getConfig(uint64_t tt) const {
+  const auto &item = items[tt];
+  return NpnConfig{makeTT(nVars, classes[item.classIdx]),
+                   item.phase,
+                   perms[item.permIdx]};
+}
+
+template <bool WithNegations>
+static const CanonizationTable &getTable(uint8_t nVars) {
+  static std::unique_ptr<CanonizationTable>
+      tables[CanonizationTable::MaxVars + 1];
+  static std::once_flag flags[CanonizationTable::MaxVars + 1];
+
+  assert(nVars <= CanonizationTable::MaxVars);
+  std::call_once(flags[nVars], [nVars]() {
+    tables[nVars] = std::make_unique<CanonizationTable>(nVars, WithNegations);
+  });
+
+  return *tables[nVars];
+}
+
+const CanonizationTable &CanonizationTable::getNpn(uint8_t nVars) {
+  return getTable<true>(nVars);
+}
+
+const CanonizationTable &CanonizationTable::getP(uint8_t nVars) {
+  return getTable<false>(nVars);
+}
+
+CanonizationCache &CanonizationCache::getNpn() {
+  static CanonizationCache cache(true);
+  return cache;
+}
+
+CanonizationCache &CanonizationCache::getP() {
+  static CanonizationCache cache(false);
+  return cache;
+}
+
+NpnConfig CanonizationCache::get(const TT &tt) {
+  constexpr uint8_t nVars = 5;
+  assert(tt.num_vars() == nVars);
+
+  const auto func = static_cast<uint32_t>(getWord(tt));
+  // Fibonacci hashing: the upper bits of the product select the slot.
+  const size_t index = (func * 0x9e3779b9u) >> (32 - SizeBits);
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto &slot = slots[index];
+    if ((slot.perm & Slot::Valid) && slot.func == func) {
+      std::vector<uint8_t> perm(nVars);
+      for (uint8_t j = 0; j < nVars; ++j) {
+        perm[j] = (slot.perm >> (3 * j)) & 0x7;
+      }
+      return NpnConfig{makeTT(nVars, slot.canon), slot.phase, perm};
+    }
+  }
+
+  auto config = withNegations
+      ? kitty::exact_npn_canonization(tt)
+      : kitty::exact_p_canonization(tt);
+
+  const auto &perm = std::get<2>(config);
+  Slot slot{func, static_cast<uint32_t>(getWord(std::get<0>(config))),
+            std::get<1>(config), Slot::Valid};
+  for (uint8_t j = 0; j < nVars; ++j) {
+    slot.perm |= static_cast<uint32_t>(perm[j]) << (3 * j);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  slots[index] = slot;
+  return config;
+}
+
+NpnConfig npnCanonization(const TT &tt) {
+  const auto nVars = tt.num_vars();
+  if (nVars <= CanonizationTable::MaxVars) {
+    return CanonizationTable::getNpn(nVars).getConfig(getWord(tt));
+  }
+  if (nVars == 5) {
+    return CanonizationCache::getNpn().get(tt);
+  }
+  return kitty::exact_npn_canonization(tt);
+}
+
+NpnConfig pCanonization(const TT &tt) {
+  const auto nVars = tt.num_vars();
+  if (nVars <= CanonizationTable::MaxVars) {
+    return CanonizationTable::getP(nVars).getConfig(getWord(tt));
+  }
+  if (nVars == 5) {
+    return CanonizationCache::getP().get(tt);
+  }
+  return kitty::exact_p_canonization(tt);
+}
+
+} // namespace eda::util
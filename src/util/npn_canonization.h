@@ -0,0 +1,122 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <kitty/kitty.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace eda::util {
+
+/// Canonization result in the kitty format: (canonical TT, phase, permutation).
+/// The original function is restored by kitty::create_from_npn_config.
+using NpnConfig =
+    std::tuple<kitty::dynamic_truth_table, uint32_t, std::vector<uint8_t>>;
+
+/**
+ * \brief Precomputed canonization of all the functions of n <= 4 variables.
+ *
+ * The table is built once: kitty canonization is called for one function of
+ * each class, and the other functions of the class are enumerated by applying
+ * all the transformations to the canonical form. So the results coincide with
+ * kitty::exact_npn_canonization (or kitty::exact_p_canonization).
+ */
+class CanonizationTable final {
+public:
+  static constexpr uint8_t MaxVars = 4;
+
+  /// Class index and transformation (index in the permutation list).
+  struct Item final {
+    uint16_t classIdx;
+    uint8_t phase;
+    uint8_t permIdx;
+  };
+
+  /// Returns the NPN canonization table for the given number of variables.
+  static const CanonizationTable &getNpn(uint8_t nVars);
+  /// Returns the P canonization table for the given number of variables.
+  static const CanonizationTable &getP(uint8_t nVars);
+
+  CanonizationTable(uint8_t nVars, bool withNegations);
+
+  /// Returns the number of classes.
+  size_t getClassNum() const { return classes.size(); }
+  /// Returns the canonical form of the i-th class.
+  uint64_t getClass(size_t i) const { return classes[i]; }
+
+  /// Returns the class index and the transformation of the function.
+  const Item &get(uint64_t tt) const { return items[tt]; }
+  /// Returns the i-th permutation.
+  const std::vector<uint8_t> &getPerm(size_t i) const { return perms[i]; }
+
+  /// Returns the canonization result in the kitty format.
+  NpnConfig getConfig(uint64_t tt) const;
+
+private:
+  const uint8_t nVars;
+
+  std::vector<uint64_t> classes;
+  std::vector<Item> items;
+  std::vector<std::vector<uint8_t>> perms;
+};
+
+/**
+ * \brief Caches canonization results for functions of 5 variables.
+ *
+ * The cache is a fixed-size direct-mapped table: a function is stored in
+ * the slot selected by its hash, evicting the previous one (if any). So the
+ * memory is bounded regardless of the number of distinct functions.
+ */
+class CanonizationCache final {
+public:
+  /// Number of slots (16 bytes each): 2^SizeBits.
+  static constexpr size_t SizeBits = 16;
+  static constexpr size_t Size = size_t{1} << SizeBits;
+
+  static CanonizationCache &getNpn();
+  static CanonizationCache &getP();
+
+  explicit CanonizationCache(bool withNegations):
+      withNegations(withNegations), slots(Size) {}
+
+  /// Returns the canonization result (calls kitty on a cache miss).
+  NpnConfig get(const kitty::dynamic_truth_table &tt);
+
+private:
+  struct Slot final {
+    /// Marks the occupied slots (in the perm field).
+    static constexpr uint32_t Valid = 1u << 31;
+
+    uint32_t func;
+    uint32_t canon;
+    uint32_t phase;
+    /// Permutation: 3 bits per variable (and the valid flag).
+    uint32_t perm;
+  };
+  static_assert(sizeof(Slot) == 16);
+
+  const bool withNegations;
+
+  std::vector<Slot> slots;
+  std::mutex mutex;
+};
+
+/// Fast drop-in replacement of kitty::exact_npn_canonization: uses the
+/// precomputed tables for n <= 4 and the cache for n = 5.
+NpnConfig npnCanonization(const kitty::dynamic_truth_table &tt);
+
+/// Fast drop-in replacement of kitty::exact_p_canonization: uses the
+/// precomputed tables for n <= 4 and the cache for n = 5.
+NpnConfig pCanonization(const kitty::dynamic_truth_table &tt);
+
+} // namespace eda::util
@@ -0,0 +1,195 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/criterion/criterion.h"
+#include "gate/criterion/solution_space.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <valarray>
+#include <vector>
+
+namespace eda::gate::criterion {
+
+static Criterion makeCriterion(const Cost maxArea,
+                               const Cost maxDelay,
+                               const Cost maxPower) {
+  return Criterion(Objective(AREA), Constraints{
+      Constraint(AREA, maxArea),
+      Constraint(DELAY, maxDelay),
+      Constraint(POWER, maxPower)});
+}
+
+TEST(CostVectorTest, Arithmetic) {
+  const CostVector a(1., 2., 3.);
+  const CostVector b(4., 5., 6.);
+
+  EXPECT_EQ(a.size(), CostVector::DefaultSize);
+  EXPECT_FLOAT_EQ((a + b)[DELAY], 7.);
+  EXPECT_FLOAT_EQ((b - a)[POWER], 3.);
+  EXPECT_FLOAT_EQ((a * b)[AREA], 4.);
+  EXPECT_FLOAT_EQ((b / a)[POWER], 2.);
+  EXPECT_FLOAT_EQ((a * 2.)[POWER], 6.);
+  EXPECT_FLOAT_EQ(a.sum(), 6.);
+  EXPECT_FLOAT_EQ(a.dot(b), 32.);
+  EXPECT_FLOAT_EQ(CostVector(3., 4., 0.).norm(2.), 5.);
+
+  CostVector c = CostVector::Zero;
+  aggregateCost(c, a);
+  aggregateCost(c, b);
+  EXPECT_FLOAT_EQ(c[AREA], 5.);
+  EXPECT_FLOAT_EQ(c[DELAY], 5.);
+  EXPECT_FLOAT_EQ(c[POWER], 9.);
+}
+
+TEST(CostVectorTest, Padding) {
+  // The operations must not affect the reductions via the padding lane.
+  const CostVector a(1., 2., 3.);
+  EXPECT_FLOAT_EQ((a + 1.).sum(), 9.);
+  EXPECT_FLOAT_EQ(a.pow(0.).sum(), 3.);
+  EXPECT_FLOAT_EQ(a.softmax(1.).sum(), 1.);
+
+  const auto criterion = makeCriterion(10., 10., 10.);
+  const auto tension = criterion.getTension(a);
+  EXPECT_FLOAT_EQ(tension.sum(), .6);
+  EXPECT_FLOAT_EQ(CostVector::Zero.normalize(CostVector::Zero,
+                                             CostVector::Unit).sum(), 0.);
+
+  // The padding stays zero being multiplied by infinity (0*inf is NaN).
+  const auto inf = std::numeric_limits<Cost>::infinity();
+  const auto product = a * inf;
+  const CostVector expected(inf, inf, inf);
+  EXPECT_EQ(std::memcmp(&product, &expected, sizeof(CostVector)), 0);
+}
+
+TEST(CostVectorTest, Selection) {
+  // Emulates the DP mapper: aggregation, propagation, and selection.
+  constexpr size_t nCells = 100000;
+  constexpr size_t nCuts = 8;
+  constexpr size_t nLeaves = 4;
+
+  constexpr auto maxCost = std::numeric_limits<Cost>::max();
+  const auto criterion = makeCriterion(maxCost, maxCost, maxCost);
+  const CostVector tension(.1, .2, .3);
+
+  std::vector<CostVector> costs(nCells, CostVector(1., 1., 1.));
+  std::vector<SolutionSpace<size_t>> spaces(
+      nCells, SolutionSpace<size_t>(criterion, tension));
+
+  for (size_t i = nLeaves; i < nCells; ++i) {
+    for (size_t j = 0; j < nCuts; ++j) {
+      CostVector vector = CostVector::Zero;
+      for (size_t k = 1; k <= nLeaves; ++k) {
+        aggregateCost(vector, costs[i - k]);
+      }
+      vector += CostVector(j + 1., .5 * j, .1);
+      spaces[i].add(j, vector / static_cast<Cost>(nLeaves));
+    }
+    costs[i] = spaces[i].getBest().vector;
+  }
+
+  for (size_t i = nLeaves; i < nCells; ++i) {
+    EXPECT_TRUE(spaces[i].hasSolution());
+    EXPECT_EQ(spaces[i].getBest().solution, 0u);
+  }
+}
+
+/// Emulates the selection loop of the DP mapper: aggregation of the leaf
+/// costs, propagation, and the penalized cost of each cut.
+template <typename Vector>
+static Cost runSelection(const size_t nCells,
+                         const Vector &unit,
+                         const Vector &tension,
+                         const std::vector<Vector> &cuts) {
+  constexpr size_t nLeaves = 4;
+
+  std::vector<Vector> costs(nCells, unit);
+  Cost checksum = 0.;
+
+  for (size_t i = nLeaves; i < nCells; ++i) {
+    size_t best = 0;
+    Cost bestCost = std::numeric_limits<Cost>::max();
+
+    for (size_t j = 0; j < cuts.size(); ++j) {
+      Vector vector = unit * 0.;
+      for (size_t k = 1; k <= nLeaves; ++k) {
+        vector += costs[i - k];
+      }
+      vector += cuts[j];
+      vector *= Cost(1.) / nLeaves;
+
+      Cost cost = 0.;
+      for (size_t k = 0; k < CostVector::DefaultSize; ++k) {
+        cost += vector[k] * (1. + tension[k]);
+      }
+      if (cost < bestCost) {
+        best = j;
+        bestCost = cost;
+      }
+    }
+
+    Vector vector = unit * 0.;
+    for (size_t k = 1; k <= nLeaves; ++k) {
+      vector += costs[i - k];
+    }
+    vector += cuts[best];
+    vector *= Cost(1.) / nLeaves;
+
+    costs[i] = vector;
+    checksum += bestCost;
+  }
+
+  return checksum;
+}
+
+// Compares the fixed-size vector w/ the former std::valarray-based one.
+// Run w/ --gtest_also_run_disabled_tests (in the release build).
+TEST(CostVectorTest, DISABLED_Benchmark) {
+  using Clock = std::chrono::steady_clock;
+  using Array = std::valarray<Cost>;
+
+  constexpr size_t nCells = 1000000;
+  constexpr size_t nCuts = 8;
+
+  std::vector<CostVector> vectorCuts;
+  std::vector<Array> arrayCuts;
+  for (size_t j = 0; j < nCuts; ++j) {
+    const CostVector cut(j + 1., .5 * j, .1);
+    vectorCuts.push_back(cut);
+    arrayCuts.push_back(Array{cut[AREA], cut[DELAY], cut[POWER]});
+  }
+
+  const auto vectorStart = Clock::now();
+  const auto vectorSum = runSelection<CostVector>(
+      nCells, CostVector::Unit, CostVector(.1, .2, .3), vectorCuts);
+  const auto vectorTime = Clock::now() - vectorStart;
+
+  const auto arrayStart = Clock::now();
+  const auto arraySum = runSelection<Array>(
+      nCells, Array{1., 1., 1.}, Array{.1, .2, .3}, arrayCuts);
+  const auto arrayTime = Clock::now() - arrayStart;
+
+  EXPECT_FLOAT_EQ(vectorSum, arraySum);
+
+  const auto nSolutions = static_cast<double>(nCells * nCuts);
+  const auto getRate = [nSolutions](const Clock::duration time) {
+    return nSolutions / std::chrono::duration<double>(time).count() / 1e6;
+  };
+
+  std::cout << "CostVector:          " << getRate(vectorTime)
+            << "M solutions/s" << std::endl;
+  std::cout << "std::valarray<Cost>: " << getRate(arrayTime)
+            << "M solutions/s" << std::endl;
+}
+
+} // namespace eda::gate::criterion
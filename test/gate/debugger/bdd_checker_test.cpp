@@ -0,0 +1,128 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/debugger/bdd_checker.h"
+#include "gate/model/utils/subnet_random.h"
+#include "gate/simulator/simulator.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+using namespace eda::gate::model;
+
+namespace eda::gate::debugger {
+
+static CheckerResult checkBdd(const SubnetID subnetID1,
+                              const SubnetID subnetID2,
+                              const BddChecker::Ordering ordering,
+                              const bool reordering,
+                              const unsigned nodeLimit) {
+  auto &checker = BddChecker::get();
+  checker.setOrdering(ordering);
+  checker.setReordering(reordering);
+  checker.setNodeLimit(nodeLimit);
+
+  SubnetBuilder miterBuilder;
+  BaseChecker::makeMiter(miterBuilder, subnetID1, subnetID2);
+  const auto miterID = miterBuilder.make();
+  const auto result = checker.isSat(Subnet::get(miterID));
+
+  if (result.notEqual()) {
+    simulator::Simulator simulator(std::make_shared<SubnetBuilder>(miterID));
+    simulator.simulate(result.getCounterExample());
+    EXPECT_TRUE(simulator.getOutput(0));
+  }
+
+  checker.setOrdering(BddChecker::DFS);
+  checker.setReordering(false);
+  checker.setNodeLimit(0);
+  return result;
+}
+
+/// Makes the miter comparing the negative cells w/ the negated positive ones
+/// (SubnetBuilder does not allow negative cells, so the entries are raw).
+static SubnetID makeNegativeMiter(const bool equal) {
+  using Entry = Subnet::Entry;
+  using Link = Subnet::Link;
+
+  // The positive cell output is inverted if the miter is to be equal.
+  const Link a(0), b(1);
+  const auto cmp = [equal](EntryID neg, EntryID pos) {
+    return Entry(getCellTypeID(XOR), {Link(neg), Link(pos, equal)});
+  };
+
+  const std::vector<Entry> entries{
+    /*  0 */ Entry(getCellTypeID(IN), {}),
+    /*  1 */ Entry(getCellTypeID(IN), {}),
+    /*  2 */ Entry(getCellTypeID(NAND), {a, b}),
+    /*  3 */ Entry(getCellTypeID(AND), {a, b}),
+    /*  4 */ cmp(2, 3),
+    /*  5 */ Entry(getCellTypeID(NOR), {a, b}),
+    /*  6 */ Entry(getCellTypeID(OR), {a, b}),
+    /*  7 */ cmp(5, 6),
+    /*  8 */ Entry(getCellTypeID(XNOR), {a, b}),
+    /*  9 */ Entry(getCellTypeID(XOR), {a, b}),
+    /* 10 */ cmp(8, 9),
+    /* 11 */ Entry(getCellTypeID(NOT), {a}),
+    /* 12 */ cmp(11, 0),
+    /* 13 */ Entry(getCellTypeID(OR), {Link(4), Link(7)}),
+    /* 14 */ Entry(getCellTypeID(OR), {Link(10), Link(12)}),
+    /* 15 */ Entry(getCellTypeID(OR), {Link(13), Link(14)}),
+    /* 16 */ Entry(getCellTypeID(OUT), {Link(15)})
+  };
+
+  return allocateObject<Subnet>(2, 1, entries.size(), 0, entries);
+}
+
+TEST(BddCheckerTest, Equal) {
+  for (size_t seed = 0; seed < 5; ++seed) {
+    const auto subnetID = randomSubnet(16, 4, 200, 2, 3, seed);
+    for (const auto ordering : {BddChecker::INPUT, BddChecker::DFS}) {
+      for (const bool reordering : {false, true}) {
+        const auto result = checkBdd(subnetID, subnetID, ordering,
+                                     reordering, 0);
+        EXPECT_TRUE(result.equal());
+      }
+    }
+  }
+}
+
+TEST(BddCheckerTest, NotEqual) {
+  for (size_t seed = 0; seed < 5; ++seed) {
+    const auto subnetID1 = randomSubnet(16, 4, 200, 2, 3, seed);
+    const auto subnetID2 = randomSubnet(16, 4, 200, 2, 3, seed + 10);
+    const auto result = checkBdd(subnetID1, subnetID2, BddChecker::DFS,
+                                 false, 0);
+    EXPECT_FALSE(result.equal());
+  }
+}
+
+TEST(BddCheckerTest, NegativeCells) {
+  auto &checker = BddChecker::get();
+  EXPECT_TRUE(checker.isSat(Subnet::get(makeNegativeMiter(true))).equal());
+
+  const auto &subnet = Subnet::get(makeNegativeMiter(false));
+  const auto result = checker.isSat(subnet);
+  ASSERT_TRUE(result.notEqual());
+
+  // The miter output is 1 for every input.
+  EXPECT_EQ(result.getCounterExample().size(), subnet.getInNum());
+}
+
+TEST(BddCheckerTest, NodeLimit) {
+  // The large random subnets do not fit into the small node limit.
+  const auto subnetID1 = randomSubnet(64, 1, 2000, 2, 2, 0);
+  const auto subnetID2 = randomSubnet(64, 1, 2000, 2, 2, 1);
+  const auto result = checkBdd(subnetID1, subnetID2, BddChecker::INPUT,
+                               false, 100);
+  EXPECT_FALSE(result.equal());
+}
+
+} // namespace eda::gate::debugger
@@ -0,0 +1,150 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/debugger/fraig_checker.h"
+#include "gate/debugger/sat_checker.h"
+#include "gate/model/utils/subnet_random.h"
+#include "gate/simulator/simulator.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <unordered_map>
+
+using namespace eda::gate::model;
+
+namespace eda::gate::debugger {
+
+/// Replaces each cell w/ its dual: f(x) = ~f*(~x).
+static SubnetID makeDual(const SubnetID subnetID) {
+  const auto &subnet = Subnet::get(subnetID);
+
+  SubnetBuilder builder;
+  std::unordered_map<size_t, Subnet::Link> links;
+
+  const auto inputs = builder.addInputs(subnet.getInNum());
+  for (size_t i = 0; i < subnet.getInNum(); ++i) {
+    links[i] = inputs[i];
+  }
+
+  for (size_t i = subnet.getInNum(); i < subnet.size(); ++i) {
+    const auto &cell = subnet.getCell(i);
+
+    Subnet::LinkList args;
+    for (size_t j = 0; j < cell.arity; ++j) {
+      const auto link = subnet.getLink(i, j);
+      const auto arg = links[link.idx];
+      args.push_back(link.inv ? arg : ~arg);
+    }
+
+    if (cell.isOut()) {
+      builder.addOutput(~args[0]);
+    } else if (cell.isZero() || cell.isOne()) {
+      links[i] = builder.addCell(cell.getSymbol());
+    } else if (cell.isAnd()) {
+      links[i] = ~builder.addCell(OR, args);
+    } else if (cell.isOr()) {
+      links[i] = ~builder.addCell(AND, args);
+    } else if (cell.isXor()) {
+      const auto link = builder.addCell(XOR, args);
+      links[i] = (cell.arity & 1) ? ~link : link;
+    } else {
+      links[i] = ~builder.addCell(cell.getSymbol(), args);
+    }
+
+    i += cell.more;
+  }
+
+  return builder.make();
+}
+
+static void checkFraig(const SubnetID subnetID1,
+                       const SubnetID subnetID2,
+                       const size_t simWords = 4) {
+  SubnetBuilder miterBuilder;
+  BaseChecker::makeMiter(miterBuilder, subnetID1, subnetID2);
+  const auto miterID = miterBuilder.make();
+  const auto &miter = Subnet::get(miterID);
+
+  auto &checker = FraigChecker::get();
+  checker.setSimWords(simWords);
+  const auto result = checker.isSat(miter);
+  checker.setSimWords(4);
+
+  const auto expected = SatChecker::get().isSat(miter);
+  EXPECT_EQ(result.status, expected.status);
+
+  if (result.notEqual()) {
+    simulator::Simulator simulator(std::make_shared<SubnetBuilder>(miterID));
+    simulator.simulate(result.getCounterExample());
+    EXPECT_TRUE(simulator.getOutput(0));
+  }
+}
+
+TEST(FraigCheckerTest, Equal) {
+  for (size_t seed = 0; seed < 10; ++seed) {
+    const auto subnetID = randomSubnet(10, 4, 200, 2, 3, seed);
+    checkFraig(subnetID, subnetID);
+    checkFraig(subnetID, makeDual(subnetID));
+  }
+}
+
+TEST(FraigCheckerTest, NotEqual) {
+  for (size_t seed = 0; seed < 10; ++seed) {
+    const auto subnetID1 = randomSubnet(10, 4, 200, 2, 3, seed);
+    const auto subnetID2 = randomSubnet(10, 4, 200, 2, 3, seed + 10);
+    checkFraig(subnetID1, subnetID2);
+  }
+}
+
+TEST(FraigCheckerTest, SimWords) {
+  for (size_t seed = 0; seed < 5; ++seed) {
+    const auto subnetID1 = randomSubnet(12, 4, 500, 2, 3, seed);
+    const auto subnetID2 = randomSubnet(12, 4, 500, 2, 3, seed + 5);
+    for (const size_t simWords : {1, 2, 8}) {
+      checkFraig(subnetID1, makeDual(subnetID1), simWords);
+      checkFraig(subnetID1, subnetID2, simWords);
+    }
+  }
+}
+
+TEST(FraigCheckerTest, Consts) {
+  SubnetBuilder builder1;
+  const auto input1 = builder1.addInput();
+  builder1.addOutput(builder1.addCell(AND, input1, ~input1));
+
+  SubnetBuilder builder2;
+  builder2.addInput();
+  builder2.addOutput(builder2.addCell(ZERO));
+
+  SubnetBuilder builder3;
+  builder3.addInput();
+  builder3.addOutput(builder3.addCell(ONE));
+
+  const auto subnetID1 = builder1.make();
+  const auto subnetID2 = builder2.make();
+  const auto subnetID3 = builder3.make();
+
+  checkFraig(subnetID1, subnetID2);
+  checkFraig(subnetID1, subnetID3);
+}
+
+TEST(FraigCheckerTest, RareDifference) {
+  // The difference is not found by random simulation.
+  SubnetBuilder builder1;
+  const auto inputs1 = builder1.addInputs(24);
+  builder1.addOutput(builder1.addCellTree(AND, inputs1, 2));
+
+  SubnetBuilder builder2;
+  builder2.addInputs(24);
+  builder2.addOutput(builder2.addCell(ZERO));
+
+  checkFraig(builder1.make(), builder2.make());
+}
+
+} // namespace eda::gate::debugger
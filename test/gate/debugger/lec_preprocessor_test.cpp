@@ -0,0 +1,129 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/debugger/lec_preprocessor.h"
+#include "gate/debugger/sat_checker.h"
+#include "gate/model/utils/subnet_random.h"
+#include "gate/simulator/simulator.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using namespace eda::gate::model;
+
+namespace eda::gate::debugger {
+
+static LecPreprocessor::Stats checkPreprocessed(const SubnetID subnetID1,
+                                                const SubnetID subnetID2) {
+  const auto &subnet1 = Subnet::get(subnetID1);
+  const auto &subnet2 = Subnet::get(subnetID2);
+
+  LecPreprocessor preprocessor;
+  const auto &checker = SatChecker::get();
+  const auto result = preprocessor.areEquivalent(checker, subnet1, subnet2);
+  const auto expected = checker.areEquivalent(subnet1, subnet2);
+  EXPECT_EQ(result.status, expected.status);
+
+  if (result.notEqual()) {
+    SubnetBuilder miterBuilder;
+    BaseChecker::makeMiter(miterBuilder, subnet1, subnet2);
+
+    simulator::Simulator simulator(std::make_shared<SubnetBuilder>(
+        miterBuilder.make()));
+    simulator.simulate(result.getCounterExample());
+    EXPECT_TRUE(simulator.getOutput(0));
+  }
+
+  return preprocessor.getStats();
+}
+
+static CellTypeID makeAnd3CellType() {
+  SubnetBuilder builder;
+  const auto inputs = builder.addInputs(3);
+  const auto and01 = builder.addCell(AND, inputs[0], inputs[1]);
+  builder.addOutput(builder.addCell(AND, and01, inputs[2]));
+
+  return makeCellType(
+      UNDEF,
+      "And3",
+      builder.make(),
+      makeCellTypeAttr(),
+      CellProperties{1, 0, 1, 0, 0, 0, 0, 0, 0},
+      3,
+      1);
+}
+
+TEST(LecPreprocessorTest, GateTypes) {
+  SubnetBuilder builder1;
+  const auto inputs1 = builder1.addInputs(3);
+  builder1.addOutput(~builder1.addCell(AND, inputs1[0], inputs1[1]));
+  builder1.addOutput(builder1.addCell(BUF, inputs1[1]));
+  builder1.addOutput(~builder1.addCell(XOR, inputs1[0], inputs1[2]));
+  builder1.addOutput(builder1.addCell(MAJ, inputs1));
+  builder1.addOutput(builder1.addCell(makeAnd3CellType(), inputs1));
+
+  SubnetBuilder builder2;
+  const auto inputs2 = builder2.addInputs(3);
+  const auto &x = inputs2[0], &y = inputs2[1], &z = inputs2[2];
+  builder2.addOutput(builder2.addCell(OR, ~y, ~x));
+  builder2.addOutput(~builder2.addCell(BUF, ~y));
+  builder2.addOutput(builder2.addCell(XOR, ~z, x));
+  builder2.addOutput(builder2.addCell(OR,
+      builder2.addCell(AND, x, y),
+      builder2.addCell(AND, z, builder2.addCell(OR, x, y))));
+  builder2.addOutput(builder2.addCell(AND, x, y, z));
+
+  const auto stats = checkPreprocessed(builder1.make(), builder2.make());
+  EXPECT_EQ(stats.nOut, 5);
+  EXPECT_EQ(stats.nProven, 5);
+}
+
+TEST(LecPreprocessorTest, Complement) {
+  SubnetBuilder builder1;
+  const auto inputs1 = builder1.addInputs(2);
+  builder1.addOutput(builder1.addCell(AND, inputs1[0], inputs1[1]));
+
+  SubnetBuilder builder2;
+  const auto inputs2 = builder2.addInputs(2);
+  builder2.addOutput(builder2.addCell(OR, ~inputs2[1], ~inputs2[0]));
+
+  const auto stats = checkPreprocessed(builder1.make(), builder2.make());
+  EXPECT_EQ(stats.nDisproved, 1);
+}
+
+TEST(LecPreprocessorTest, Duplicates) {
+  SubnetBuilder builder1;
+  const auto inputs1 = builder1.addInputs(2);
+  const auto and1 = builder1.addCell(AND, inputs1[0], inputs1[1]);
+  builder1.addOutput(and1);
+  builder1.addOutput(~and1);
+
+  SubnetBuilder builder2;
+  const auto inputs2 = builder2.addInputs(2);
+  const auto or2 = builder2.addCell(OR, inputs2[0], inputs2[1]);
+  builder2.addOutput(or2);
+  builder2.addOutput(~or2);
+
+  const auto stats = checkPreprocessed(builder1.make(), builder2.make());
+  EXPECT_EQ(stats.nDuplicates, 1);
+}
+
+TEST(LecPreprocessorTest, RandomSubnets) {
+  for (size_t seed = 0; seed < 10; ++seed) {
+    const auto subnetID1 = randomSubnet(10, 8, 200, 2, 4, seed);
+    const auto subnetID2 = randomSubnet(10, 8, 200, 2, 4, seed + 10);
+
+    const auto stats = checkPreprocessed(subnetID1, subnetID1);
+    EXPECT_EQ(stats.nProven, stats.nOut);
+
+    checkPreprocessed(subnetID1, subnetID2);
+  }
+}
+
+} // namespace eda::gate::debugger
@@ -0,0 +1,125 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/debugger/output_checker.h"
+#include "gate/debugger/sat_checker.h"
+#include "gate/model/utils/subnet_random.h"
+#include "gate/simulator/simulator.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using namespace eda::gate::model;
+
+namespace eda::gate::debugger {
+
+static void checkCounterExample(const SubnetID subnetID1,
+                                const SubnetID subnetID2,
+                                const size_t output,
+                                const CheckerResult &result) {
+  SubnetBuilder miterBuilder;
+  BaseChecker::makeOutputMiter(miterBuilder, Subnet::get(subnetID1),
+                               Subnet::get(subnetID2));
+
+  simulator::Simulator simulator(std::make_shared<SubnetBuilder>(
+      miterBuilder.make()));
+  simulator.simulate(result.getCounterExample());
+  EXPECT_TRUE(simulator.getOutput(output));
+}
+
+static OutputChecker::Result checkOutputs(
+    const SubnetID subnetID1,
+    const SubnetID subnetID2,
+    const OutputChecker::Settings &settings) {
+  OutputChecker checker(settings);
+  const auto result = checker.areEquivalent(subnetID1, subnetID2);
+  const auto expected = SatChecker::get().areEquivalent(subnetID1, subnetID2);
+  EXPECT_EQ(result.result.status, expected.status);
+
+  for (size_t i = 0; i < result.outputs.size(); ++i) {
+    if (result.outputs[i].notEqual()) {
+      checkCounterExample(subnetID1, subnetID2, i, result.outputs[i]);
+    }
+  }
+  return result;
+}
+
+static SubnetID makeGates(const bool isDual) {
+  SubnetBuilder builder;
+  const auto inputs = builder.addInputs(3);
+  const auto &x = inputs[0], &y = inputs[1], &z = inputs[2];
+
+  if (isDual) {
+    builder.addOutput(~builder.addCell(OR, ~x, ~y));
+    builder.addOutput(builder.addCell(AND, x, z));
+    builder.addOutput(builder.addCell(XOR, ~x, ~z));
+  } else {
+    builder.addOutput(builder.addCell(AND, x, y));
+    builder.addOutput(builder.addCell(OR, x, z));
+    builder.addOutput(builder.addCell(XOR, x, z));
+  }
+  return builder.make();
+}
+
+TEST(OutputCheckerTest, Gates) {
+  OutputChecker::Settings settings;
+  settings.nThreads = 2;
+
+  const auto result = checkOutputs(makeGates(false), makeGates(true), settings);
+  ASSERT_EQ(result.outputs.size(), 3);
+  EXPECT_TRUE(result.outputs[0].equal());
+  EXPECT_TRUE(result.outputs[1].notEqual());
+  EXPECT_TRUE(result.outputs[2].equal());
+  EXPECT_TRUE(result.result.notEqual());
+}
+
+TEST(OutputCheckerTest, Equal) {
+  OutputChecker::Settings settings;
+  settings.nThreads = 4;
+
+  for (size_t seed = 0; seed < 5; ++seed) {
+    const auto subnetID = randomSubnet(10, 16, 300, 2, 3, seed);
+    const auto result = checkOutputs(subnetID, subnetID, settings);
+    for (const auto &output : result.outputs) {
+      EXPECT_TRUE(output.equal());
+    }
+  }
+}
+
+TEST(OutputCheckerTest, NotEqual) {
+  for (const auto lec : {options::SAT, options::FRAIG}) {
+    OutputChecker::Settings settings;
+    settings.lec = lec;
+    settings.nThreads = 4;
+
+    for (size_t seed = 0; seed < 5; ++seed) {
+      const auto subnetID1 = randomSubnet(10, 16, 300, 2, 3, seed);
+      const auto subnetID2 = randomSubnet(10, 16, 300, 2, 3, seed + 5);
+      checkOutputs(subnetID1, subnetID2, settings);
+    }
+  }
+}
+
+TEST(OutputCheckerTest, StopOnMismatch) {
+  OutputChecker::Settings settings;
+  settings.nThreads = 1;
+  settings.stopOnMismatch = true;
+
+  const auto subnetID1 = randomSubnet(10, 16, 300, 2, 3, 0);
+  const auto subnetID2 = randomSubnet(10, 16, 300, 2, 3, 1);
+  const auto result = checkOutputs(subnetID1, subnetID2, settings);
+
+  size_t nNotEqual = 0;
+  for (const auto &output : result.outputs) {
+    nNotEqual += output.notEqual();
+  }
+  EXPECT_EQ(nNotEqual, 1);
+}
+
+} // namespace eda::gate::debugger
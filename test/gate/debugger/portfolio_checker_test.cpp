@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/debugger/portfolio_checker.h"
+#include "gate/debugger/sat_checker.h"
+#include "gate/model/utils/subnet_random.h"
+#include "gate/simulator/simulator.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using namespace eda::gate::model;
+
+namespace eda::gate::debugger {
+
+static CheckerResult checkPortfolio(const SubnetID subnetID1,
+                                    const SubnetID subnetID2) {
+  SubnetBuilder miterBuilder;
+  BaseChecker::makeMiter(miterBuilder, subnetID1, subnetID2);
+  const auto miterID = miterBuilder.make();
+  const auto result = PortfolioChecker::get().isSat(Subnet::get(miterID));
+
+  if (result.notEqual()) {
+    simulator::Simulator simulator(std::make_shared<SubnetBuilder>(miterID));
+    simulator.simulate(result.getCounterExample());
+    EXPECT_TRUE(simulator.getOutput(0));
+  }
+
+  return result;
+}
+
+static size_t getWinNum() {
+  size_t nWins = 0;
+  for (const auto &stats : PortfolioChecker::get().getStats()) {
+    nWins += stats.nWins;
+  }
+  return nWins;
+}
+
+TEST(PortfolioCheckerTest, Equal) {
+  PortfolioChecker::get().resetStats();
+  for (size_t seed = 0; seed < 5; ++seed) {
+    const auto subnetID = randomSubnet(16, 4, 300, 2, 3, seed);
+    EXPECT_TRUE(checkPortfolio(subnetID, subnetID).equal());
+  }
+  EXPECT_EQ(getWinNum(), 5);
+}
+
+TEST(PortfolioCheckerTest, NotEqual) {
+  PortfolioChecker::get().resetStats();
+  for (size_t seed = 0; seed < 5; ++seed) {
+    const auto subnetID1 = randomSubnet(16, 4, 300, 2, 3, seed);
+    const auto subnetID2 = randomSubnet(16, 4, 300, 2, 3, seed + 10);
+    EXPECT_FALSE(checkPortfolio(subnetID1, subnetID2).equal());
+  }
+}
+
+TEST(PortfolioCheckerTest, Stopped) {
+  const auto subnetID1 = randomSubnet(16, 4, 300, 2, 3, 0);
+  const auto subnetID2 = randomSubnet(16, 4, 300, 2, 3, 10);
+
+  SubnetBuilder miterBuilder;
+  BaseChecker::makeMiter(miterBuilder, subnetID1, subnetID2);
+  const auto &miter = Subnet::get(miterBuilder.make());
+
+  // The raised stop flag cancels the checkers of the current thread.
+  BaseChecker::StopFlag stop{true};
+  BaseChecker::setStopFlag(&stop);
+  const auto satResult = SatChecker::get().isSat(miter);
+  const auto portfolioResult = PortfolioChecker::get().isSat(miter);
+  BaseChecker::setStopFlag(nullptr);
+
+  // The result found before polling the flag may still be returned.
+  EXPECT_TRUE(satResult.isUnknown());
+  EXPECT_FALSE(portfolioResult.equal());
+}
+
+} // namespace eda::gate::debugger
@@ -0,0 +1,103 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/debugger/rnd_checker.h"
+#include "gate/model/utils/subnet_random.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using namespace eda::gate::model;
+
+namespace eda::gate::debugger {
+
+static CheckerResult checkRnd(const SubnetID subnetID1,
+                              const SubnetID subnetID2,
+                              const bool exhaustive,
+                              const size_t nThreads) {
+  auto &checker = RndChecker::get();
+  checker.setExhaustive(exhaustive);
+  checker.setThreads(nThreads);
+
+  SubnetBuilder miterBuilder;
+  BaseChecker::makeMiter(miterBuilder, subnetID1, subnetID2);
+  const auto miterID = miterBuilder.make();
+  const auto result = checker.isSat(Subnet::get(miterID));
+
+  if (result.notEqual()) {
+    simulator::Simulator simulator(std::make_shared<SubnetBuilder>(miterID));
+    simulator.simulate(result.getCounterExample());
+    EXPECT_TRUE(simulator.getOutput(0));
+  }
+
+  checker.setExhaustive(false);
+  checker.setThreads(0);
+  return result;
+}
+
+TEST(RndCheckerTest, AllValues) {
+  const size_t nIn = 10;
+  const size_t count = 5;
+
+  const auto values = getAllValues(nIn, count);
+  ASSERT_EQ(values.size(), nIn);
+
+  for (size_t p = 0; p < 64; ++p) {
+    const auto pattern = count * 64 + p;
+    for (size_t i = 0; i < nIn; ++i) {
+      EXPECT_EQ((values[i] >> p) & 1, (pattern >> i) & 1);
+    }
+  }
+}
+
+TEST(RndCheckerTest, ExhaustiveEqual) {
+  for (const size_t nThreads : {1, 4}) {
+    const auto subnetID = randomSubnet(14, 4, 200, 2, 3, nThreads);
+    EXPECT_TRUE(checkRnd(subnetID, subnetID, true, nThreads).equal());
+  }
+}
+
+TEST(RndCheckerTest, ExhaustiveRareDifference) {
+  // The only distinguishing pattern is in the last block.
+  SubnetBuilder builder1;
+  const auto inputs1 = builder1.addInputs(20);
+  builder1.addOutput(builder1.addCellTree(AND, inputs1, 2));
+
+  SubnetBuilder builder2;
+  builder2.addInputs(20);
+  builder2.addOutput(builder2.addCell(ZERO));
+
+  const auto subnetID1 = builder1.make();
+  const auto subnetID2 = builder2.make();
+
+  for (const size_t nThreads : {1, 4}) {
+    const auto result = checkRnd(subnetID1, subnetID2, true, nThreads);
+    ASSERT_TRUE(result.notEqual());
+    EXPECT_EQ(result.getCounterExample(), std::vector<bool>(20, true));
+  }
+}
+
+TEST(RndCheckerTest, ExhaustiveTooManyInputs) {
+  SubnetBuilder builder;
+  const auto inputs = builder.addInputs(RndChecker::MaxExhaustiveInNum + 1);
+  builder.addOutput(builder.addCellTree(AND, inputs, 2));
+  const auto subnetID = builder.make();
+
+  EXPECT_TRUE(checkRnd(subnetID, subnetID, true, 1).isError());
+}
+
+TEST(RndCheckerTest, RandomNotEqual) {
+  for (size_t seed = 0; seed < 10; ++seed) {
+    const auto subnetID1 = randomSubnet(48, 4, 200, 2, 3, seed);
+    const auto subnetID2 = randomSubnet(48, 4, 200, 2, 3, seed + 10);
+    EXPECT_FALSE(checkRnd(subnetID1, subnetID2, false, 1).equal());
+  }
+}
+
+} // namespace eda::gate::debugger
@@ -106,4 +106,15 @@ TEST(SatChecker, CellWithMoreThan5Inputs) {
   EXPECT_TRUE(checker.areEquivalent(subnetID1, subnetID2).equal());
 }
 
+TEST(SatChecker, CounterExample) {
+  model::SubnetBuilder builder;
+  const auto inputs = builder.addInputs(2);
+  builder.addOutput(builder.addCell(model::AND, inputs[0], ~inputs[1]));
+
+  debugger::SatChecker &checker = debugger::SatChecker::get();
+  const auto result = checker.isSat(model::Subnet::get(builder.make()));
+  ASSERT_TRUE(result.notEqual());
+  EXPECT_EQ(result.getCounterExample(), std::vector<bool>({true, false}));
+}
+
 } // namespace eda::gate::debugger
@@ -0,0 +1,119 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/debugger/seq_checker.h"
+#include "gate/simulator/simulator.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using namespace eda::gate::model;
+
+namespace eda::gate::debugger {
+
+// Implements the toggle flip-flop: y = s, s' = s ^ x.
+static SeqCircuit makeToggle() {
+  SubnetBuilder builder;
+  const auto x = builder.addInput();
+  const auto s = builder.addInput();
+  builder.addOutput(s);
+  builder.addOutput(builder.addCell(XOR, s, x));
+  return SeqCircuit{builder.make(), 1, {}};
+}
+
+// Implements the 2-bit counter: y = s[bit], s' = s + x.
+static SeqCircuit makeCounter(const size_t bit) {
+  SubnetBuilder builder;
+  const auto x = builder.addInput();
+  const auto s = builder.addInputs(2);
+  builder.addOutput(s[bit]);
+  builder.addOutput(builder.addCell(XOR, s[0], x));
+  builder.addOutput(builder.addCell(XOR, s[1],
+      builder.addCell(AND, s[0], x)));
+  return SeqCircuit{builder.make(), 2, {}};
+}
+
+// Implements the modulo-3 counter: y = (s == 3), s' = (s[1] ? 0 : s + 1).
+static SeqCircuit makeMod3Counter() {
+  SubnetBuilder builder;
+  const auto x = builder.addInput();
+  const auto s = builder.addInputs(2);
+  builder.addOutput(builder.addCell(AND, s[0], s[1], x));
+  builder.addOutput(builder.addCell(AND, ~s[0], ~s[1]));
+  builder.addOutput(builder.addCell(AND, s[0], ~s[1]));
+  return SeqCircuit{builder.make(), 2, {}};
+}
+
+// Implements the constant zero.
+static SeqCircuit makeZero() {
+  SubnetBuilder builder;
+  builder.addInput();
+  builder.addOutput(builder.addCell(ZERO));
+  return SeqCircuit{builder.make(), 0, {}};
+}
+
+static SeqChecker::Result checkSeq(const SeqCircuit &circuit1,
+                                   const SeqCircuit &circuit2,
+                                   const SeqChecker::Settings &settings) {
+  const auto miter = SeqChecker::makeMiter(circuit1, circuit2);
+  const auto result = SeqChecker(settings).isSat(miter);
+
+  if (result.result.notEqual()) {
+    EXPECT_EQ(result.trace.size(), result.depth);
+
+    // The trace is replayed from the initial state.
+    std::vector<bool> state(miter.init);
+    for (size_t k = 0; k < result.trace.size(); ++k) {
+      std::vector<bool> values(result.trace[k]);
+      values.insert(values.end(), state.begin(), state.end());
+
+      simulator::Simulator simulator(
+          std::make_shared<SubnetBuilder>(miter.subnetID));
+      simulator.simulate(values);
+
+      const bool isLast = (k + 1 == result.trace.size());
+      EXPECT_EQ(simulator.getOutput(0) & 1, isLast);
+
+      for (size_t i = 0; i < state.size(); ++i) {
+        state[i] = simulator.getOutput(i + 1) & 1;
+      }
+    }
+  }
+
+  return result;
+}
+
+TEST(SeqCheckerTest, Equal) {
+  const auto result = checkSeq(makeToggle(), makeCounter(0), {});
+  EXPECT_TRUE(result.result.equal());
+  EXPECT_EQ(result.depth, 2);
+}
+
+TEST(SeqCheckerTest, NotEqual) {
+  const auto result = checkSeq(makeToggle(), makeCounter(1), {});
+  EXPECT_TRUE(result.result.notEqual());
+  EXPECT_EQ(result.depth, 2);
+}
+
+TEST(SeqCheckerTest, UnreachableState) {
+  const auto result = checkSeq(makeZero(), makeMod3Counter(), {});
+  EXPECT_TRUE(result.result.equal());
+}
+
+TEST(SeqCheckerTest, BoundReached) {
+  SeqChecker::Settings settings;
+  settings.maxDepth = 5;
+  settings.induction = false;
+
+  const auto result = checkSeq(makeToggle(), makeCounter(0), settings);
+  EXPECT_TRUE(result.result.isUnknown());
+  EXPECT_EQ(result.depth, 5);
+}
+
+} // namespace eda::gate::debugger
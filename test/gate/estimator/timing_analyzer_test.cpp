@@ -0,0 +1,219 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/estimator/timing_analyzer.h"
+#include "gate/library/library_factory.h"
+#include "gate/library/readcells_srcfile_parser.h"
+#include "util/env.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace eda::gate::estimator {
+
+using Link = model::Subnet::Link;
+using SubnetBuilder = model::SubnetBuilder;
+
+class TimingAnalyzerTest : public testing::Test {
+protected:
+  static void SetUpTestSuite() {
+    const std::filesystem::path filePath = eda::env::getHomePath() /
+        "test/data/gate/techmapper/sky130_fd_sc_hd__ff_100C_1v65.lib";
+
+    library::ReadCellsParser parser(filePath);
+    library = library::SCLibraryFactory::newLibraryUPtr(parser);
+    if (library == nullptr) {
+      throw std::runtime_error("File loading failed");
+    }
+    library->prepareLib();
+  }
+
+  static void TearDownTestSuite() {
+    library.reset();
+  }
+
+  static model::CellTypeID getCellTypeID(const std::string &name) {
+    for (const auto &cell : library->getCombCells()) {
+      if (cell.name == "sky130_fd_sc_hd__" + name) {
+        return cell.cellTypeID;
+      }
+    }
+    throw std::runtime_error("Cell not found: " + name);
+  }
+
+  static void expectEqual(const double lhs, const double rhs) {
+    if (std::isinf(lhs) || std::isinf(rhs)) {
+      EXPECT_EQ(lhs, rhs);
+    } else {
+      EXPECT_NEAR(lhs, rhs, 1e-9);
+    }
+  }
+
+  /// Compares the incrementally updated timing w/ the full analysis.
+  static void checkUpdate(SubnetBuilder &builder,
+                          const TimingAnalyzer &analyzer) {
+    const TimingAnalyzer expected(builder, *library);
+    expectEqual(analyzer.getDelay(), expected.getDelay());
+
+    for (auto it = builder.begin(); it != builder.end(); it.nextCell()) {
+      const auto i = *it;
+      expectEqual(analyzer.getArrivalRiseFall(i).rise,
+                  expected.getArrivalRiseFall(i).rise);
+      expectEqual(analyzer.getArrivalRiseFall(i).fall,
+                  expected.getArrivalRiseFall(i).fall);
+      expectEqual(analyzer.getSlewRiseFall(i).rise,
+                  expected.getSlewRiseFall(i).rise);
+      expectEqual(analyzer.getSlewRiseFall(i).fall,
+                  expected.getSlewRiseFall(i).fall);
+      expectEqual(analyzer.getLoad(i), expected.getLoad(i));
+      expectEqual(analyzer.getRequired(i), expected.getRequired(i));
+      expectEqual(analyzer.getSlack(i), expected.getSlack(i));
+    }
+  }
+
+  static void checkCriticalPath(const SubnetBuilder &builder,
+                                const TimingAnalyzer &analyzer) {
+    const auto path = analyzer.getCriticalPath();
+    ASSERT_FALSE(path.empty());
+    EXPECT_TRUE(builder.getCell(path.front().entryID).isIn());
+    EXPECT_TRUE(builder.getCell(path.back().entryID).isOut());
+    EXPECT_NEAR(path.back().arrival, analyzer.getDelay(), 1e-9);
+
+    for (size_t i = 1; i < path.size(); ++i) {
+      EXPECT_LE(path[i - 1].arrival, path[i].arrival);
+    }
+    for (const auto &point : path) {
+      EXPECT_NEAR(analyzer.getSlack(point.entryID),
+                  analyzer.getWorstSlack(), 1e-9);
+    }
+  }
+
+  static inline std::unique_ptr<library::SCLibrary> library;
+};
+
+TEST_F(TimingAnalyzerTest, Chain) {
+  SubnetBuilder builder;
+  const auto inputs = builder.addInputs(2);
+  Link link = builder.addCell(getCellTypeID("nand2_1"), {inputs[0], inputs[1]});
+  link = builder.addCell(getCellTypeID("inv_1"), {link});
+  link = builder.addCell(getCellTypeID("buf_1"), {link});
+  builder.addOutput(link);
+
+  const TimingAnalyzer analyzer(builder, *library);
+  EXPECT_GT(analyzer.getDelay(), 0.);
+  EXPECT_NEAR(analyzer.getWorstSlack(), 0., 1e-9);
+
+  // Inverting cells switch the transitions.
+  const auto &nand = analyzer.getArrivalRiseFall(2);
+  const auto &inv = analyzer.getArrivalRiseFall(3);
+  EXPECT_GT(inv.rise, nand.fall);
+  EXPECT_GT(inv.fall, nand.rise);
+
+  // The loads include the fanout pin capacitances.
+  EXPECT_GT(analyzer.getLoad(2), 0.);
+  EXPECT_GT(analyzer.getLoad(0), 0.);
+
+  checkCriticalPath(builder, analyzer);
+
+  // The printed path goes from the input to the output w/ rising arrivals.
+  std::ostringstream out;
+  analyzer.printCriticalPath(out);
+
+  std::istringstream in(out.str());
+  std::string header;
+  std::getline(in, header);
+  EXPECT_EQ(header.rfind("Entry", 0), 0u);
+
+  std::vector<model::EntryID> entries;
+  std::vector<double> arrivals;
+
+  model::EntryID entryID;
+  std::string cell, edge;
+  double arrival, slew;
+  while (in >> entryID >> cell >> edge >> arrival >> slew) {
+    EXPECT_TRUE(edge == "rise" || edge == "fall") << edge;
+    entries.push_back(entryID);
+    arrivals.push_back(arrival);
+  }
+
+  const auto path = analyzer.getCriticalPath();
+  ASSERT_EQ(entries.size(), path.size());
+  EXPECT_TRUE(builder.getCell(entries.front()).isIn());
+  EXPECT_EQ(entries.back(), builder.getMaxIdx());
+  EXPECT_TRUE(builder.getCell(entries.back()).isOut());
+
+  for (size_t i = 1; i < arrivals.size(); ++i) {
+    EXPECT_LE(arrivals[i - 1], arrivals[i]);
+  }
+  EXPECT_NEAR(arrivals.back(), analyzer.getDelay(), 1e-6);
+}
+
+TEST_F(TimingAnalyzerTest, RequiredTime) {
+  SubnetBuilder builder;
+  const auto inputs = builder.addInputs(2);
+  const auto link0 =
+      builder.addCell(getCellTypeID("nand2_1"), {inputs[0], inputs[1]});
+  const auto link1 = builder.addCell(getCellTypeID("inv_1"), {link0});
+  const auto out0 = builder.addOutput(link1);
+  const auto out1 = builder.addOutput(inputs[1]);
+
+  TimingAnalyzer::Settings settings;
+  settings.requiredTime = 1.;
+  const TimingAnalyzer analyzer(builder, *library, settings);
+
+  EXPECT_NEAR(analyzer.getWorstSlack(), 1. - analyzer.getDelay(), 1e-9);
+  EXPECT_NEAR(analyzer.getSlack(link1.idx), analyzer.getWorstSlack(), 1e-9);
+  EXPECT_NEAR(analyzer.getRequired(out0.idx), 1., 1e-9);
+  EXPECT_NEAR(analyzer.getSlack(out1.idx), 1., 1e-9);
+  EXPECT_LT(analyzer.getRequired(link0.idx), analyzer.getRequired(link1.idx));
+}
+
+TEST_F(TimingAnalyzerTest, IncrementalUpdate) {
+  const auto nand2 = getCellTypeID("nand2_1");
+  const auto inv1 = getCellTypeID("inv_1");
+  const auto inv4 = getCellTypeID("inv_4");
+  const auto buf1 = getCellTypeID("buf_1");
+
+  SubnetBuilder builder;
+  const auto inputs = builder.addInputs(2);
+  const auto a = builder.addCell(nand2, {inputs[0], inputs[1]});
+  const auto b = builder.addCell(inv1, {a});
+  const auto c = builder.addCell(inv1, {b});
+  const auto d = builder.addCell(nand2, {b, inputs[1]});
+  builder.addOutput(c);
+  builder.addOutput(d);
+
+  TimingAnalyzer analyzer(builder, *library);
+  const auto callback = analyzer.getChangeCallback();
+
+  // Resizing: the load of the fanin is changed.
+  builder.replaceCell(c.idx, inv4, {b}, true, &callback, &callback);
+  analyzer.update();
+  checkUpdate(builder, analyzer);
+
+  // Relinking: the old fanin loses the fanout.
+  builder.replaceCell(c.idx, buf1, {a}, true, &callback, &callback);
+  analyzer.update();
+  checkUpdate(builder, analyzer);
+
+  // Deleting: the fanin of the deleted cell loses the fanout.
+  builder.replaceCell(d.idx, nand2, {a, inputs[1]}, true, &callback, &callback);
+  analyzer.update();
+  checkUpdate(builder, analyzer);
+
+  checkCriticalPath(builder, analyzer);
+}
+
+} // namespace eda::gate::estimator
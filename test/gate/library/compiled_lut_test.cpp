@@ -0,0 +1,131 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/library/compiled_lut.h"
+#include "gate/library/library_types.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+namespace eda::gate::library {
+
+static LUT makeLut(const std::vector<double> &indexX,
+                   const std::vector<double> &indexY,
+                   const double seed) {
+  LUT lut;
+  lut.indexes = {indexX, indexY};
+  for (size_t i = 0; i < indexX.size(); ++i) {
+    for (size_t j = 0; j < indexY.size(); ++j) {
+      lut.values.push_back(seed + indexX[i] * (j + 1) + std::sqrt(indexY[j]));
+    }
+  }
+  return lut;
+}
+
+/// Reference (bi)linear interpolation/extrapolation.
+static double getReferenceValue(const LUT &lut, double x, double y) {
+  const auto &indexX = lut.indexes[0];
+  const auto &indexY = lut.indexes[1];
+
+  const auto locate = [](const std::vector<double> &index, double v) {
+    size_t i = 0;
+    while (i + 2 < index.size() && v >= index[i + 1]) i++;
+    return i;
+  };
+
+  const size_t i = locate(indexX, x);
+  const size_t j = locate(indexY, y);
+  const double tx = (x - indexX[i]) / (indexX[i + 1] - indexX[i]);
+  const double ty = (y - indexY[j]) / (indexY[j + 1] - indexY[j]);
+
+  const double r0 = lut.getValue(i, j) * (1 - ty) + lut.getValue(i, j + 1) * ty;
+  const double r1 =
+      lut.getValue(i + 1, j) * (1 - ty) + lut.getValue(i + 1, j + 1) * ty;
+  return r0 * (1 - tx) + r1 * tx;
+}
+
+static void checkLut(const LUT &lut) {
+  const CompiledLut compiled(lut);
+  ASSERT_FALSE(compiled.isEmpty());
+
+  const auto &indexX = lut.indexes[0];
+  const auto &indexY = lut.indexes[1];
+
+  // Exact points.
+  for (size_t i = 0; i < indexX.size(); ++i) {
+    for (size_t j = 0; j < indexY.size(); ++j) {
+      EXPECT_NEAR(compiled.getValue(indexX[i], indexY[j]),
+                  lut.getValue(i, j), 1e-5);
+    }
+  }
+
+  // Random points (including extrapolation).
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> distX(-indexX.back(),
+                                               2 * indexX.back());
+  std::uniform_real_distribution<double> distY(0, 2 * indexY.back());
+  for (size_t k = 0; k < 1000; ++k) {
+    const double x = distX(rng);
+    const double y = distY(rng);
+    const double expected = getReferenceValue(lut, x, y);
+    EXPECT_NEAR(compiled.getValue(x, y), expected,
+                1e-5 * std::max(1., std::fabs(expected)));
+  }
+}
+
+TEST(CompiledLutTest, UniformGrid) {
+  checkLut(makeLut({0.0, 0.1, 0.2, 0.3, 0.4, 0.5, 0.6},
+                   {0.0, 0.05, 0.1, 0.15, 0.2}, 0.5));
+}
+
+TEST(CompiledLutTest, NonUniformGrid) {
+  checkLut(makeLut({0.01, 0.023, 0.0531, 0.1224, 0.2823, 0.651, 1.5},
+                   {0.0005, 0.0013, 0.0034, 0.0089, 0.0233, 0.0612, 0.16},
+                   0.1));
+}
+
+TEST(CompiledLutTest, TimingArc) {
+  const std::vector<double> indexX{0.01, 0.023, 0.0531, 0.1224, 0.2823};
+  const std::vector<double> indexY{0.0005, 0.0013, 0.0034, 0.0089, 0.0233};
+
+  const auto delayFall = makeLut(indexX, indexY, 0.1);
+  const auto delayRise = makeLut(indexX, indexY, 0.2);
+  const auto slewFall = makeLut(indexX, indexY, 0.4);
+  const auto slewRise = makeLut(indexX, indexY, 0.3);
+
+  const CompiledTimingArc arc(delayFall, delayRise, slewFall, slewRise);
+
+  const double x = 0.07, y = 0.005;
+  const auto value = arc.getValue(x, y);
+  EXPECT_NEAR(value.delay, getReferenceValue(delayRise, x, y), 1e-5);
+  EXPECT_NEAR(value.slew, getReferenceValue(slewFall, x, y), 1e-5);
+
+  // Batched queries.
+  constexpr size_t n = 100000;
+  std::vector<double> xs(n), ys(n);
+  std::mt19937 rng(0);
+  std::uniform_real_distribution<double> distX(0., 0.3), distY(0., 0.03);
+  for (size_t i = 0; i < n; ++i) {
+    xs[i] = distX(rng);
+    ys[i] = distY(rng);
+  }
+
+  std::vector<CompiledTimingArc::Value> values(n);
+  arc.getValues(xs.data(), ys.data(), values.data(), n);
+
+  for (size_t i = 0; i < n; i += 997) {
+    EXPECT_NEAR(values[i].delay,
+                getReferenceValue(delayRise, xs[i], ys[i]), 1e-5);
+  }
+}
+
+} // namespace eda::gate::library
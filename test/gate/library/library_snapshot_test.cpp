@@ -0,0 +1,210 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/library/library_snapshot.h"
+#include "gate/model/utils/subnet_truth_table.h"
+#include "util/env.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace eda::gate::library {
+
+namespace fs = std::filesystem;
+
+static const std::vector<std::string> libFiles = {
+  (eda::env::getHomePath() /
+   "test/data/gate/techmapper/sky130_fd_sc_hd__ff_100C_1v65.lib").string()
+};
+
+static std::string getSnapshotFile() {
+  const fs::path dir = fs::temp_directory_path() / "utopia_test";
+  fs::create_directories(dir);
+  return (dir / "sky130.snapshot").string();
+}
+
+static void checkEqual(const SCLibrary &lhs, const SCLibrary &rhs) {
+  ASSERT_TRUE(lhs.isPrepared());
+  ASSERT_TRUE(rhs.isPrepared());
+  EXPECT_EQ(lhs.getProperties().maxArity, rhs.getProperties().maxArity);
+  EXPECT_EQ(lhs.getWLMs(), rhs.getWLMs());
+  EXPECT_EQ(lhs.getTemplates().size(), rhs.getTemplates().size());
+
+  const auto &lhsCells = lhs.getCombCells();
+  const auto &rhsCells = rhs.getCombCells();
+  ASSERT_EQ(lhsCells.size(), rhsCells.size());
+
+  for (size_t i = 0; i < lhsCells.size(); ++i) {
+    const auto &lhsCell = lhsCells[i];
+    const auto &rhsCell = rhsCells[i];
+    EXPECT_EQ(lhsCell.name, rhsCell.name);
+    EXPECT_EQ(lhsCell.ctt, rhsCell.ctt);
+    EXPECT_EQ(lhsCell.inputPins.size(), rhsCell.inputPins.size());
+    ASSERT_EQ(lhsCell.outputPins.size(), rhsCell.outputPins.size());
+    ASSERT_EQ(lhsCell.transform.size(), rhsCell.transform.size());
+
+    for (size_t j = 0; j < lhsCell.transform.size(); ++j) {
+      EXPECT_EQ(lhsCell.transform[j].negationMask,
+                rhsCell.transform[j].negationMask);
+      EXPECT_EQ(lhsCell.transform[j].permutation,
+                rhsCell.transform[j].permutation);
+    }
+
+    for (size_t j = 0; j < lhsCell.outputPins.size(); ++j) {
+      const auto &lhsPin = lhsCell.outputPins[j];
+      const auto &rhsPin = rhsCell.outputPins[j];
+      EXPECT_EQ(lhsPin.relatedPins, rhsPin.relatedPins);
+      EXPECT_EQ(lhsPin.timingArcInputs, rhsPin.timingArcInputs);
+      EXPECT_EQ(lhsPin.unateness, rhsPin.unateness);
+      ASSERT_EQ(lhsPin.timingArcs.size(), rhsPin.timingArcs.size());
+      for (size_t k = 0; k < lhsPin.timingArcs.size(); ++k) {
+        const auto lhsValue = lhsPin.timingArcs[k].getValue(0.1, 0.01);
+        const auto rhsValue = rhsPin.timingArcs[k].getValue(0.1, 0.01);
+        EXPECT_EQ(lhsValue.delay, rhsValue.delay);
+        EXPECT_EQ(lhsValue.slew, rhsValue.slew);
+      }
+    }
+
+    // The cell types are recreated w/ the same attributes and functions.
+    const auto &lhsType = model::CellType::get(lhsCell.cellTypeID);
+    const auto &rhsType = model::CellType::get(rhsCell.cellTypeID);
+    EXPECT_EQ(lhsType.getName(), rhsType.getName());
+    EXPECT_EQ(lhsType.getInNum(), rhsType.getInNum());
+    EXPECT_EQ(lhsType.getOutNum(), rhsType.getOutNum());
+    EXPECT_EQ(lhsType.getAttr().getPhysProps().area,
+              rhsType.getAttr().getPhysProps().area);
+    if (lhsType.getInNum() != 0) {
+      EXPECT_EQ(model::evaluate(lhsType.getSubnet()),
+                model::evaluate(rhsType.getSubnet()));
+    }
+
+    EXPECT_EQ(rhs.getCellPtr(rhsCell.cellTypeID), &rhsCell);
+  }
+
+  const auto &lhsProps = lhs.getProperties();
+  const auto &rhsProps = rhs.getProperties();
+  ASSERT_NE(rhsProps.cheapNegCell.first, nullptr);
+  EXPECT_EQ(lhsProps.cheapNegCell.first->name,
+            rhsProps.cheapNegCell.first->name);
+  EXPECT_EQ(lhsProps.cheapNegCell.second, rhsProps.cheapNegCell.second);
+  EXPECT_EQ(lhsProps.defaultWLM == nullptr, rhsProps.defaultWLM == nullptr);
+}
+
+TEST(LibrarySnapshotTest, SaveLoad) {
+  const auto snapshotFile = getSnapshotFile();
+  fs::remove(snapshotFile);
+
+  // The library is parsed and the snapshot is written.
+  const auto expected = loadLibrary(libFiles, snapshotFile);
+  ASSERT_TRUE(fs::exists(snapshotFile));
+
+  // No temporary file is left.
+  for (const auto &entry :
+       fs::directory_iterator(fs::path(snapshotFile).parent_path())) {
+    EXPECT_NE(entry.path().extension(), ".tmp") << entry.path();
+  }
+
+  const auto key = SCLibrarySnapshot::getKey(libFiles);
+  const auto actual = SCLibrarySnapshot::load(snapshotFile, key);
+  ASSERT_NE(actual, nullptr);
+  checkEqual(*expected, *actual);
+
+  // The snapshot is reused.
+  const auto reused = loadLibrary(libFiles, snapshotFile);
+  checkEqual(*expected, *reused);
+}
+
+TEST(LibrarySnapshotTest, Stale) {
+  const auto snapshotFile = getSnapshotFile();
+  const auto key = SCLibrarySnapshot::getKey(libFiles);
+
+  if (!fs::exists(snapshotFile)) {
+    loadLibrary(libFiles, snapshotFile);
+  }
+
+  // The snapshot of other files is ignored.
+  EXPECT_EQ(SCLibrarySnapshot::load(snapshotFile, key + 1), nullptr);
+  EXPECT_EQ(SCLibrarySnapshot::load(snapshotFile + ".missing", key), nullptr);
+
+  // The corrupted snapshot is rejected.
+  const auto corruptedFile = snapshotFile + ".corrupted";
+  fs::copy_file(snapshotFile, corruptedFile,
+                fs::copy_options::overwrite_existing);
+  fs::resize_file(corruptedFile, fs::file_size(snapshotFile) / 2);
+  EXPECT_THROW(SCLibrarySnapshot::load(corruptedFile, key),
+               std::runtime_error);
+  fs::remove(corruptedFile);
+}
+
+TEST(LibrarySnapshotTest, SuperGateSettings) {
+  const auto snapshotFile = getSnapshotFile();
+  if (!fs::exists(snapshotFile)) {
+    loadLibrary(libFiles, snapshotFile);
+  }
+
+  SuperGateGenerator::Settings settings;
+  settings.maxDepth = 1;
+
+  // The snapshot prepared w/ other supergate settings is ignored.
+  const auto key = SCLibrarySnapshot::getKey(libFiles, settings);
+  EXPECT_NE(key, SCLibrarySnapshot::getKey(libFiles));
+  EXPECT_EQ(SCLibrarySnapshot::load(snapshotFile, key, settings), nullptr);
+
+  const auto library = loadLibrary(libFiles, snapshotFile, settings);
+  ASSERT_NE(library, nullptr);
+  EXPECT_EQ(library->getSuperGateSettings().maxDepth, settings.maxDepth);
+  for (const auto &cell : library->getCombCells()) {
+    EXPECT_EQ(cell.name.find('('), std::string::npos) << cell.name;
+  }
+
+  // The snapshot has been rewritten for the new settings.
+  EXPECT_NE(SCLibrarySnapshot::load(snapshotFile, key, settings), nullptr);
+  fs::remove(snapshotFile);
+}
+
+TEST(LibrarySnapshotTest, Corrupted) {
+  const auto snapshotFile = getSnapshotFile();
+  const auto key = SCLibrarySnapshot::getKey(libFiles);
+
+  if (!fs::exists(snapshotFile)) {
+    loadLibrary(libFiles, snapshotFile);
+  }
+
+  // The number of cell types (following the header) is corrupted.
+  const auto corruptedFile = snapshotFile + ".corrupted";
+  fs::copy_file(snapshotFile, corruptedFile,
+                fs::copy_options::overwrite_existing);
+  {
+    std::fstream file(corruptedFile,
+                      std::ios::in | std::ios::out | std::ios::binary);
+    file.seekp(sizeof(SCLibrarySnapshotHeader));
+    const uint32_t nTypes = -1u;
+    file.write(reinterpret_cast<const char*>(&nTypes), sizeof(nTypes));
+  }
+
+  // The sizes are checked before allocating the data.
+  EXPECT_THROW(SCLibrarySnapshot::load(corruptedFile, key),
+               std::runtime_error);
+
+  // The Liberty files are parsed instead of the corrupted snapshot.
+  const auto library = loadLibrary(libFiles, corruptedFile);
+  ASSERT_NE(library, nullptr);
+  EXPECT_TRUE(library->isPrepared());
+  EXPECT_FALSE(library->getCombCells().empty());
+
+  // The snapshot has been rewritten.
+  EXPECT_NE(SCLibrarySnapshot::load(corruptedFile, key), nullptr);
+  fs::remove(corruptedFile);
+}
+
+} // namespace eda::gate::library
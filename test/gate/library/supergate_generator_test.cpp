@@ -0,0 +1,155 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/library/library_factory.h"
+#include "gate/library/readcells_srcfile_parser.h"
+#include "gate/library/supergate_generator.h"
+#include "gate/model/utils/subnet_truth_table.h"
+#include "util/env.h"
+#include "util/kitty_utils.h"
+#include "util/npn_canonization.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace eda::gate::library {
+
+static const std::string libFile =
+    (eda::env::getHomePath() /
+     "test/data/gate/techmapper/sky130_fd_sc_hd__ff_100C_1v65.lib").string();
+
+static std::unique_ptr<SCLibrary> makeLibrary(
+    const SuperGateGenerator::Settings &settings) {
+  auto library = SCLibraryFactory::newLibraryUPtr();
+  ReadCellsParser parser(libFile);
+  EXPECT_TRUE(SCLibraryFactory::fillLibrary(*library, parser));
+  library->setSuperGateSettings(settings);
+  library->prepareLib();
+  return library;
+}
+
+static std::vector<const StandardCell*> getSuperGates(
+    const SCLibrary &library) {
+  std::vector<const StandardCell*> result;
+  for (const auto &cell : library.getCombCells()) {
+    // Supergates are named as the gate trees: root(*,gate(*,*)).
+    if (cell.name.find('(') != std::string::npos) {
+      result.push_back(&cell);
+    }
+  }
+  return result;
+}
+
+TEST(SuperGateGeneratorTest, Generate) {
+  SuperGateGenerator::Settings settings;
+  settings.maxInputs = 3;
+  settings.maxDepth = 2;
+  const auto library = makeLibrary(settings);
+
+  const auto superGates = getSuperGates(*library);
+  ASSERT_FALSE(superGates.empty());
+  EXPECT_LE(superGates.size(), settings.maxNum);
+
+  for (const auto *cell : superGates) {
+    const auto &type = model::CellType::get(cell->cellTypeID);
+    ASSERT_TRUE(type.isSubnet());
+    EXPECT_TRUE(type.getSubnet().isTechMapped());
+    EXPECT_LE(type.getInNum(), settings.maxInputs);
+    EXPECT_EQ(type.getOutNum(), 1);
+    EXPECT_EQ(cell->inputPins.size(), type.getInNum());
+    EXPECT_EQ(library->getCellPtr(cell->cellTypeID), cell);
+
+    // The canonical function corresponds to the implementation.
+    const auto tt = model::evaluate(type.getSubnet())[0];
+    const auto config = util::pCanonization(tt);
+    ASSERT_EQ(cell->ctt.size(), 1);
+    EXPECT_EQ(cell->ctt[0], util::getTT(config));
+  }
+
+  // The supergates of the same function do not dominate each other.
+  for (const auto *lhs : superGates) {
+    for (const auto *rhs : superGates) {
+      if (lhs == rhs || lhs->ctt != rhs->ctt) {
+        continue;
+      }
+      EXPECT_FALSE(lhs->propertyArea <= rhs->propertyArea &&
+                   lhs->propertyDelay <= rhs->propertyDelay)
+          << lhs->name << " dominates " << rhs->name;
+    }
+  }
+}
+
+/// Returns the maximum delay of the timing arcs.
+static double getDelay(const StandardCell &cell, const double load) {
+  double delay = 0.;
+  for (const auto &arc : cell.outputPins[0].timingArcs) {
+    delay = std::max(delay, arc.getValue(0., load).delay);
+  }
+  return delay;
+}
+
+TEST(SuperGateGeneratorTest, TimingArcs) {
+  SuperGateGenerator::Settings settings;
+  settings.maxInputs = 3;
+  settings.maxDepth = 2;
+  const auto library = makeLibrary(settings);
+
+  const double load = 0.01;
+  size_t nSlower = 0;
+
+  for (const auto *cell : getSuperGates(*library)) {
+    ASSERT_EQ(cell->outputPins.size(), 1);
+    const auto &pin = cell->outputPins[0];
+    EXPECT_EQ(pin.unateness.size(), cell->inputPins.size());
+
+    // Each supergate input has its own timing arcs.
+    std::vector<bool> hasArc(cell->inputPins.size(), false);
+    for (const auto input : pin.timingArcInputs) {
+      ASSERT_GE(input, 0);
+      ASSERT_LT(input, cell->inputPins.size());
+      hasArc[input] = true;
+    }
+    for (size_t i = 0; i < hasArc.size(); ++i) {
+      EXPECT_TRUE(hasArc[i]) << cell->name << ": no arcs for input " << i;
+    }
+
+    // The supergate is not faster than its root gate.
+    const auto rootName = cell->name.substr(0, cell->name.find('('));
+    for (const auto &root : library->getCombCells()) {
+      if (root.name == rootName) {
+        const auto rootDelay = getDelay(root, load);
+        EXPECT_GE(getDelay(*cell, load), rootDelay) << cell->name;
+        nSlower += getDelay(*cell, load) > rootDelay ? 1 : 0;
+        break;
+      }
+    }
+  }
+
+  // The delays of the non-root gates are taken into account.
+  EXPECT_GT(nSlower, 0);
+}
+
+TEST(SuperGateGeneratorTest, Disabled) {
+  SuperGateGenerator::Settings settings;
+  settings.maxDepth = 1;
+  const auto library = makeLibrary(settings);
+  EXPECT_TRUE(getSuperGates(*library).empty());
+}
+
+TEST(SuperGateGeneratorTest, Limit) {
+  SuperGateGenerator::Settings settings;
+  settings.maxNum = 10;
+  const auto library = makeLibrary(settings);
+  EXPECT_LE(getSuperGates(*library).size(), settings.maxNum);
+}
+
+} // namespace eda::gate::library
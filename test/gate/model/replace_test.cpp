@@ -6,8 +6,10 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include "gate/model/subnet_npn_view.h"
 #include "gate/model/subnetview.h"
 #include "gate/optimizer/safe_passer.h"
+#include "util/kitty_utils.h"
 
 #include "gtest/gtest.h"
 
@@ -2094,4 +2096,66 @@ TEST(ReplaceViewTest, OneCell) {
   }
 }
 
+TEST(ReplaceNpnViewTest, UnusedInput) {
+  // Representative: AND(x0, x1); x2 is unused.
+  SubnetBuilder rhsBuilder;
+  const auto rhsInputs = rhsBuilder.addInputs(3);
+  const auto rhsAndLink0 = rhsBuilder.addCell(model::AND, rhsInputs[0],
+                                              rhsInputs[1]);
+  rhsBuilder.addOutput(rhsAndLink0);
+  const auto &rhs = Subnet::get(rhsBuilder.make());
+
+  // ~AND(~x0, ~x1) w/ permuted inputs.
+  const util::NpnTransformation t{0b1011, {2, 0, 1}};
+  const auto transformedID = util::npnTransform(rhs, t, 2);
+  const SubnetNpnView view(rhs, t, 2);
+  EXPECT_EQ(view.getInNum(), 2);
+
+  SubnetBuilder builder1, builder2;
+  const auto inputs = builder1.addInputs(2);
+  const auto orLink0 = builder1.addCell(model::OR, inputs[0], inputs[1]);
+  builder1.addOutput(orLink0);
+  builder2.addInputs(2);
+  builder2.addOutput(builder2.addCell(model::OR, inputs[0], inputs[1]));
+
+  InOutMapping mapping({inputs[0].idx, inputs[1].idx}, {orLink0.idx});
+
+  const auto effect1 = builder1.evaluateReplace(transformedID, mapping);
+  const auto effect2 = builder2.evaluateReplace(view, mapping);
+  EXPECT_TRUE(effectsEqual(effect1, effect2));
+
+  builder1.replace(transformedID, mapping);
+  builder2.replace(view, mapping);
+  subnetsEqual(builder1.make(), builder2.make());
+}
+
+TEST(ReplaceNpnViewTest, InvInputs) {
+  // Representative: XOR(AND(x0, x1), x2).
+  SubnetBuilder rhsBuilder;
+  const auto rhsInputs = rhsBuilder.addInputs(3);
+  const auto rhsAndLink0 = rhsBuilder.addCell(model::AND, rhsInputs[0],
+                                              rhsInputs[1]);
+  const auto rhsXorLink0 = rhsBuilder.addCell(model::XOR, rhsAndLink0,
+                                              rhsInputs[2]);
+  rhsBuilder.addOutput(rhsXorLink0);
+  const auto &rhs = Subnet::get(rhsBuilder.make());
+
+  const util::NpnTransformation t{0b0101, {1, 2, 0}};
+  const auto transformedID = util::npnTransform(rhs, t);
+  const SubnetNpnView view(rhs, t);
+
+  SubnetBuilder builder1, builder2;
+  addCellsToBuilder1(builder1);
+  addCellsToBuilder1(builder2);
+  InOutMapping mapping(EntryIDList{0, 1, 2}, EntryIDList{5});
+
+  const auto effect1 = builder1.evaluateReplace(transformedID, mapping);
+  const auto effect2 = builder2.evaluateReplace(view, mapping);
+  EXPECT_TRUE(effectsEqual(effect1, effect2));
+
+  builder1.replace(transformedID, mapping);
+  builder2.replace(view, mapping);
+  subnetsEqual(builder1.make(), builder2.make());
+}
+
 } // namespace eda::gate::model
@@ -0,0 +1,99 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/model/utils/subnet_cnf_encoder.h"
+#include "gate/model/utils/subnet_random.h"
+#include "gate/simulator/simulator.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace eda::gate::model {
+
+// Compares the encoded outputs w/ the simulated ones on all input values.
+static SubnetEncoder::Stats checkEncoding(const SubnetID subnetID,
+                                          const std::vector<size_t> &outputs) {
+  const auto &subnet = Subnet::get(subnetID);
+  const auto nIn = subnet.getInNum();
+  const auto out = subnet.size() - subnet.getOutNum();
+
+  solver::Solver solver;
+  SubnetEncoderContext context(subnet, solver);
+  const auto stats = SubnetEncoder::get().encode(
+      subnet, outputs, context, solver);
+
+  simulator::Simulator simulator(std::make_shared<SubnetBuilder>(subnetID));
+
+  for (size_t values = 0; values < (1u << nIn); ++values) {
+    std::vector<bool> inputs(nIn);
+    solver::Clause assumptions;
+    for (size_t i = 0; i < nIn; ++i) {
+      inputs[i] = (values >> i) & 1;
+      // The encoder represents the true value by the negative literal.
+      assumptions.push(context.lit(i, 0, inputs[i]));
+    }
+
+    EXPECT_TRUE(solver.solve(assumptions));
+    simulator.simulate(inputs);
+
+    for (const auto i : outputs) {
+      const bool value = !solver.value(context.var(out + i, 0));
+      EXPECT_EQ(value, simulator.getOutput(i) & 1);
+    }
+  }
+
+  return stats;
+}
+
+TEST(SubnetEncoderTest, NaryGates) {
+  for (const auto symbol : {AND, OR, XOR}) {
+    for (size_t k = 2; k <= 7; ++k) {
+      SubnetBuilder builder;
+      auto inputs = builder.addInputs(k);
+      inputs[0] = ~inputs[0];
+      builder.addOutput(builder.addCell(symbol, inputs));
+      checkEncoding(builder.make(), {0});
+    }
+  }
+}
+
+TEST(SubnetEncoderTest, Maj) {
+  SubnetBuilder builder;
+  const auto inputs = builder.addInputs(3);
+  builder.addOutput(builder.addCell(MAJ, inputs[0], ~inputs[1], inputs[2]));
+
+  const auto stats = checkEncoding(builder.make(), {0});
+  // The MAJ cell is encoded w/o auxiliary variables.
+  EXPECT_EQ(stats.nVars, 5);
+}
+
+TEST(SubnetEncoderTest, RandomSubnets) {
+  for (size_t seed = 0; seed < 10; ++seed) {
+    const auto subnetID = randomSubnet(6, 4, 60, 2, 3, seed);
+    checkEncoding(subnetID, {0, 1, 2, 3});
+  }
+}
+
+TEST(SubnetEncoderTest, Cone) {
+  SubnetBuilder builder;
+  const auto inputs = builder.addInputs(4);
+  builder.addOutput(builder.addCell(AND, inputs[0], inputs[1]));
+  builder.addOutput(builder.addCell(XOR, inputs[2], inputs[3]));
+  const auto subnetID = builder.make();
+
+  const auto stats0 = checkEncoding(subnetID, {0});
+  const auto stats1 = checkEncoding(subnetID, {1});
+  const auto stats = checkEncoding(subnetID, {0, 1});
+
+  // The inputs are always encoded.
+  EXPECT_EQ(stats0.nVars + stats1.nVars, stats.nVars + 4);
+  EXPECT_EQ(stats0.nClauses + stats1.nClauses, stats.nClauses);
+}
+
+} // namespace eda::gate::model
@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/optimizer/npndb_checkpoint.h"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+namespace eda::gate::optimizer {
+
+namespace fs = std::filesystem;
+
+static fs::path getCheckpointDir(const std::string &name) {
+  const auto dir = fs::temp_directory_path() / "utopia_test" / name;
+  fs::remove_all(dir);
+  return dir;
+}
+
+static void touch(const fs::path &path) {
+  std::ofstream out(path);
+  out << '\n';
+}
+
+static const std::vector<uint64_t> classes = {0x0000, 0x0001, 0x0003, 0x0006};
+
+TEST(NpnDbCheckpointTest, Resume) {
+  const auto dir = getCheckpointDir("resume.ckpt");
+  const NpnDbCheckpoint::Settings settings{"xag", 4};
+
+  {
+    NpnDbCheckpoint checkpoints(dir, settings);
+    EXPECT_EQ(checkpoints.getPending(classes),
+              (std::vector<size_t>{0, 1, 2, 3}));
+
+    // Classes #0 and #2 have been generated before the interruption.
+    touch(checkpoints.getPath(0, classes[0]));
+    touch(checkpoints.getPath(2, classes[2]));
+  }
+
+  NpnDbCheckpoint checkpoints(dir, settings);
+  EXPECT_TRUE(checkpoints.has(0, classes[0]));
+  EXPECT_FALSE(checkpoints.has(1, classes[1]));
+  EXPECT_EQ(checkpoints.getPending(classes), (std::vector<size_t>{1, 3}));
+
+  // The checkpoint of another class w/ the same index is not reused.
+  EXPECT_FALSE(checkpoints.has(0, 0x0007));
+
+  fs::remove_all(dir);
+}
+
+TEST(NpnDbCheckpointTest, OtherSettings) {
+  const auto dir = getCheckpointDir("settings.ckpt");
+
+  {
+    NpnDbCheckpoint checkpoints(dir, {"xag", 4});
+    touch(checkpoints.getPath(0, classes[0]));
+  }
+
+  EXPECT_THROW(NpnDbCheckpoint(dir, {"aig", 4}), std::runtime_error);
+  EXPECT_THROW(NpnDbCheckpoint(dir, {"xag", 5}), std::runtime_error);
+  EXPECT_NO_THROW(NpnDbCheckpoint(dir, {"xag", 4}));
+
+  fs::remove_all(dir);
+}
+
+TEST(NpnDbCheckpointTest, NoManifest) {
+  const auto dir = getCheckpointDir("nomanifest.ckpt");
+  fs::create_directories(dir);
+  touch(dir / "0-0000.logdb");
+
+  EXPECT_THROW(NpnDbCheckpoint(dir, {"xag", 4}), std::runtime_error);
+
+  fs::remove_all(dir);
+}
+
+TEST(NpnDbCheckpointTest, DefaultDir) {
+  const NpnDbCheckpoint::Settings xag{"xag", 4};
+  const NpnDbCheckpoint::Settings aig{"aig", 4};
+  const NpnDbCheckpoint::Settings xag5{"xag", 5};
+
+  const auto dir = NpnDbCheckpoint::getDefaultDir("db", xag);
+  EXPECT_NE(dir, NpnDbCheckpoint::getDefaultDir("db", aig));
+  EXPECT_NE(dir, NpnDbCheckpoint::getDefaultDir("db", xag5));
+}
+
+} // namespace eda::gate::optimizer
@@ -11,6 +11,10 @@
 
 #include "gtest/gtest.h"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using namespace eda::gate::model;
 using namespace eda::gate::optimizer;
 using namespace eda::util;
@@ -72,3 +76,105 @@ TEST(NpnDb2, npnDatabaseTest) {
   EXPECT_TRUE(npnDatabaseTest(makeSubnetXorNorAndAndOr()));
   EXPECT_TRUE(npnDatabaseTest(makeSubnetXorOrXor()));
 }
+
+static SubnetID makeAnd4(bool isBalanced) {
+  SubnetBuilder builder;
+  const auto inputs = builder.addInputs(4);
+  Subnet::Link link;
+  if (isBalanced) {
+    link = builder.addCell(AND,
+        builder.addCell(AND, inputs[0], inputs[1]),
+        builder.addCell(AND, inputs[2], inputs[3]));
+  } else {
+    link = builder.addCell(AND, inputs[0], inputs[1]);
+    link = builder.addCell(AND, link, inputs[2]);
+    link = builder.addCell(AND, link, inputs[3]);
+  }
+  builder.addOutput(link);
+  return builder.make();
+}
+
+TEST(NpnDb2, ImplCostTest) {
+  const auto &subnet = Subnet::get(makeAnd4(false));
+  const auto cost = NpnImplCost::make(subnet);
+  EXPECT_EQ(cost.size, 3);
+  EXPECT_EQ(cost.depth, 3);
+  EXPECT_EQ(cost.inDepth, (std::vector<int16_t>{3, 3, 2, 1}));
+
+  const float arrivals[] = {0.f, 0.f, 0.f, 10.f};
+  EXPECT_EQ(cost.getArrival(arrivals), 11.f);
+}
+
+TEST(NpnDb2, BestPickTest) {
+  NpnDatabase npndb;
+  npndb.push(makeAnd4(true));
+  npndb.push(makeAnd4(false));
+
+  const auto tt = evaluate(Subnet::get(makeAnd4(true)))[0];
+
+  // W/o late inputs, the balanced implementation is the best.
+  const std::vector<float> zeros(4, 0.f);
+  auto best = npndb.getBest(tt, zeros);
+  ASSERT_EQ(best.size(), 1);
+  EXPECT_EQ(NpnImplCost::make(Subnet::get(best.get())).depth, 2);
+
+  // The selection coincides w/ the one over the materialized candidates.
+  float minArrival = 100.f;
+  for (size_t i = 0; i < 4; ++i) {
+    std::vector<float> arrivals(4, 0.f);
+    arrivals[i] = 10.f;
+
+    float expected = 100.f;
+    for (auto iter = npndb.get(tt); !iter.isEnd(); iter.next()) {
+      const auto cost = NpnImplCost::make(Subnet::get(iter.get()));
+      expected = std::min(expected, cost.getArrival(arrivals.data()));
+    }
+
+    best = npndb.getBest(tt, arrivals);
+    ASSERT_EQ(best.size(), 1);
+    const auto &subnet = Subnet::get(best.get());
+    const auto cost = NpnImplCost::make(subnet);
+    EXPECT_EQ(cost.getArrival(arrivals.data()), expected);
+    EXPECT_EQ(evaluate(subnet)[0], tt);
+
+    minArrival = std::min(minArrival, expected);
+  }
+
+  // The chain is better when its last input arrives late.
+  EXPECT_EQ(minArrival, 11.f);
+}
+
+TEST(NpnDb2, ParallelBestPickTest) {
+  NpnDatabase npndb;
+  npndb.push(makeAnd4(true));
+  npndb.push(makeAnd4(false));
+
+  const auto tt = evaluate(Subnet::get(makeAnd4(true)))[0];
+
+  std::vector<std::vector<float>> arrivals(4, std::vector<float>(4, 0.f));
+  std::vector<SubnetID> expected(arrivals.size());
+  for (size_t i = 0; i < arrivals.size(); ++i) {
+    arrivals[i][i] = 10.f;
+    expected[i] = npndb.getBest(tt, arrivals[i]).getStored();
+  }
+
+  // The lookups do not modify the database and can run in parallel.
+  std::atomic<size_t> nMismatches{0};
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 4; ++t) {
+    threads.emplace_back([&]() {
+      for (size_t n = 0; n < 100; ++n) {
+        for (size_t i = 0; i < arrivals.size(); ++i) {
+          if (npndb.getBest(tt, arrivals[i]).getStored() != expected[i]) {
+            nMismatches++;
+          }
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(nMismatches, 0);
+}
@@ -8,11 +8,15 @@
 
 #include "gate/model/examples.h"
 #include "gate/optimizer/npndb.h"
+#include "gate/optimizer/npndb_mmap.h"
 #include "gate/optimizer/npnstatdb.h"
 
 #include "gtest/gtest.h"
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <fstream>
 
 using namespace eda::gate::model;
 using namespace eda::gate::optimizer;
@@ -113,3 +117,68 @@ TEST(NpnDatabaseSerialization, SavingNpnStatDBIntoFile) {
 
   deleteFileIfExists("test.rwdb");
 }
+
+TEST(NpnDatabaseSerializationTest, MmapImage) {
+  std::string filename = "test.npndb";
+
+  NpnDatabase npndb;
+
+  SubnetID id1 = makeSubnet3AndOrXor();
+  SubnetID id2 = makeSubnet4AndOr();
+  npndb.push(id1);
+  npndb.push(id2);
+  npndb.push(id2);
+
+  NpnMmapDatabase::write(npndb, filename);
+  ASSERT_TRUE(NpnMmapDatabase::isValid(filename));
+
+  NpnMmapDatabase npndbImage(filename);
+  ASSERT_EQ(npndbImage.getClassNum(), 2);
+  ASSERT_EQ(npndbImage.getMaterializedNum(), 0);
+
+  auto v = getTransformedSubnets(npndbImage, evaluate(Subnet::get(id1)).at(0));
+  ASSERT_TRUE(v.size() == 1);
+  ASSERT_TRUE(areEquivalent(Subnet::get(id1), Subnet::get(v[0])));
+  ASSERT_EQ(npndbImage.getMaterializedNum(), 1);
+
+  v = getTransformedSubnets(npndbImage, evaluate(Subnet::get(id2)).at(0));
+  ASSERT_TRUE(v.size() == 2);
+  ASSERT_TRUE(areEquivalent(Subnet::get(id2), Subnet::get(v[1])));
+  ASSERT_EQ(npndbImage.getMaterializedNum(), 2);
+
+  deleteFileIfExists(filename);
+}
+
+TEST(NpnDatabaseSerializationTest, MmapImageCorrupted) {
+  namespace fs = std::filesystem;
+  std::string filename = "test_corrupted.npndb";
+
+  NpnDatabase npndb;
+  npndb.push(makeSubnet3AndOrXor());
+  npndb.push(makeSubnet4AndOr());
+  NpnMmapDatabase::write(npndb, filename);
+
+  NpnMmapHeader header;
+  {
+    std::ifstream in(filename, std::ios::binary);
+    in.read(reinterpret_cast<char*>(&header), sizeof(header));
+  }
+
+  // The subnet entries are out of the file.
+  {
+    std::fstream file(filename,
+                      std::ios::in | std::ios::out | std::ios::binary);
+    const uint64_t entryBegin = -1ull;
+    file.seekp(header.subnetOffset + offsetof(NpnMmapSubnet, entryBegin));
+    file.write(reinterpret_cast<const char*>(&entryBegin), sizeof(entryBegin));
+  }
+  ASSERT_TRUE(NpnMmapDatabase::isValid(filename));
+  EXPECT_THROW(NpnMmapDatabase{filename}, std::runtime_error);
+
+  // The file is truncated.
+  fs::resize_file(filename, header.entryOffset);
+  EXPECT_FALSE(NpnMmapDatabase::isValid(filename));
+  EXPECT_THROW(NpnMmapDatabase{filename}, std::runtime_error);
+
+  deleteFileIfExists(filename);
+}
@@ -11,6 +11,9 @@
 
 #include "gtest/gtest.h"
 
+#include <optional>
+#include <vector>
+
 namespace eda::gate::optimizer {
 
 using ResynthesizerBase = optimizer::ResynthesizerBase;
@@ -112,6 +115,50 @@ public:
   }
 };
 
+/// Removes the buffers and checks that the arrivals are the leaf depths.
+class DelBufsArrivalsResynthesizer : public DelBufsResynthesizer {
+public:
+  DelBufsArrivalsResynthesizer(const SubnetBuilder &builder):
+      builder(builder) {}
+
+  SubnetObject resynthesizeBest(const SubnetView &window,
+                                const std::vector<float> &arrivals,
+                                uint16_t maxArity) const override {
+    const auto &inputs = window.getInOutMapping().inputs;
+    EXPECT_EQ(arrivals.size(), inputs.size());
+    for (size_t i = 0; i < inputs.size() && i < arrivals.size(); ++i) {
+      EXPECT_EQ(arrivals[i], builder.getDepth(inputs[i].idx));
+    }
+    nCalls++;
+    return resynthesize(window, maxArity);
+  }
+
+  mutable size_t nCalls{0};
+
+private:
+  const SubnetBuilder &builder;
+};
+
+/// Removes the buffers and returns the result as a view.
+class DelBufsViewResynthesizer : public DelBufsResynthesizer {
+public:
+  bool hasViews() const override { return true; }
+
+  std::optional<model::SubnetNpnView> resynthesizeView(
+      const SubnetView &window,
+      const std::vector<float> *arrivals) const override {
+    const auto &subnet = resynthesize(window, -1).object();
+    util::NpnTransformation t{0, {}};
+    for (size_t i = 0; i < subnet.getInNum(); ++i) {
+      t.permutation.push_back(i);
+    }
+    nCalls++;
+    return model::SubnetNpnView(subnet, t);
+  }
+
+  mutable size_t nCalls{0};
+};
+
 bool truthTablesEqual(const SubnetID subnetID, const SubnetID targetSubnetID) {
   TruthTable t1 = model::evaluateSingleOut(Subnet::get(targetSubnetID));
   TruthTable t2 = model::evaluateSingleOut(Subnet::get(subnetID));
@@ -207,6 +254,30 @@ TEST(RewriterTest, ReduceTest3) {
   runTest(resynthesizer, subnetID, builder->make());
 }
 
+TEST(RewriterTest, DelayAwareTest) {
+  const SubnetID subnetID = getBufsSubnet();
+  const auto &subnet = Subnet::get(subnetID);
+
+  auto builder = std::make_shared<SubnetBuilder>();
+  const auto &inputs = builder->addInputs(subnet.getInNum());
+  const auto &links = builder->addSubnet(subnetID, inputs);
+  builder->addOutputs(links);
+
+  const DelBufsArrivalsResynthesizer resynthesizer(*builder);
+  Rewriter rewriter("rwd", resynthesizer, 5, [](const Effect &effect) -> float {
+    return (float)effect.size; }, false, true);
+
+  rewriter.transform(builder);
+  EXPECT_GT(resynthesizer.nCalls, 0u);
+  EXPECT_TRUE(truthTablesEqual(builder->make(), getNoBufsSubnet()));
+}
+
+TEST(RewriterTest, ViewTest) {
+  const DelBufsViewResynthesizer resynthesizer;
+  runTest(resynthesizer, getBufsSubnet(), getNoBufsSubnet());
+  EXPECT_GT(resynthesizer.nCalls, 0u);
+}
+
 TEST(RewriterTest, EnlargeTest1) {
   const AddBufsResynthesizer resynthesizer;
   const SubnetID subnetID = getNoBufsSubnet();
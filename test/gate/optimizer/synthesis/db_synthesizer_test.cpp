@@ -72,4 +72,21 @@ TEST(DbSynthesizer, ss_pcm) {
   runDbSynthesizer("ss_pcm_orig");
 }
 
+TEST(DbSynthesizer, DelayAware) {
+  const auto subnetID = translator::translateGmlOpenabc("i2c_orig")->make();
+  const auto depth = model::Subnet::get(subnetID).getPathLength().second;
+
+  auto builder = std::make_shared<model::SubnetBuilder>(subnetID);
+  rwdxag4()->transform(builder);
+
+  const auto afterID = builder->make(true);
+  const auto &subnet = model::Subnet::get(afterID);
+  std::cout << "Depth before/after rwdxag4: " << depth << "/"
+            << subnet.getPathLength().second << std::endl;
+
+  debugger::SatChecker &checker = debugger::SatChecker::get();
+  EXPECT_LE(subnet.getPathLength().second, depth);
+  EXPECT_TRUE(checker.areEquivalent(subnetID, afterID).equal());
+}
+
 } // namespace eda::gate::optimizer
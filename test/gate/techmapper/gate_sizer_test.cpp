@@ -0,0 +1,149 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/estimator/timing_analyzer.h"
+#include "gate/library/readcells_srcfile_parser.h"
+#include "gate/techmapper/gate_sizer.h"
+
+#include "gate/techmapper/techmapper_test_util.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace eda::gate::techmapper {
+
+class GateSizerTest : public LibraryInitializer<sky130lib> {
+protected:
+  void SetUp() override {
+    getLibrary().prepareLib();
+  }
+
+  static library::SCLibrary &getLibrary() {
+    return *context.techMapContext.library;
+  }
+
+  static model::CellTypeID getCellTypeID(const std::string &name) {
+    for (const auto &cell : getLibrary().getCombCells()) {
+      if (cell.name == "sky130_fd_sc_hd__" + name) {
+        return cell.cellTypeID;
+      }
+    }
+    throw std::runtime_error("Cell not found: " + name);
+  }
+
+  /// Builds an inverter driving the given number of NAND gates.
+  static model::EntryID makeHighFanout(SubnetBuilder &builder,
+                                       const size_t nFanouts) {
+    // The NAND gates have distinct inputs not to be strashed.
+    const auto inputs = builder.addInputs(nFanouts + 1);
+    const auto inv = builder.addCell(getCellTypeID("inv_1"), {inputs[0]});
+    for (size_t i = 0; i < nFanouts; ++i) {
+      const auto nand =
+          builder.addCell(getCellTypeID("nand2_1"), {inv, inputs[i + 1]});
+      builder.addOutput(nand);
+    }
+    return inv.idx;
+  }
+
+  static size_t getFanoutNum(SubnetBuilder &builder, model::EntryID entryID) {
+    builder.enableFanouts();
+    return builder.getFanouts(entryID).size();
+  }
+
+  static size_t getCellNum(const SubnetBuilder &builder,
+                           const std::vector<model::CellTypeID> &typeIDs) {
+    size_t n = 0;
+    for (auto it = builder.begin(); it != builder.end(); it.nextCell()) {
+      const auto typeID = builder.getCell(*it).getTypeID();
+      n += std::count(typeIDs.begin(), typeIDs.end(), typeID);
+    }
+    return n;
+  }
+};
+
+TEST_F(GateSizerTest, Variants) {
+  const GateSizer sizer(getLibrary());
+
+  const auto inv1 = getCellTypeID("inv_1");
+  const auto &variants = sizer.getVariants(inv1);
+  EXPECT_GT(variants.size(), 1u);
+  EXPECT_NE(std::find(variants.begin(), variants.end(), inv1), variants.end());
+  EXPECT_NE(std::find(variants.begin(), variants.end(), getCellTypeID("inv_4")),
+            variants.end());
+
+  for (size_t i = 1; i < variants.size(); ++i) {
+    const auto &lhs = model::CellType::get(variants[i - 1]);
+    const auto &rhs = model::CellType::get(variants[i]);
+    EXPECT_LE(lhs.getAttr().getPhysProps().area,
+              rhs.getAttr().getPhysProps().area);
+  }
+}
+
+TEST_F(GateSizerTest, HighFanout) {
+  SubnetBuilder builder;
+  const auto inv = makeHighFanout(builder, 32);
+  const auto nOut = builder.getOutNum();
+
+  GateSizer::Settings settings;
+  settings.maxDelay = 0.;
+  ASSERT_GT(getFanoutNum(builder, inv), settings.maxFanout);
+
+  const GateSizer sizer(getLibrary(), settings);
+  const auto result = sizer.size(builder);
+
+  EXPECT_LT(result.newDelay, result.oldDelay);
+  EXPECT_GT(result.nResized + result.nBuffers, 0u);
+  EXPECT_GT(result.newArea, result.oldArea);
+  EXPECT_EQ(builder.getOutNum(), nOut);
+
+  const estimator::TimingAnalyzer analyzer(builder, getLibrary());
+  EXPECT_NEAR(analyzer.getDelay(), result.newDelay, 1e-9);
+}
+
+TEST_F(GateSizerTest, BufferTwice) {
+  SubnetBuilder builder;
+  const auto inv = makeHighFanout(builder, 32);
+
+  // The net is buffered several times (by the same buffer type).
+  GateSizer::Settings settings;
+  settings.maxDelay = 0.;
+  settings.maxFanout = 4;
+  ASSERT_GT(getFanoutNum(builder, inv), 2 * settings.maxFanout);
+
+  const GateSizer sizer(getLibrary(), settings);
+  const auto result = sizer.size(builder);
+  const auto &nands = sizer.getVariants(getCellTypeID("nand2_1"));
+
+  EXPECT_GT(result.nBuffers, 0u);
+  EXPECT_LT(result.newDelay, result.oldDelay);
+  EXPECT_EQ(builder.getOutNum(), 32u);
+  EXPECT_EQ(getCellNum(builder, nands), 32u);
+
+  const estimator::TimingAnalyzer analyzer(builder, getLibrary());
+  EXPECT_NEAR(analyzer.getDelay(), result.newDelay, 1e-9);
+}
+
+TEST_F(GateSizerTest, MetConstraint) {
+  SubnetBuilder builder;
+  makeHighFanout(builder, 4);
+
+  GateSizer::Settings settings;
+  settings.maxDelay = 1000.;
+  const GateSizer sizer(getLibrary(), settings);
+  const auto result = sizer.size(builder);
+
+  EXPECT_EQ(result.nResized, 0u);
+  EXPECT_EQ(result.nBuffers, 0u);
+  EXPECT_EQ(result.newDelay, result.oldDelay);
+  EXPECT_EQ(result.newArea, result.oldArea);
+}
+
+} // namespace eda::gate::techmapper
@@ -52,14 +52,38 @@ TEST_F(MatcherTest, RandomTruthTable) {
     kitty::create_random(tt);
     auto config = kitty::exact_p_canonization(tt);
     const auto &ctt = util::getTT(config); // canonized TT
-    std::vector<std::pair<library::StandardCell, uint16_t>> scs;
-    pBoolMatcher_->match(scs, ctt);
-    if(scs.empty()) {
+    const auto *scs = pBoolMatcher_->find(ctt);
+    if(!scs) {
       std::cout << "truth table " << kitty::to_hex(tt) <<
                          " (ctt=" << kitty::to_hex(ctt) << ")" <<
                          " is not matched." << std::endl;
     }
-    EXPECT_TRUE(!scs.empty());
+    EXPECT_TRUE(scs && !scs->empty());
+  }
+}
+
+TEST_F(MatcherTest, PackedKey) {
+  // Tables of different arities have different keys.
+  EXPECT_NE(PBoolMatcher::makeKey(1, 0x2), PBoolMatcher::makeKey(2, 0x2));
+  EXPECT_NE(PBoolMatcher::makeKey(4, 0x0), PBoolMatcher::makeKey(5, 0x0));
+
+  const std::vector<model::EntryID> leaves{10, 11, 12};
+  for (uint i = 0; i < 100; i++) {
+    kitty::dynamic_truth_table tt(3);
+    kitty::create_random(tt);
+
+    // Matching via the precomputed canonization gives the same cells.
+    const auto matches = pBoolMatcher_->match(tt, leaves);
+    const auto *scs =
+        pBoolMatcher_->find(util::getTT(kitty::exact_p_canonization(tt)));
+    EXPECT_EQ(matches.size(), scs ? scs->size() : 0);
+
+    for (const auto &match : matches) {
+      EXPECT_EQ(match.links.size(), 3);
+      for (const auto &link : match.links) {
+        EXPECT_TRUE(link.idx >= 10 && link.idx <= 12);
+      }
+    }
   }
 }
 
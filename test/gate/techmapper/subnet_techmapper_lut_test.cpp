@@ -0,0 +1,182 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/model/utils/subnet_random.h"
+#include "gate/model/utils/subnet_truth_table.h"
+#include "gate/techmapper/subnet_techmapper_lut.h"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <memory>
+
+namespace eda::gate::techmapper {
+
+using SubnetBuilder = model::SubnetBuilder;
+using SubnetBuilderPtr = std::shared_ptr<SubnetBuilder>;
+
+static void checkLuts(const model::Subnet &subnet, const uint16_t k) {
+  const auto &entries = subnet.getEntries();
+  for (size_t i = subnet.getInNum(); i < entries.size() - subnet.getOutNum();
+       i += entries[i].cell.more + 1) {
+    const auto &cell = entries[i].cell;
+    const auto function = SubnetTechMapperLut::getLutTruthTable(
+        cell.getTypeID());
+    ASSERT_TRUE(function.has_value()) << cell.getType().getName();
+    EXPECT_LE(cell.arity, k);
+  }
+}
+
+static size_t getDepth(const model::Subnet &subnet) {
+  const auto &entries = subnet.getEntries();
+  std::vector<size_t> depths(entries.size(), 0);
+
+  size_t depth = 0;
+  for (size_t i = 0; i < entries.size(); i += entries[i].cell.more + 1) {
+    const auto &cell = entries[i].cell;
+    for (const auto &link : subnet.getLinks(i)) {
+      depths[i] = std::max(depths[i], depths[link.idx]);
+    }
+    if (!cell.isIn() && !cell.isOut() && cell.arity != 0) {
+      depths[i]++;
+    }
+    depth = std::max(depth, depths[i]);
+  }
+  return depth;
+}
+
+static SubnetTechMapperLut::Result checkLutMapping(
+    const SubnetBuilderPtr &builder,
+    const uint16_t k,
+    const bool recoverArea = true) {
+  SubnetTechMapperLut::Settings settings;
+  settings.k = k;
+  if (!recoverArea) {
+    settings.areaFlowPasses = 0;
+    settings.exactAreaPasses = 0;
+  }
+  SubnetTechMapperLut mapper("LutMapper", settings);
+
+  SubnetTechMapperLut::Result result;
+  const auto mapped = mapper.map(builder, result);
+  EXPECT_NE(mapped, nullptr);
+  if (!mapped) {
+    return result;
+  }
+
+  const auto &oldSubnet = model::Subnet::get(builder->make());
+  const auto &newSubnet = model::Subnet::get(mapped->make());
+  EXPECT_EQ(newSubnet.getInNum(), oldSubnet.getInNum());
+  EXPECT_EQ(newSubnet.getOutNum(), oldSubnet.getOutNum());
+  EXPECT_EQ(model::evaluate(newSubnet), model::evaluate(oldSubnet));
+  EXPECT_EQ(result.depth, getDepth(newSubnet));
+  checkLuts(newSubnet, k);
+  return result;
+}
+
+TEST(SubnetTechMapperLutTest, AndTree) {
+  auto builder = std::make_shared<SubnetBuilder>();
+  const auto inputs = builder->addInputs(6);
+  const auto and01 = builder->addCell(model::AND, inputs[0], inputs[1]);
+  const auto and23 = builder->addCell(model::AND, inputs[2], ~inputs[3]);
+  const auto and45 = builder->addCell(model::AND, inputs[4], inputs[5]);
+  const auto and03 = builder->addCell(model::AND, and01, ~and23);
+  builder->addOutput(~builder->addCell(model::AND, and03, and45));
+
+  const auto result6 = checkLutMapping(builder, 6);
+  EXPECT_EQ(result6.nLuts, 1);
+  EXPECT_EQ(result6.depth, 1);
+
+  const auto result4 = checkLutMapping(builder, 4);
+  EXPECT_EQ(result4.nLuts, 2);
+  EXPECT_EQ(result4.depth, 2);
+}
+
+TEST(SubnetTechMapperLutTest, Consts) {
+  auto builder = std::make_shared<SubnetBuilder>();
+  const auto input = builder->addInput();
+  builder->addOutput(builder->addCell(model::ONE));
+  builder->addOutput(builder->addCell(model::ZERO));
+  builder->addOutput(input);
+  builder->addOutput(~input);
+  builder->addOutput(builder->addCell(model::AND, input, ~input));
+
+  // The inverter of the input is the only LUT level.
+  const auto result = checkLutMapping(builder, 6);
+  EXPECT_EQ(result.depth, 1);
+}
+
+TEST(SubnetTechMapperLutTest, BothPhases) {
+  auto builder = std::make_shared<SubnetBuilder>();
+  const auto inputs = builder->addInputs(3);
+  const auto and01 = builder->addCell(model::AND, inputs[0], inputs[1]);
+  const auto and012 = builder->addCell(model::AND, and01, inputs[2]);
+  builder->addOutput(and012);
+  builder->addOutput(~and012);
+
+  // The negated output is driven by a copy of the LUT, not by an inverter.
+  const auto result = checkLutMapping(builder, 3);
+  EXPECT_EQ(result.nLuts, 2);
+  EXPECT_EQ(result.depth, 1);
+}
+
+TEST(SubnetTechMapperLutTest, AreaRecovery) {
+  size_t baseLuts = 0, recoveredLuts = 0;
+
+  for (size_t seed = 0; seed < 10; ++seed) {
+    const auto subnetID = model::randomSubnet(8, 4, 200, 2, 3, seed);
+    const auto builder = std::make_shared<SubnetBuilder>(subnetID);
+
+    for (const uint16_t k : {4, 6}) {
+      const auto base = checkLutMapping(builder, k, false);
+      const auto recovered = checkLutMapping(builder, k, true);
+
+      EXPECT_LE(recovered.nLuts, base.nLuts) << "Seed " << seed << ", k " << k;
+      EXPECT_LE(recovered.depth, base.depth) << "Seed " << seed << ", k " << k;
+
+      baseLuts += base.nLuts;
+      recoveredLuts += recovered.nLuts;
+    }
+  }
+
+  EXPECT_LT(recoveredLuts, baseLuts);
+}
+
+TEST(SubnetTechMapperLutTest, RandomSubnets) {
+  for (size_t seed = 0; seed < 10; ++seed) {
+    const auto subnetID = model::randomSubnet(8, 4, 200, 2, 3, seed);
+    const auto builder = std::make_shared<SubnetBuilder>(subnetID);
+
+    for (const uint16_t k : {3, 4, 6}) {
+      checkLutMapping(builder, k);
+    }
+  }
+}
+
+TEST(SubnetTechMapperLutTest, LargeSubnet) {
+  const auto subnetID = model::randomSubnet(64, 64, 100000, 2, 2, 1);
+  const auto builder = std::make_shared<SubnetBuilder>(subnetID);
+
+  SubnetTechMapperLut mapper("LutMapper");
+  SubnetTechMapperLut::Result result;
+
+  const auto start = std::chrono::steady_clock::now();
+  const auto mapped = mapper.map(builder, result);
+  const auto finish = std::chrono::steady_clock::now();
+
+  ASSERT_NE(mapped, nullptr);
+  EXPECT_GT(result.nLuts, 0);
+  checkLuts(model::Subnet::get(mapped->make()), SubnetTechMapperLut::MaxK);
+
+  // The mapping is linear in the subnet size: 100K cells take well below
+  // a second in the release build (the bound is loose for the debug one).
+  const std::chrono::duration<double> time = finish - start;
+  EXPECT_LT(time.count(), 10.);
+}
+
+} // namespace eda::gate::techmapper
@@ -7,15 +7,19 @@
 //===----------------------------------------------------------------------===//
 
 #include "gate/library/readcells_srcfile_parser.h"
+#include "gate/model/design.h"
+#include "gate/model/examples.h"
 #include "gate/model/utils/subnet_random.h"
 #include "gate/premapper/cell_aigmapper.h"
 #include "gate/techmapper/matcher/pbool_matcher.h"
+#include "gate/techmapper/techmapper_wrapper.h"
 
 #include "gate/techmapper/techmapper_test_util.h"
 
 #include "gtest/gtest.h"
 
 #include <ctime>
+#include <vector>
 
 namespace eda::gate::techmapper {
 
@@ -259,6 +263,62 @@ TEST_F(SubnetTechMapperSky130Test, RandomMIGSubnetConstOne) {
   commonPartCheckEQ(builderPtr, 100000, 100000, 100000);
 }
 
+TEST_F(SubnetTechMapperSky130Test, AreaRecoveryReducesArea) {
+  double baseTotal = 0, recoveredTotal = 0;
+
+  for (size_t seed = 0; seed < 10; ++seed) {
+    const auto subnetID = model::randomSubnet(8, 2, 60, 2, 2, seed);
+    const auto builderPtr = std::make_shared<SubnetBuilder>(subnetID);
+
+    premapper::CellAigMapper aigMapper("aig");
+    const auto premappedBuilder = aigMapper.map(builderPtr);
+    const auto premappedSubnetID = premappedBuilder->make();
+
+    // Both covers are checked to be complete and equivalent to the original.
+    const auto baseID = commonPartCheckEQ(
+        premappedBuilder, 100000, 100000, 100000, premappedSubnetID, false);
+    const auto recoveredID = commonPartCheckEQ(
+        premappedBuilder, 100000, 100000, 100000, premappedSubnetID, true);
+    ASSERT_NE(baseID, model::OBJ_NULL_ID);
+    ASSERT_NE(recoveredID, model::OBJ_NULL_ID);
+
+    const auto baseArea = estimator::getArea(baseID);
+    const auto recoveredArea = estimator::getArea(recoveredID);
+    EXPECT_LE(recoveredArea, baseArea * (1 + 1e-6)) << "Seed " << seed;
+
+    baseTotal += baseArea;
+    recoveredTotal += recoveredArea;
+  }
+
+  EXPECT_LT(recoveredTotal, baseTotal);
+}
+
+TEST_F(SubnetTechMapperSky130Test, AreaRecoveryKeepsDelayConstraint) {
+  const auto &library = *context.techMapContext.library;
+
+  for (size_t seed = 0; seed < 10; ++seed) {
+    const auto subnetID = model::randomSubnet(8, 2, 60, 2, 2, seed);
+    const auto builderPtr = std::make_shared<SubnetBuilder>(subnetID);
+
+    premapper::CellAigMapper aigMapper("aig");
+    const auto premappedBuilder = aigMapper.map(builderPtr);
+    const auto premappedSubnetID = premappedBuilder->make();
+
+    const auto baseID = commonPartCheckEQ(
+        premappedBuilder, 100000, 100000, 100000, premappedSubnetID, false);
+    ASSERT_NE(baseID, model::OBJ_NULL_ID);
+    const auto baseDelay = estimator::getArrivalTime(baseID, library);
+
+    // The delay of the non-recovered cover is used as the constraint.
+    const auto recoveredID = commonPartCheckEQ(
+        premappedBuilder, 100000, baseDelay, 100000, premappedSubnetID, true);
+    ASSERT_NE(recoveredID, model::OBJ_NULL_ID);
+    const auto recoveredDelay = estimator::getArrivalTime(recoveredID, library);
+
+    EXPECT_LE(recoveredDelay, baseDelay * (1 + 1e-6)) << "Seed " << seed;
+  }
+}
+
 TEST_F(SubnetTechMapperSky130Test, GraphMLSubnetSmall) {
   auto builderPtr = parseGraphML("simple_spi_orig"); // 2k nodes
   commonPartCheckEQ(builderPtr, 1000000, 1000000, 1000000);
@@ -269,4 +329,35 @@ TEST_F(SubnetTechMapperSky130Test, DISABLED_GraphMLSubnetLarge) {
   commonPartCheckEQ(builderPtr, 10000000, 10000000, 10000000);
 }
 
+TEST_F(SubnetTechMapperSky130Test, ParallelDesign) {
+  const auto netID = model::makeTriggerNetRandomMatrix(20, 20, 60, 2, 3, 0);
+  model::DesignBuilder design(netID);
+  ASSERT_GT(design.getSubnetNum(), 1u);
+
+  std::vector<SubnetID> subnetIDs(design.getSubnetNum());
+  for (size_t i = 0; i < subnetIDs.size(); ++i) {
+    subnetIDs[i] = design.getSubnetID(i);
+  }
+
+  criterion::Objective objective(criterion::AREA);
+  criterion::Constraints constraints = {
+    criterion::Constraint(criterion::AREA, 100000),
+    criterion::Constraint(criterion::DELAY, 100000),
+    criterion::Constraint(criterion::POWER, 100000)
+  };
+  context.criterion =
+      std::make_unique<criterion::Criterion>(objective, constraints);
+
+  // The subnets are mapped (and logged) by several threads.
+  techMapperWrapper wrapper(context, design, 4);
+  const auto result = wrapper.techMap();
+  ASSERT_TRUE(result.success);
+
+  for (size_t i = 0; i < subnetIDs.size(); ++i) {
+    const auto mappedSubnetID = design.getSubnetID(i);
+    EXPECT_TRUE(checkAllCellsMapped(mappedSubnetID));
+    checkEQ(subnetIDs[i], mappedSubnetID);
+  }
+}
+
 } // namespace eda::gate::techmapper
@@ -98,7 +98,8 @@ protected:
       const std::shared_ptr<SubnetBuilder> builderPtr,
       const float maxArea,
       const float maxDelay,
-      const float maxPower) {
+      const float maxPower,
+      const bool recoverArea = true) {
 
     criterion::Objective objective(criterion::AREA);
     criterion::Constraints constraints = {
@@ -127,6 +128,10 @@ protected:
         matchFinder,
         estimator::getPPA);
 
+    if (!recoverArea) {
+      techmapper.setRecoveryPasses(0, 0);
+    }
+
     auto builder = techmapper.map(builderPtr);
 
     EXPECT_TRUE(builder != nullptr);
@@ -139,10 +144,11 @@ protected:
       const float maxArea,
       const float maxDelay,
       const float maxPower,
-      SubnetID subnetID = model::OBJ_NULL_ID) {
+      SubnetID subnetID = model::OBJ_NULL_ID,
+      const bool recoverArea = true) {
 
     const auto mappedBuilderPtr =
-      commonPart(builderPtr, maxArea, maxDelay, maxPower);
+      commonPart(builderPtr, maxArea, maxDelay, maxPower, recoverArea);
 
     if (mappedBuilderPtr != nullptr) {
       const auto mappedSubnetID = mappedBuilderPtr->make();
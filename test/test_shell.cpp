@@ -129,6 +129,10 @@ TEST(UtopiaShell, LecSat) {
   testLec("sat");
 }
 
+TEST(UtopiaShell, LecSatPerOutput) {
+  testLec("sat --per-output --threads 2");
+}
+
 TEST(UtopiaShell, ReadLibertyNoFile) {
   test("read_liberty", false);
 }
@@ -272,6 +276,10 @@ TEST(UtopiaShell, LogOptRwz) {
   testLogOpt("rwz");
 }
 
+TEST(UtopiaShell, LogOptRwdxag4) {
+  testLogOpt("rwdxag4");
+}
+
 TEST(UtopiaShell, LogOptRf) {
   testLogOpt("rf");
 }
@@ -0,0 +1,72 @@
+//===----------------------------------------------------------------------===//
+//
+// Part of the Utopia EDA Project, under the Apache License v2.0
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2024 ISP RAS (http://www.ispras.ru)
+//
+//===----------------------------------------------------------------------===//
+
+#include "gate/optimizer/npn.h"
+#include "util/npn_canonization.h"
+
+#include "kitty/kitty.hpp"
+#include "gtest/gtest.h"
+
+namespace eda::util {
+
+using TT = kitty::dynamic_truth_table;
+
+static void checkTable(uint8_t nVars, bool withNegations) {
+  for (uint64_t func = 0; func < (1ull << (1u << nVars)); ++func) {
+    TT tt(nVars);
+    *tt.begin() = func;
+
+    const auto expected = withNegations
+        ? kitty::exact_npn_canonization(tt)
+        : kitty::exact_p_canonization(tt);
+    const auto actual = withNegations ? npnCanonization(tt) : pCanonization(tt);
+
+    ASSERT_EQ(std::get<0>(actual), std::get<0>(expected));
+    ASSERT_EQ(kitty::create_from_npn_config(actual), tt);
+  }
+}
+
+TEST(NpnCanonizationTest, NpnTable4) {
+  checkTable(4, true);
+  EXPECT_EQ(CanonizationTable::getNpn(4).getClassNum(),
+            gate::optimizer::npn4Num);
+}
+
+TEST(NpnCanonizationTest, PTable4) {
+  checkTable(4, false);
+  EXPECT_EQ(CanonizationTable::getP(4).getClassNum(), 3984);
+}
+
+TEST(NpnCanonizationTest, SmallTables) {
+  for (uint8_t nVars = 0; nVars < 4; ++nVars) {
+    checkTable(nVars, true);
+    checkTable(nVars, false);
+  }
+}
+
+TEST(NpnCanonizationTest, Cache5) {
+  for (size_t i = 0; i < 100; ++i) {
+    TT tt(5);
+    kitty::create_random(tt, i);
+
+    // The second call is served by the cache.
+    for (size_t j = 0; j < 2; ++j) {
+      const auto npn = npnCanonization(tt);
+      EXPECT_EQ(std::get<0>(npn),
+                std::get<0>(kitty::exact_npn_canonization(tt)));
+      EXPECT_EQ(kitty::create_from_npn_config(npn), tt);
+
+      const auto p = pCanonization(tt);
+      EXPECT_EQ(std::get<0>(p),
+                std::get<0>(kitty::exact_p_canonization(tt)));
+      EXPECT_EQ(kitty::create_from_npn_config(p), tt);
+    }
+  }
+}
+
+} // namespace eda::util